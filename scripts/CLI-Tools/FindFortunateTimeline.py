@@ -5,6 +5,7 @@
 # after a certain number of retries, older save points will be used.
 # ****************************************************************************************
 
+import os
 import subprocess
 import csv
 import shutil
@@ -34,7 +35,8 @@ def run_cli(iteration, savepoint):
         print(f"Execute {input_filename} -> {output_filename}")
         command = [ALIEN_PATH + "cli.exe", "-i",
                    SIM_PATH + input_filename, "-o",
-                   SIM_PATH + output_filename, "-t",
+                   SIM_PATH + output_filename, "--statistics-csv",
+                   SIM_PATH + get_base_filename(iteration, -savepoint + i + 1) + ".statistics.csv", "-t",
                    str(TIMESTEPS_PER_ITERATION)]
         subprocess.run(command)
 
@@ -50,7 +52,9 @@ def read_num_replicators(iteration, offset):
 def copy_sim(input, output):
     shutil.copy(input + '.sim', output + '.sim')
     shutil.copy(input + '.settings.json', output + '.settings.json')
-    shutil.copy(input + '.statistics.csv', output + '.statistics.csv')
+    for extension in ['.statistics.bin', '.statistics.csv']:
+        if os.path.exists(input + extension):
+            shutil.copy(input + extension, output + extension)
 
 
 def main():
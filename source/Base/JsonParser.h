@@ -1,5 +1,8 @@
 #pragma once
 
+#include <charconv>
+#include <string_view>
+
 #include <boost/property_tree/ptree.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -15,8 +18,19 @@ class JsonParser
 {
 public:
     //returns true if defaultValue has been applied
+    //node is a dot-separated path which is resolved segment by segment without going through boost's path and stream translators
+    template <typename T>
+    static bool encodeDecode(boost::property_tree::ptree& tree, T& value, T const& defaultValue, std::string_view node, ParserTask task);
+
+private:
     template <typename T>
-    static bool encodeDecode(boost::property_tree::ptree& tree, T& value, T const& defaultValue, std::string const& node, ParserTask task);
+    static std::string toString(T const& value);
+
+    template <typename T>
+    static bool fromString(T& value, std::string const& stringValue);
+
+    static boost::property_tree::ptree* findNode(boost::property_tree::ptree& tree, std::string_view node, std::string& keyBuffer);
+    static boost::property_tree::ptree& findOrCreateNode(boost::property_tree::ptree& tree, std::string_view node, std::string& keyBuffer);
 };
 
 /**
@@ -37,38 +51,129 @@ bool JsonParser::encodeDecode(
     boost::property_tree::ptree& tree,
     T& value,
     T const& defaultValue,
-    std::string const& node,
+    std::string_view node,
     ParserTask task)
 {
+    std::string keyBuffer;
     if (ParserTask::Encode == task) {
-        std::string stringValue = [&] {
-            if constexpr (std::is_same<T, bool>::value) {
-                return value ? std::string("true") : std::string("false");
-            } else if constexpr (std::is_same<T, std::string>::value) {
-                return value;
-            } else {
-                return to_string_with_precision(value, 8);
-            }
-        }();
-        tree.put(node, stringValue);
+        findOrCreateNode(tree, node, keyBuffer).data() = toString(value);
         return false;
     } else {
-        if constexpr (std::is_same<T, std::string>::value) {
-            value = tree.get<std::string>(node, defaultValue);
-        } else {
-            value = tree.get<T>(node, defaultValue);
+        auto valueNode = findNode(tree, node, keyBuffer);
+        if (!valueNode || !fromString(value, valueNode->data())) {
+            value = defaultValue;
         }
-        size_t lastDotIndex = node.find_last_of('.');
-        if (lastDotIndex == std::string::npos) {
+        if (node.find_last_of('.') == std::string_view::npos) {
             return true;
         }
-        std::string path = node.substr(0, lastDotIndex);
-        std::string property = node.substr(lastDotIndex + 1);
-        auto subtree = tree.get_child_optional(path);
-        if (!subtree) {
+        return valueNode == nullptr;
+    }
+}
+
+//produces the same output as to_string_with_precision(value, 8) which has been used for the JSON files before
+template <typename T>
+std::string JsonParser::toString(T const& value)
+{
+    if constexpr (std::is_same<T, bool>::value) {
+        return value ? std::string("true") : std::string("false");
+    } else if constexpr (std::is_same<T, std::string>::value) {
+        return value;
+    } else if constexpr (std::is_floating_point<T>::value) {
+        char buffer[512];  //fixed notation of the largest double with 8 decimal places fits
+        auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<double>(value), std::chars_format::fixed, 8);
+        return std::string(buffer, end);
+    } else if constexpr (std::is_integral<T>::value) {
+        char buffer[24];
+        auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, end);
+    } else {
+        return to_string_with_precision(value, 8);
+    }
+}
+
+//accepts the same inputs as boost's stream translator (surrounding white spaces, '+' sign, 0/1 for booleans) and fails on trailing characters
+template <typename T>
+bool JsonParser::fromString(T& value, std::string const& stringValue)
+{
+    if constexpr (std::is_same<T, std::string>::value) {
+        value = stringValue;
+        return true;
+    } else {
+        std::string_view trimmed(stringValue);
+        auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v'; };
+        while (!trimmed.empty() && isSpace(trimmed.front())) {
+            trimmed.remove_prefix(1);
+        }
+        while (!trimmed.empty() && isSpace(trimmed.back())) {
+            trimmed.remove_suffix(1);
+        }
+        if constexpr (std::is_same<T, bool>::value) {
+            if (trimmed == "true" || trimmed == "1") {
+                value = true;
+                return true;
+            }
+            if (trimmed == "false" || trimmed == "0") {
+                value = false;
+                return true;
+            }
+            return false;
+        } else if constexpr (std::is_arithmetic<T>::value) {
+            if (trimmed.size() > 1 && trimmed.front() == '+') {
+                trimmed.remove_prefix(1);
+            }
+            T result;
+            auto [end, ec] = std::from_chars(trimmed.data(), trimmed.data() + trimmed.size(), result);
+            if (ec != std::errc() || end != trimmed.data() + trimmed.size()) {
+                return false;
+            }
+            value = result;
             return true;
+        } else {
+            auto result = boost::property_tree::ptree(stringValue).get_value_optional<T>();
+            if (!result) {
+                return false;
+            }
+            value = *result;
+            return true;
+        }
+    }
+}
+
+inline boost::property_tree::ptree* JsonParser::findNode(boost::property_tree::ptree& tree, std::string_view node, std::string& keyBuffer)
+{
+    auto result = &tree;
+    size_t segmentStart = 0;
+    while (true) {
+        auto segmentEnd = node.find('.', segmentStart);
+        keyBuffer.assign(node.substr(segmentStart, segmentEnd - segmentStart));
+        auto findResult = result->find(keyBuffer);
+        if (findResult == result->not_found()) {
+            return nullptr;
         }
+        result = &findResult->second;
+        if (segmentEnd == std::string_view::npos) {
+            return result;
+        }
+        segmentStart = segmentEnd + 1;
+    }
+}
 
-        return subtree->find(property) == subtree->not_found();
+inline boost::property_tree::ptree& JsonParser::findOrCreateNode(boost::property_tree::ptree& tree, std::string_view node, std::string& keyBuffer)
+{
+    auto result = &tree;
+    size_t segmentStart = 0;
+    while (true) {
+        auto segmentEnd = node.find('.', segmentStart);
+        keyBuffer.assign(node.substr(segmentStart, segmentEnd - segmentStart));
+        auto findResult = result->find(keyBuffer);
+        if (findResult == result->not_found()) {
+            result = &result->push_back(std::make_pair(keyBuffer, boost::property_tree::ptree()))->second;
+        } else {
+            result = &findResult->second;
+        }
+        if (segmentEnd == std::string_view::npos) {
+            return *result;
+        }
+        segmentStart = segmentEnd + 1;
     }
 }
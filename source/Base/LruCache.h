@@ -0,0 +1,63 @@
+#pragma once
+
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+/**
+ * Bounded cache which evicts the least recently used entry. In contrast to Cache, a successful find also refreshes the entry.
+ * Lookup, insertion, refresh and eviction are O(1).
+ */
+template <typename Key, typename Value, int MaxEntries>
+class LruCache
+{
+public:
+    void insertOrAssign(Key const& key, Value const& value);
+
+    std::optional<Value> find(Key const& key);
+
+    int getNumEntries() const;
+
+private:
+    //most recently used entry first
+    using Entries = std::list<std::pair<Key, Value>>;
+    Entries _entries;
+    std::unordered_map<Key, typename Entries::iterator> _entryByKey;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+template <typename Key, typename Value, int MaxEntries>
+void LruCache<Key, Value, MaxEntries>::insertOrAssign(Key const& key, Value const& value)
+{
+    auto findResult = _entryByKey.find(key);
+    if (findResult != _entryByKey.end()) {
+        findResult->second->second = value;
+        _entries.splice(_entries.begin(), _entries, findResult->second);
+        return;
+    }
+    if (_entryByKey.size() >= MaxEntries) {
+        _entryByKey.erase(_entries.back().first);
+        _entries.pop_back();
+    }
+    _entries.emplace_front(key, value);
+    _entryByKey.emplace(key, _entries.begin());
+}
+
+template <typename Key, typename Value, int MaxEntries>
+std::optional<Value> LruCache<Key, Value, MaxEntries>::find(Key const& key)
+{
+    auto findResult = _entryByKey.find(key);
+    if (findResult == _entryByKey.end()) {
+        return std::nullopt;
+    }
+    _entries.splice(_entries.begin(), _entries, findResult->second);
+    return findResult->second->second;
+}
+
+template <typename Key, typename Value, int MaxEntries>
+int LruCache<Key, Value, MaxEntries>::getNumEntries() const
+{
+    return static_cast<int>(_entryByKey.size());
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+/**
+ * Lock-free queue for multiple producers and a single consumer.
+ * Producers push onto an atomic list head. The consumer takes the whole list at once and obtains the entries in push order.
+ */
+template <typename T>
+class MpscQueue
+{
+public:
+    MpscQueue() = default;
+    MpscQueue(MpscQueue const&) = delete;
+    MpscQueue& operator=(MpscQueue const&) = delete;
+    ~MpscQueue();
+
+    //can be called from any thread
+    void push(T value);
+
+    //must only be called from the consumer thread
+    std::vector<T> popAll();
+
+    bool isEmpty() const;
+
+private:
+    struct Node
+    {
+        T value;
+        Node* next = nullptr;
+    };
+    std::atomic<Node*> _head{nullptr};
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+template <typename T>
+MpscQueue<T>::~MpscQueue()
+{
+    auto node = _head.exchange(nullptr);
+    while (node) {
+        auto next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+template <typename T>
+void MpscQueue<T>::push(T value)
+{
+    auto node = new Node{std::move(value)};
+    node->next = _head.load(std::memory_order_relaxed);
+    while (!_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+template <typename T>
+std::vector<T> MpscQueue<T>::popAll()
+{
+    auto node = _head.exchange(nullptr, std::memory_order_acquire);
+
+    //the list is in reverse push order
+    std::vector<Node*> nodes;
+    for (; node; node = node->next) {
+        nodes.emplace_back(node);
+    }
+    std::vector<T> result;
+    result.reserve(nodes.size());
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+        result.emplace_back(std::move((*it)->value));
+        delete *it;
+    }
+    return result;
+}
+
+template <typename T>
+bool MpscQueue<T>::isEmpty() const
+{
+    return _head.load(std::memory_order_acquire) == nullptr;
+}
@@ -0,0 +1,103 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace
+{
+    thread_local bool isWorkerThread = false;
+}
+
+ThreadPool& ThreadPool::getInstance()
+{
+    static ThreadPool instance;
+    return instance;
+}
+
+int ThreadPool::getNumThreads() const
+{
+    return static_cast<int>(_threads.size());
+}
+
+void ThreadPool::parallelFor(size_t numJobs, std::function<void(size_t)> const& job)
+{
+    if (numJobs == 0) {
+        return;
+    }
+    if (numJobs == 1 || isWorkerThread) {
+        for (size_t i = 0; i < numJobs; ++i) {
+            job(i);
+        }
+        return;
+    }
+
+    std::mutex finishedMutex;
+    std::condition_variable finished;
+    size_t numFinishedJobs = 0;
+    std::exception_ptr exception;
+    {
+        std::lock_guard lock(_mutex);
+        for (size_t i = 0; i < numJobs; ++i) {
+            _tasks.emplace([&, i] {
+                std::exception_ptr jobException;
+                try {
+                    job(i);
+                } catch (...) {
+                    jobException = std::current_exception();
+                }
+                std::lock_guard finishedLock(finishedMutex);
+                if (jobException && !exception) {
+                    exception = jobException;
+                }
+                if (++numFinishedJobs == numJobs) {
+                    finished.notify_one();
+                }
+            });
+        }
+    }
+    _conditionVariable.notify_all();
+
+    std::unique_lock finishedLock(finishedMutex);
+    finished.wait(finishedLock, [&] { return numFinishedJobs == numJobs; });
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+ThreadPool::ThreadPool()
+{
+    auto numThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(_mutex);
+        _shutdown = true;
+    }
+    _conditionVariable.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    isWorkerThread = true;
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(_mutex);
+            _conditionVariable.wait(lock, [this] { return _shutdown || !_tasks.empty(); });
+            if (_shutdown && _tasks.empty()) {
+                return;
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    static ThreadPool& getInstance();
+
+    int getNumThreads() const;
+
+    //executes job(0), ..., job(numJobs - 1) on the pool and blocks until all jobs are finished
+    //the first exception thrown by a job is rethrown, nested calls from inside a job are executed sequentially
+    void parallelFor(size_t numJobs, std::function<void(size_t)> const& job);
+
+public:
+    ThreadPool(ThreadPool const&) = delete;
+    void operator=(ThreadPool const&) = delete;
+
+private:
+    ThreadPool();
+    ~ThreadPool();
+
+    void workerLoop();
+
+    std::vector<std::thread> _threads;
+    std::queue<std::function<void()>> _tasks;
+    std::mutex _mutex;
+    std::condition_variable _conditionVariable;
+    bool _shutdown = false;
+};
@@ -0,0 +1,33 @@
+#include "BackgroundWriter.h"
+
+#include <iostream>
+
+BackgroundWriter::~BackgroundWriter()
+{
+    if (_pendingWrite.valid()) {
+        _pendingWrite.wait();
+    }
+}
+
+void BackgroundWriter::schedule(std::function<bool()> const& writeFunction, std::string const& filename, int tag)
+{
+    finish();
+    _pendingWrite = std::async(std::launch::async, writeFunction);
+    _pendingWriteInfo = {tag, filename};
+}
+
+void BackgroundWriter::finish()
+{
+    if (!_pendingWrite.valid()) {
+        return;
+    }
+    if (!_pendingWrite.get()) {
+        std::cout << "Could not write to " << _pendingWriteInfo.filename << "." << std::endl;
+        _failures.emplace_back(_pendingWriteInfo);
+    }
+}
+
+std::vector<BackgroundWriter::Failure> const& BackgroundWriter::getFailures() const
+{
+    return _failures;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+//serializes output files on a separate thread such that the simulation does not wait for compression and disk I/O
+class BackgroundWriter
+{
+public:
+    struct Failure
+    {
+        int tag = 0;
+        std::string filename;
+    };
+
+    ~BackgroundWriter();
+
+    //waits for the previous write, i.e. at most two copies of the simulation data are held in memory: the one being written and the new one
+    //which the caller has created before scheduling
+    void schedule(std::function<bool()> const& writeFunction, std::string const& filename, int tag = 0);
+
+    void finish();
+
+    std::vector<Failure> const& getFailures() const;
+
+private:
+    std::future<bool> _pendingWrite;
+    Failure _pendingWriteInfo;
+    std::vector<Failure> _failures;
+};
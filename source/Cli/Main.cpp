@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <filesystem>
 #include <iostream>
 
 #include "CLI/CLI.hpp"
@@ -8,9 +9,18 @@
 #include "Base/Resources.h"
 #include "Base/StringHelper.h"
 #include "Base/FileLogger.h"
+#include "EngineInterface/CheckpointService.h"
+#include "EngineInterface/GenomeAnalyticsService.h"
 #include "EngineInterface/SerializerService.h"
+#include "EngineInterface/SweepService.h"
+#include "EngineImpl/DataTOImage.h"
 #include "EngineImpl/SimulationControllerImpl.h"
 
+#include "BackgroundWriter.h"
+#include "PerformanceReport.h"
+#include "PeriodicOutput.h"
+#include "SweepRunner.h"
+
 int main(int argc, char** argv)
 {
     try {
@@ -21,62 +31,263 @@ int main(int argc, char** argv)
         //parse command line arguments
         std::string inputFilename;
         std::string outputFilename;
+        std::string outputImageFilename;
         std::string statisticsFilename;
         int timesteps = 0;
+        std::string sweepFilename;
+        uint64_t checkpointInterval = 0;
+        std::string checkpointDirectory;
+        int numCheckpointsToKeep = 2;
+        bool resume = false;
+        uint64_t statisticsInterval = 0;
+        std::string streamedStatisticsFilename;
+        std::string performanceReportFilename;
+        uint64_t performanceInterval = 1000;
+        std::string performanceBaselineFilename;
+        double performanceTolerance = 0.1;
+        std::string genomeAnalyticsFilename;
+        std::string compression = "zstd";
+        CompressionSettings compressionSettings;
         app.add_option(
             "-i", inputFilename, "Specifies the name of the input file for the simulation to run. The corresponding *.settings.json should also be available.");
         app.add_option(
             "-o",
             outputFilename,
-            "Specifies the name of the output file for the simulation. The *.settings.json and *.statistics.csv file will also be saved.");
+            "Specifies the name of the output file for the simulation. The *.settings.json and *.statistics.bin file will also be saved.");
+        app.add_option(
+            "--output-image",
+            outputImageFilename,
+            "Specifies the name of an output file in which the simulation data is stored as raw image. Such a file can be used as input file and is "
+            "loaded without conversion but is only readable by the same program version.");
+        app.add_option("--statistics-csv", statisticsFilename, "Specifies the name of a CSV file to which the statistics history is additionally exported.");
         app.add_option("-t", timesteps, "The number of time steps to be calculated.");
+        app.add_option("--compression", compression, "Compression codec for the output file: zstd (default) or deflate.")
+            ->check(CLI::IsMember({"zstd", "deflate"}));
+        app.add_option("--compression-level", compressionSettings.level, "Compression level for the output file (zstd: 1-22, deflate: 1-9).");
+        app.add_option(
+            "--sweep",
+            sweepFilename,
+            "Specifies the name of a JSON file describing a batch of runs (input file, parameter grid and patches, seeds, intervals). "
+            "The other options except the compression settings are ignored in this case.");
+        app.add_option("--checkpoint-every", checkpointInterval, "Writes a checkpoint every N time steps without pausing the simulation.");
+        app.add_option(
+            "--checkpoint-dir",
+            checkpointDirectory,
+            "Specifies the directory for the checkpoints. By default, the name of the output file with the extension .checkpoints is used.");
+        app.add_option("--keep-checkpoints", numCheckpointsToKeep, "The number of most recent checkpoints to be kept (default: 2).");
+        app.add_flag(
+            "--resume",
+            resume,
+            "Continues from the latest valid checkpoint in the checkpoint directory. The input file is used if there is no checkpoint. "
+            "-t refers to the time steps of the whole run including those before the checkpoint.");
+        app.add_option("--stats-every", statisticsInterval, "Appends a row to the statistics stream every N time steps.");
+        app.add_option(
+            "--stats-file",
+            streamedStatisticsFilename,
+            "Specifies the name of the CSV file for the statistics stream. By default, the name of the output file with the extension .stats.csv is used.");
+        app.add_option(
+            "--perf-report",
+            performanceReportFilename,
+            "Specifies the name of a JSON file to which the TPS, the durations of the engine operations, the array resizes, the peak memory usage and the "
+            "object counts are written per interval.");
+        app.add_option("--perf-interval", performanceInterval, "The number of time steps of an interval in the performance report (default: 1000).");
+        app.add_option(
+            "--perf-baseline",
+            performanceBaselineFilename,
+            "Specifies a performance report of a previous run with the same time steps and interval. The program fails if the median TPS of the intervals "
+            "is lower than in the baseline by more than the tolerance.");
+        app.add_option("--perf-tolerance", performanceTolerance, "Allowed relative decrease of the median TPS compared to the baseline (default: 0.1).");
+        app.add_option(
+            "--genome-analytics",
+            genomeAnalyticsFilename,
+            "Analyzes the constructor and injector genomes of the input file without running the simulation and writes the distinct genomes, similarity "
+            "clusters, cell function compositions and sizes per mutation id to the given JSON file. The distinct genomes are additionally exported to a "
+            "CSV file with the same name.");
         CLI11_PARSE(app, argc, argv);
+        compressionSettings.codec = compression == "deflate" ? CompressionCodec_Deflate : CompressionCodec_Zstd;
 
-        //read input
-        std::cout << "Reading input" << std::endl;
-        if (inputFilename.empty()) {
-            std::cout << "No input file given." << std::endl;
+        //batch mode
+        if (!sweepFilename.empty()) {
+            SweepDescription sweepDescription;
+            try {
+                sweepDescription = SweepService::loadSweepDescription(sweepFilename);
+            } catch (std::runtime_error const& e) {
+                std::cout << e.what() << std::endl;
+                return 1;
+            }
+            SweepRunner sweepRunner(sweepDescription, compressionSettings);
+            return sweepRunner.run() ? 0 : 1;
+        }
+
+        //genome analytics mode
+        if (!genomeAnalyticsFilename.empty()) {
+            if (inputFilename.empty()) {
+                std::cout << "No input file given." << std::endl;
+                return 1;
+            }
+            std::cout << "Analyzing genomes" << std::endl;
+            GenomeAnalyticsResult result;
+            try {
+                result = GenomeAnalyticsService::analyzeFile(inputFilename);
+            } catch (std::runtime_error const& e) {
+                std::cout << e.what() << std::endl;
+                return 1;
+            }
+            auto csvFilename = std::filesystem::path(genomeAnalyticsFilename).replace_extension(".csv").string();
+            if (!GenomeAnalyticsService::saveToJson(genomeAnalyticsFilename, result) || !GenomeAnalyticsService::saveGenomesToCsv(csvFilename, result)) {
+                std::cout << "Could not write the genome analytics." << std::endl;
+                return 1;
+            }
+            std::cout << StringHelper::format(result.numOccurrences) << " genomes, " << StringHelper::format(result.genomes.size())
+                      << " distinct genomes, " << StringHelper::format(result.clusters.size()) << " clusters" << std::endl;
+            return 0;
+        }
+
+        //default locations for the periodic output are derived from the output file
+        auto outputBaseFilename = !outputFilename.empty() ? outputFilename : outputImageFilename;
+        if (checkpointDirectory.empty() && !outputBaseFilename.empty()) {
+            checkpointDirectory = std::filesystem::path(outputBaseFilename).replace_extension(".checkpoints").string();
+        }
+        if (streamedStatisticsFilename.empty() && !outputBaseFilename.empty()) {
+            streamedStatisticsFilename = std::filesystem::path(outputBaseFilename).replace_extension(".stats.csv").string();
+        }
+        if ((checkpointInterval > 0 || resume) && checkpointDirectory.empty()) {
+            std::cout << "No checkpoint directory given." << std::endl;
             return 1;
         }
-        DeserializedSimulation simData;
-        if (!SerializerService::deserializeSimulationFromFiles(simData, inputFilename)) {
-            std::cout << "Could not read from input files." << std::endl;
+        if (statisticsInterval > 0 && streamedStatisticsFilename.empty()) {
+            std::cout << "No statistics file given." << std::endl;
             return 1;
         }
 
+        //read input
+        std::cout << "Reading input" << std::endl;
+        DeserializedSimulation simData;
+        std::optional<CheckpointInfo> checkpoint;
+        if (resume) {
+            checkpoint = CheckpointService::loadLatestCheckpoint(simData, checkpointDirectory);
+            if (checkpoint) {
+                std::cout << "Resuming from checkpoint at time step " << StringHelper::format(checkpoint->timestep) << std::endl;
+            } else {
+                std::cout << "No valid checkpoint found, starting from input file" << std::endl;
+            }
+        }
+        if (!checkpoint) {
+            if (inputFilename.empty()) {
+                std::cout << "No input file given." << std::endl;
+                return 1;
+            }
+            if (!SerializerService::deserializeAuxiliaryDataFromFiles(simData, inputFilename)) {
+                std::cout << "Could not read from input files." << std::endl;
+                return 1;
+            }
+        }
+
         //run simulation
         auto startTimepoint = std::chrono::steady_clock::now();
 
         auto simController = std::make_shared<_SimulationControllerImpl>();
         simController->newSimulation(simData.auxiliaryData.timestep, simData.auxiliaryData.generalSettings, simData.auxiliaryData.simulationParameters);
-        simController->setClusteredSimulationData(simData.mainData);
+        if (checkpoint) {
+            simController->setClusteredSimulationData(simData.mainData);
+            simData.mainData = ClusteredDataDescription();
+        } else if (DataTOImageService::isDataTOImage(inputFilename)) {
+            simController->loadSimulationDataImage(inputFilename);
+        } else {
+            //main data is uploaded in batches in order to bound the memory consumption for large simulations
+            auto success = SerializerService::deserializeMainDataFromFile(
+                inputFilename,
+                [&](MainDataSummary const& summary) { simController->reserveSimulationData(summary.numCells, summary.numParticles, summary.auxiliaryDataSize); },
+                [&](ClusteredDataDescription const& batch) { simController->addClusteredSimulationData(batch); });
+            if (!success) {
+                std::cout << "Could not read from input files." << std::endl;
+                return 1;
+            }
+        }
         simController->setStatisticsHistory(simData.statistics);
         simController->setRealTime(simData.auxiliaryData.realTime);
         std::cout << "Device: " << simController->getGpuName() << std::endl;
         std::cout << "Start simulation" << std::endl;
 
-        simController->calcTimesteps(timesteps);
+        //rows of the statistics stream after the checkpoint are calculated again
+        if (statisticsInterval > 0) {
+            if (checkpoint) {
+                PeriodicOutput::truncateStatistics(streamedStatisticsFilename, checkpoint->timestep);
+            } else {
+                std::filesystem::remove(streamedStatisticsFilename);
+            }
+        }
+
+        PeriodicOutputSettings periodicOutputSettings;
+        periodicOutputSettings.checkpointInterval = checkpointInterval > 0 ? std::make_optional(checkpointInterval) : std::nullopt;
+        periodicOutputSettings.checkpointDirectory = checkpointDirectory;
+        periodicOutputSettings.numCheckpointsToKeep = numCheckpointsToKeep;
+        periodicOutputSettings.statisticsInterval = statisticsInterval > 0 ? std::make_optional(statisticsInterval) : std::nullopt;
+        periodicOutputSettings.statisticsFilename = streamedStatisticsFilename;
+        periodicOutputSettings.compressionSettings = compressionSettings;
+
+        auto startTimestep = checkpoint ? checkpoint->startTimestep : simData.auxiliaryData.timestep;
+        std::optional<PerformanceReport> performanceReport;
+        if (!performanceReportFilename.empty() || !performanceBaselineFilename.empty()) {
+            performanceReport.emplace(simController, inputFilename, timesteps, performanceInterval);
+        }
+
+        BackgroundWriter writer;
+        PeriodicOutput periodicOutput(
+            simController, writer, periodicOutputSettings, simData.auxiliaryData, 0, performanceReport ? &*performanceReport : nullptr);
+        auto endTimestep = startTimestep + timesteps;
+        auto currentTimestep = simController->getCurrentTimestep();
+        auto calculatedTimesteps = endTimestep > currentTimestep ? endTimestep - currentTimestep : uint64_t(0);
+        periodicOutput.calcTimesteps(startTimestep, endTimestep);
 
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
-        auto tps = ms != 0 ? 1000.0f * toFloat(timesteps) / toFloat(ms) : 0.0f; 
-        std::cout << "Simulation finished: " << StringHelper::format(timesteps) << " time steps, " << StringHelper::format(ms) << " ms, "
+        auto tps = ms != 0 ? 1000.0f * toFloat(calculatedTimesteps) / toFloat(ms) : 0.0f;
+        std::cout << "Simulation finished: " << StringHelper::format(calculatedTimesteps) << " time steps, " << StringHelper::format(ms) << " ms, "
                   << StringHelper::format(tps, 1) << " TPS" << std::endl;
-        
+        writer.finish();
 
         //write output simulation file
         std::cout << "Writing output" << std::endl;
-        simData.auxiliaryData.timestep = static_cast<uint32_t>(simController->getCurrentTimestep());
-        simData.mainData = simController->getClusteredSimulationData();
+        auto outputStartTimepoint = std::chrono::steady_clock::now();
+        simData.auxiliaryData.timestep = simController->getCurrentTimestep();
         simData.auxiliaryData.simulationParameters = simController->getSimulationParameters();
         simData.statistics = simController->getStatisticsHistory().getCopiedData();
         simData.auxiliaryData.realTime = simController->getRealTime();
-        if (outputFilename.empty()) {
+        if (outputFilename.empty() && outputImageFilename.empty()) {
             std::cout << "No output file given." << std::endl;
             return 1;
         }
-        if (!SerializerService::serializeSimulationToFiles(outputFilename, simData)) {
-            std::cout << "Could not write to output files." << std::endl;
-            return 1;
+        if (!outputImageFilename.empty()) {
+            simController->saveSimulationDataImage(outputImageFilename);
+            if (!SerializerService::serializeAuxiliaryDataToFiles(outputImageFilename, simData)) {
+                std::cout << "Could not write to output files." << std::endl;
+                return 1;
+            }
+        }
+        if (!outputFilename.empty()) {
+            simData.mainData = simController->getClusteredSimulationData();
+            if (!SerializerService::serializeSimulationToFiles(outputFilename, simData, compressionSettings)) {
+                std::cout << "Could not write to output files." << std::endl;
+                return 1;
+            }
+        }
+        if (!statisticsFilename.empty()) {
+            if (!SerializerService::serializeStatisticsToFile(statisticsFilename, simData.statistics)) {
+                std::cout << "Could not write to statistics file." << std::endl;
+                return 1;
+            }
+        }
+
+        if (performanceReport) {
+            performanceReport->addSerializationDuration(
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - outputStartTimepoint));
+            if (!performanceReportFilename.empty() && !performanceReport->writeToFile(performanceReportFilename)) {
+                std::cout << "Could not write to performance report." << std::endl;
+                return 1;
+            }
+            if (!performanceBaselineFilename.empty() && !performanceReport->checkAgainstBaseline(performanceBaselineFilename, performanceTolerance)) {
+                return 2;
+            }
         }
 
         std::cout << "Finished" << std::endl;
@@ -0,0 +1,245 @@
+#include "PerformanceReport.h"
+
+#include <algorithm>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "Base/Resources.h"
+#include "Base/StringHelper.h"
+#include "EngineInterface/SimulationController.h"
+
+namespace
+{
+    auto constexpr FormatVersion = 1;
+
+    uint64_t getPeakMemoryUsage()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return 0;
+        }
+        return counters.PeakWorkingSetSize;
+#else
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+
+    template <typename T>
+    uint64_t sumOverColors(ColorVector<T> const& values)
+    {
+        uint64_t result = 0;
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            result += values[i];
+        }
+        return result;
+    }
+
+    double toMilliseconds(std::chrono::microseconds const& duration)
+    {
+        return static_cast<double>(duration.count()) / 1000.0;
+    }
+
+    double calcTps(uint64_t timesteps, std::chrono::microseconds const& duration)
+    {
+        return duration.count() != 0 ? static_cast<double>(timesteps) * 1000000.0 / static_cast<double>(duration.count()) : 0.0;
+    }
+}
+
+PerformanceReport::PerformanceReport(SimulationController const& simController, std::string const& inputFilename, uint64_t timesteps, uint64_t interval)
+    : _simController(simController)
+    , _inputFilename(inputFilename)
+    , _timesteps(timesteps)
+    , _interval(std::max(uint64_t(1), interval))
+{}
+
+uint64_t PerformanceReport::getInterval() const
+{
+    return _interval;
+}
+
+void PerformanceReport::start()
+{
+    _intervalStartTimepoint = std::chrono::steady_clock::now();
+    _intervalStartTimestep = _simController->getCurrentTimestep();
+    _startCounters = _simController->getPerformanceCounters();
+    _intervalStartCounters = _startCounters;
+    _lastCounters = _startCounters;
+    _intervals.clear();
+}
+
+void PerformanceReport::finishInterval()
+{
+    auto timepoint = std::chrono::steady_clock::now();
+    auto timestep = _simController->getCurrentTimestep();
+    auto counters = _simController->getPerformanceCounters();
+    auto statistics = _simController->getRawStatistics().timeline.timestep;
+
+    PerformanceInterval interval;
+    interval.startTimestep = _intervalStartTimestep;
+    interval.endTimestep = timestep;
+    interval.duration = std::chrono::duration_cast<std::chrono::microseconds>(timepoint - _intervalStartTimepoint);
+    interval.timestepDuration = counters.timestepDuration - _intervalStartCounters.timestepDuration;
+    interval.statisticsDuration = counters.statisticsDuration - _intervalStartCounters.statisticsDuration;
+    interval.dataTransferDuration = counters.dataTransferDuration - _intervalStartCounters.dataTransferDuration;
+    {
+        std::lock_guard lock(_mutexForSerialization);
+        interval.serializationDuration = _pendingSerializationDuration;
+        _pendingSerializationDuration = {};
+    }
+    interval.numResizes = toInt(counters.resizeEvents.size() - _intervalStartCounters.resizeEvents.size());
+    interval.numCells = sumOverColors(statistics.numCells);
+    interval.numParticles = sumOverColors(statistics.numParticles);
+    interval.numConnections = sumOverColors(statistics.numConnections);
+    interval.peakMemoryUsage = getPeakMemoryUsage();
+    _intervals.emplace_back(interval);
+
+    _intervalStartTimepoint = timepoint;
+    _intervalStartTimestep = timestep;
+    _intervalStartCounters = counters;
+    _lastCounters = counters;
+}
+
+void PerformanceReport::addSerializationDuration(std::chrono::microseconds const& duration)
+{
+    std::lock_guard lock(_mutexForSerialization);
+    _pendingSerializationDuration += duration;
+    _totalSerializationDuration += duration;
+}
+
+bool PerformanceReport::writeToFile(std::string const& filename) const
+{
+    boost::property_tree::ptree tree;
+    tree.put("format version", FormatVersion);
+    tree.put("program version", Const::ProgramVersion);
+#if defined(NDEBUG)
+    tree.put("build type", "release");
+#else
+    tree.put("build type", "debug");
+#endif
+    tree.put("device", _simController->getGpuName());
+    tree.put("world size.x", _simController->getWorldSize().x);
+    tree.put("world size.y", _simController->getWorldSize().y);
+    tree.put("input", _inputFilename);
+    tree.put("time steps", _timesteps);
+    tree.put("interval", _interval);
+
+    std::chrono::microseconds duration = {};
+    uint64_t timesteps = 0;
+    double minTps = 0;
+    for (auto const& interval : _intervals) {
+        duration += interval.duration;
+        timesteps += interval.endTimestep - interval.startTimestep;
+        auto tps = calcTps(interval.endTimestep - interval.startTimestep, interval.duration);
+        minTps = &interval == &_intervals.front() ? tps : std::min(minTps, tps);
+    }
+    std::chrono::microseconds serializationDuration;
+    {
+        std::lock_guard lock(_mutexForSerialization);
+        serializationDuration = _totalSerializationDuration;
+    }
+    boost::property_tree::ptree summaryTree;
+    summaryTree.put("time steps", timesteps);
+    summaryTree.put("duration ms", toMilliseconds(duration));
+    summaryTree.put("tps", calcTps(timesteps, duration));
+    summaryTree.put("median interval tps", calcMedianTps());
+    summaryTree.put("min interval tps", minTps);
+    summaryTree.put("time step ms", toMilliseconds(_lastCounters.timestepDuration - _startCounters.timestepDuration));
+    summaryTree.put("statistics ms", toMilliseconds(_lastCounters.statisticsDuration - _startCounters.statisticsDuration));
+    summaryTree.put("data transfer ms", toMilliseconds(_lastCounters.dataTransferDuration - _startCounters.dataTransferDuration));
+    summaryTree.put("serialization ms", toMilliseconds(serializationDuration));
+    summaryTree.put("resizes", _lastCounters.resizeEvents.size() - _startCounters.resizeEvents.size());
+    summaryTree.put("peak memory usage MB", getPeakMemoryUsage() / (1024 * 1024));
+    tree.add_child("summary", summaryTree);
+
+    boost::property_tree::ptree intervalsTree;
+    for (auto const& interval : _intervals) {
+        boost::property_tree::ptree intervalTree;
+        intervalTree.put("start time step", interval.startTimestep);
+        intervalTree.put("end time step", interval.endTimestep);
+        intervalTree.put("duration ms", toMilliseconds(interval.duration));
+        intervalTree.put("tps", calcTps(interval.endTimestep - interval.startTimestep, interval.duration));
+        intervalTree.put("time step ms", toMilliseconds(interval.timestepDuration));
+        intervalTree.put("statistics ms", toMilliseconds(interval.statisticsDuration));
+        intervalTree.put("data transfer ms", toMilliseconds(interval.dataTransferDuration));
+        intervalTree.put("serialization ms", toMilliseconds(interval.serializationDuration));
+        intervalTree.put("resizes", interval.numResizes);
+        intervalTree.put("cells", interval.numCells);
+        intervalTree.put("particles", interval.numParticles);
+        intervalTree.put("connections", interval.numConnections);
+        intervalTree.put("peak memory usage MB", interval.peakMemoryUsage / (1024 * 1024));
+        intervalsTree.push_back({"", intervalTree});
+    }
+    tree.add_child("intervals", intervalsTree);
+
+    //resizes during loading are included since they depend on the build as well
+    boost::property_tree::ptree resizesTree;
+    for (auto const& resizeEvent : _lastCounters.resizeEvents) {
+        boost::property_tree::ptree resizeTree;
+        resizeTree.put("time step", resizeEvent.timestep);
+        resizeTree.put("cell array size", resizeEvent.arraySizes.cellArraySize);
+        resizeTree.put("particle array size", resizeEvent.arraySizes.particleArraySize);
+        resizeTree.put("auxiliary data size", resizeEvent.arraySizes.auxiliaryDataSize);
+        resizeTree.put("duration ms", toMilliseconds(resizeEvent.duration));
+        resizesTree.push_back({"", resizeTree});
+    }
+    tree.add_child("resizes", resizesTree);
+
+    try {
+        boost::property_tree::json_parser::write_json(filename, tree);
+    } catch (boost::property_tree::json_parser_error const&) {
+        return false;
+    }
+    return true;
+}
+
+bool PerformanceReport::checkAgainstBaseline(std::string const& baselineFilename, double tolerance) const
+{
+    double baselineTps = 0;
+    try {
+        boost::property_tree::ptree tree;
+        boost::property_tree::json_parser::read_json(baselineFilename, tree);
+        if (tree.get<uint64_t>("time steps") != _timesteps || tree.get<uint64_t>("interval") != _interval) {
+            std::cout << "The baseline " << baselineFilename << " has been recorded with different time steps or interval." << std::endl;
+            return false;
+        }
+        baselineTps = tree.get<double>("summary.median interval tps");
+    } catch (boost::property_tree::ptree_error const&) {
+        std::cout << "Could not read baseline " << baselineFilename << "." << std::endl;
+        return false;
+    }
+
+    auto tps = calcMedianTps();
+    std::cout << "Median TPS: " << StringHelper::format(toFloat(tps), 1) << " (baseline: " << StringHelper::format(toFloat(baselineTps), 1) << ")"
+              << std::endl;
+    if (tps < baselineTps * (1.0 - tolerance)) {
+        std::cout << "Performance regression detected." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+double PerformanceReport::calcMedianTps() const
+{
+    if (_intervals.empty()) {
+        return 0;
+    }
+    std::vector<double> tpsValues;
+    for (auto const& interval : _intervals) {
+        tpsValues.emplace_back(calcTps(interval.endTimestep - interval.startTimestep, interval.duration));
+    }
+    auto middle = tpsValues.begin() + tpsValues.size() / 2;
+    std::nth_element(tpsValues.begin(), middle, tpsValues.end());
+    return *middle;
+}
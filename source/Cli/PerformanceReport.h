@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/PerformanceCounters.h"
+
+struct PerformanceInterval
+{
+    uint64_t startTimestep = 0;
+    uint64_t endTimestep = 0;
+    std::chrono::microseconds duration = {};
+    std::chrono::microseconds timestepDuration = {};
+    std::chrono::microseconds statisticsDuration = {};
+    std::chrono::microseconds dataTransferDuration = {};
+    std::chrono::microseconds serializationDuration = {};
+    int numResizes = 0;
+    uint64_t numCells = 0;
+    uint64_t numParticles = 0;
+    uint64_t numConnections = 0;
+    uint64_t peakMemoryUsage = 0;  //resident set size of the process in bytes
+};
+
+/**
+ * Records the performance of a run in intervals of time steps and writes it as JSON file.
+ * The report contains the input, time steps and interval length such that reports of different builds can be compared by checking against a baseline.
+ */
+class PerformanceReport
+{
+public:
+    PerformanceReport(SimulationController const& simController, std::string const& inputFilename, uint64_t timesteps, uint64_t interval);
+
+    uint64_t getInterval() const;
+
+    void start();
+
+    //ends the current interval at the current time step and begins the next one
+    void finishInterval();
+
+    //can be called from the background writer
+    void addSerializationDuration(std::chrono::microseconds const& duration);
+
+    bool writeToFile(std::string const& filename) const;
+
+    //a regression is reported if the median TPS of the intervals falls below the baseline by more than the given fraction
+    bool checkAgainstBaseline(std::string const& baselineFilename, double tolerance) const;
+
+private:
+    double calcMedianTps() const;
+
+    SimulationController _simController;
+    std::string _inputFilename;
+    uint64_t _timesteps = 0;
+    uint64_t _interval = 0;
+
+    PerformanceCounters _startCounters;
+    PerformanceCounters _lastCounters;
+
+    std::chrono::steady_clock::time_point _intervalStartTimepoint;
+    uint64_t _intervalStartTimestep = 0;
+    PerformanceCounters _intervalStartCounters;
+    std::vector<PerformanceInterval> _intervals;
+
+    mutable std::mutex _mutexForSerialization;
+    std::chrono::microseconds _pendingSerializationDuration = {};
+    std::chrono::microseconds _totalSerializationDuration = {};
+};
@@ -0,0 +1,147 @@
+#include "PeriodicOutput.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#include "EngineInterface/CheckpointService.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineInterface/StatisticsConverterService.h"
+
+PeriodicOutput::PeriodicOutput(
+    SimulationController const& simController,
+    BackgroundWriter& writer,
+    PeriodicOutputSettings const& settings,
+    AuxiliaryData const& auxiliaryData,
+    int writerTag,
+    PerformanceReport* performanceReport)
+    : _simController(simController)
+    , _writer(writer)
+    , _settings(settings)
+    , _auxiliaryData(auxiliaryData)
+    , _writerTag(writerTag)
+    , _performanceReport(performanceReport)
+{}
+
+void PeriodicOutput::calcTimesteps(uint64_t startTimestep, uint64_t endTimestep)
+{
+    std::optional<uint64_t> performanceInterval;
+    if (_performanceReport) {
+        performanceInterval = _performanceReport->getInterval();
+        _performanceReport->start();
+    }
+    auto timestep = _simController->getCurrentTimestep();
+    while (timestep < endTimestep) {
+        auto nextTimestep = endTimestep;
+        for (auto const& interval : {_settings.checkpointInterval, _settings.statisticsInterval, performanceInterval}) {
+            if (interval) {
+                nextTimestep = std::min(nextTimestep, startTimestep + ((timestep - startTimestep) / *interval + 1) * *interval);
+            }
+        }
+        _simController->calcTimesteps(nextTimestep - timestep);
+        timestep = nextTimestep;
+
+        //finished before the output such that the intervals only contain the time steps and the copying of the data
+        if (_performanceReport && (isIntervalReached(performanceInterval, startTimestep, timestep) || timestep == endTimestep)) {
+            _performanceReport->finishInterval();
+        }
+
+        if (isIntervalReached(_settings.statisticsInterval, startTimestep, timestep)) {
+            appendStatistics(timestep);
+        }
+
+        //the final state is written as output and not as checkpoint
+        if (isIntervalReached(_settings.checkpointInterval, startTimestep, timestep) && timestep != endTimestep) {
+            scheduleCheckpoint(startTimestep);
+        }
+    }
+}
+
+DeserializedSimulation PeriodicOutput::createSimulationCopy(SimulationController const& simController, AuxiliaryData const& auxiliaryData)
+{
+    DeserializedSimulation result;
+    result.auxiliaryData = auxiliaryData;
+    result.auxiliaryData.timestep = simController->getCurrentTimestep();
+    result.auxiliaryData.generalSettings = simController->getGeneralSettings();
+    result.auxiliaryData.simulationParameters = simController->getSimulationParameters();
+    result.auxiliaryData.realTime = simController->getRealTime();
+    result.statistics = simController->getStatisticsHistory().getCopiedData();
+    result.mainData = simController->getClusteredSimulationData();
+    return result;
+}
+
+bool PeriodicOutput::truncateStatistics(std::string const& filename, uint64_t timestep)
+{
+    if (!std::filesystem::exists(filename)) {
+        return true;
+    }
+    auto tempFilename = filename + ".tmp";
+    {
+        std::ifstream inStream(filename);
+        std::ofstream outStream(tempFilename, std::ios::binary);
+        if (!inStream || !outStream) {
+            return false;
+        }
+        std::string line;
+        for (bool isHeader = true; std::getline(inStream, line); isHeader = false) {
+            if (!isHeader) {
+                try {
+                    if (std::stod(line) > static_cast<double>(timestep)) {
+                        break;
+                    }
+                } catch (std::exception const&) {
+                    break;  //incomplete row
+                }
+            }
+            outStream << line << std::endl;
+        }
+        if (!outStream) {
+            return false;
+        }
+    }
+    std::error_code errorCode;
+    std::filesystem::rename(tempFilename, filename, errorCode);
+    return !errorCode;
+}
+
+bool PeriodicOutput::isIntervalReached(std::optional<uint64_t> const& interval, uint64_t startTimestep, uint64_t timestep) const
+{
+    return interval && (timestep - startTimestep) % *interval == 0;
+}
+
+void PeriodicOutput::scheduleCheckpoint(uint64_t startTimestep)
+{
+    auto simulation = std::make_shared<DeserializedSimulation>(createSimulationCopy(_simController, _auxiliaryData));
+    _writer.schedule(
+        [simulation, startTimestep, settings = _settings, performanceReport = _performanceReport] {
+            auto startTimepoint = std::chrono::steady_clock::now();
+            auto success = CheckpointService::writeCheckpoint(settings.checkpointDirectory, *simulation, startTimestep, settings.compressionSettings);
+            if (success) {
+                CheckpointService::removeOldCheckpoints(settings.checkpointDirectory, settings.numCheckpointsToKeep);
+            }
+            if (performanceReport) {
+                performanceReport->addSerializationDuration(
+                    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint));
+            }
+            return success;
+        },
+        _settings.checkpointDirectory,
+        _writerTag);
+}
+
+void PeriodicOutput::appendStatistics(uint64_t timestep)
+{
+    auto rawStatistics = _simController->getRawStatistics().timeline;
+    auto dataPoint = StatisticsConverterService::convert(rawStatistics, timestep, static_cast<double>(timestep), _lastRawStatistics, _lastTimestep);
+    _lastRawStatistics = rawStatistics;
+    _lastTimestep = timestep;
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+    if (!SerializerService::appendStatisticsToFile(_settings.statisticsFilename, {dataPoint})) {
+        std::cout << "Could not write to " << _settings.statisticsFilename << "." << std::endl;
+    }
+    if (_performanceReport) {
+        _performanceReport->addSerializationDuration(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint));
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "EngineInterface/CompressionSettings.h"
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/SerializerService.h"
+
+#include "BackgroundWriter.h"
+#include "PerformanceReport.h"
+
+struct PeriodicOutputSettings
+{
+    std::optional<uint64_t> checkpointInterval;
+    std::string checkpointDirectory;
+    int numCheckpointsToKeep = 2;
+    std::optional<uint64_t> statisticsInterval;
+    std::string statisticsFilename;
+    CompressionSettings compressionSettings;
+};
+
+/**
+ * Calculates the time steps of a run and writes checkpoints and statistics at multiples of the intervals counted from the start time step of the run.
+ * Checkpoints are copied from the simulation between time steps and serialized by the background writer.
+ * Statistics are appended as CSV rows such that the file can be followed during the run.
+ * If a performance report is given, its intervals are finished at multiples of the report interval and at the end of the run.
+ */
+class PeriodicOutput
+{
+public:
+    PeriodicOutput(
+        SimulationController const& simController,
+        BackgroundWriter& writer,
+        PeriodicOutputSettings const& settings,
+        AuxiliaryData const& auxiliaryData,
+        int writerTag = 0,
+        PerformanceReport* performanceReport = nullptr);
+
+    void calcTimesteps(uint64_t startTimestep, uint64_t endTimestep);
+
+    //auxiliary data which is not part of the simulation (e.g. zoom) is taken from the given data
+    static DeserializedSimulation createSimulationCopy(SimulationController const& simController, AuxiliaryData const& auxiliaryData);
+
+    //removes the rows after the given time step, e.g. those written after the checkpoint from which a run is resumed
+    static bool truncateStatistics(std::string const& filename, uint64_t timestep);
+
+private:
+    bool isIntervalReached(std::optional<uint64_t> const& interval, uint64_t startTimestep, uint64_t timestep) const;
+    void scheduleCheckpoint(uint64_t startTimestep);
+    void appendStatistics(uint64_t timestep);
+
+    SimulationController _simController;
+    BackgroundWriter& _writer;
+    PeriodicOutputSettings _settings;
+    AuxiliaryData _auxiliaryData;
+    int _writerTag = 0;
+    PerformanceReport* _performanceReport = nullptr;
+
+    std::optional<TimelineStatistics> _lastRawStatistics;
+    std::optional<uint64_t> _lastTimestep;
+};
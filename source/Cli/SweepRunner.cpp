@@ -0,0 +1,164 @@
+#include "SweepRunner.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include "Base/StringHelper.h"
+#include "EngineInterface/SweepService.h"
+#include "EngineImpl/DataTOImage.h"
+#include "EngineImpl/SimulationControllerImpl.h"
+
+#include "PeriodicOutput.h"
+
+SweepRunner::SweepRunner(SweepDescription const& description, CompressionSettings const& compressionSettings)
+    : _description(description)
+    , _compressionSettings(compressionSettings)
+{}
+
+bool SweepRunner::run()
+{
+    std::cout << "Reading input" << std::endl;
+    if (!readInput()) {
+        std::cout << "Could not read from input files." << std::endl;
+        return false;
+    }
+    auto runs = SweepService::createRuns(_description);
+    std::filesystem::create_directories(_description.outputDirectory);
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+    _simController = std::make_shared<_SimulationControllerImpl>();
+
+    std::vector<boost::property_tree::ptree> runTrees;
+    for (auto const& run : runs) {
+        std::cout << "Run " << run.index + 1 << " of " << runs.size() << " (" << run.name << ", seed " << run.seed << ")" << std::endl;
+        try {
+            runTrees.emplace_back(executeRun(run));
+        } catch (std::exception const& e) {
+            boost::property_tree::ptree runTree;
+            runTree.put("name", run.name);
+            runTree.put("status", std::string("failed: ") + e.what());
+            runTrees.emplace_back(runTree);
+        }
+    }
+    _writer.finish();
+
+    //write errors are only known after the writes which overlap with the subsequent runs
+    for (auto const& failure : _writer.getFailures()) {
+        runTrees.at(failure.tag).put("status", "failed: could not write to " + failure.filename);
+    }
+    boost::property_tree::ptree runsTree;
+    int numFailedRuns = 0;
+    for (auto const& runTree : runTrees) {
+        auto status = runTree.get<std::string>("status");
+        if (status != "ok") {
+            std::cout << runTree.get<std::string>("name") << " " << status << std::endl;
+            ++numFailedRuns;
+        }
+        runsTree.push_back({"", runTree});
+    }
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+    boost::property_tree::ptree manifest;
+    manifest.put("input", _description.inputFilename);
+    manifest.put("time steps", _description.timesteps);
+    manifest.put("device", _gpuName);
+    manifest.put("duration ms", ms);
+    manifest.put("failed runs", numFailedRuns);
+    manifest.add_child("runs", runsTree);
+    auto manifestFilename = (std::filesystem::path(_description.outputDirectory) / "manifest.json").string();
+    boost::property_tree::json_parser::write_json(manifestFilename, manifest);
+
+    std::cout << "Sweep finished: " << runs.size() << " runs, " << numFailedRuns << " failed, " << StringHelper::format(static_cast<uint64_t>(ms))
+              << " ms" << std::endl;
+    return true;
+}
+
+bool SweepRunner::readInput()
+{
+    //the main data is kept in memory in order to avoid deserializing it for each run
+    _isImageInput = DataTOImageService::isDataTOImage(_description.inputFilename);
+    if (_isImageInput) {
+        return SerializerService::deserializeAuxiliaryDataFromFiles(_input, _description.inputFilename);
+    }
+    return SerializerService::deserializeSimulationFromFiles(_input, _description.inputFilename);
+}
+
+boost::property_tree::ptree SweepRunner::executeRun(SweepRun const& run)
+{
+    auto runDirectory = std::filesystem::path(_description.outputDirectory) / run.name;
+    std::filesystem::create_directories(runDirectory);
+
+    boost::property_tree::ptree result;
+    result.put("name", run.name);
+    result.put("variant", run.variant);
+    result.put("seed", run.seed);
+    boost::property_tree::ptree parametersTree;
+    for (auto const& [key, value] : run.assignments) {
+        parametersTree.push_back({key, boost::property_tree::ptree(value)});
+    }
+    result.add_child("parameters", parametersTree);
+
+    auto parameters = SweepService::applyAssignments(_input.auxiliaryData.simulationParameters, run.assignments);
+
+    //the random numbers of the engine are generated with rand() when the simulation is created
+    std::srand(run.seed);
+    _simController->newSimulation(_input.auxiliaryData.timestep, _input.auxiliaryData.generalSettings, parameters);
+    _gpuName = _simController->getGpuName();
+    try {
+        uploadInput();
+        auto startTimepoint = std::chrono::steady_clock::now();
+        auto startTimestep = _simController->getCurrentTimestep();
+        auto endTimestep = startTimestep + _description.timesteps;
+
+        PeriodicOutputSettings outputSettings;
+        outputSettings.checkpointInterval = _description.checkpointInterval;
+        outputSettings.checkpointDirectory = (runDirectory / "checkpoints").string();
+        outputSettings.statisticsInterval = _description.statisticsInterval;
+        outputSettings.statisticsFilename = (runDirectory / "statistics.csv").string();
+        outputSettings.compressionSettings = _compressionSettings;
+        std::filesystem::remove(outputSettings.statisticsFilename);
+        PeriodicOutput periodicOutput(_simController, _writer, outputSettings, _input.auxiliaryData, run.index);
+        periodicOutput.calcTimesteps(startTimestep, endTimestep);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+
+        auto filename = (runDirectory / "result.sim").string();
+        auto simulation = std::make_shared<DeserializedSimulation>(PeriodicOutput::createSimulationCopy(_simController, _input.auxiliaryData));
+        auto compressionSettings = _compressionSettings;
+        _writer.schedule(
+            [=] { return SerializerService::serializeSimulationToFiles(filename, *simulation, compressionSettings); }, filename, run.index);
+
+        auto statistics = _simController->getRawStatistics().timeline.timestep;
+        int numCells = 0;
+        int numParticles = 0;
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            numCells += statistics.numCells[i];
+            numParticles += statistics.numParticles[i];
+        }
+        result.put("status", "ok");
+        result.put("output", filename);
+        result.put("time steps", _description.timesteps);
+        result.put("duration ms", ms);
+        result.put("tps", ms != 0 ? 1000.0f * toFloat(_description.timesteps) / toFloat(ms) : 0.0f);
+        result.put("cells", numCells);
+        result.put("particles", numParticles);
+    } catch (...) {
+        _simController->closeSimulation();
+        throw;
+    }
+    _simController->closeSimulation();
+    return result;
+}
+
+void SweepRunner::uploadInput()
+{
+    if (_isImageInput) {
+        _simController->loadSimulationDataImage(_description.inputFilename);
+    } else {
+        _simController->setClusteredSimulationData(_input.mainData);
+    }
+    _simController->setStatisticsHistory(_input.statistics);
+    _simController->setRealTime(_input.auxiliaryData.realTime);
+}
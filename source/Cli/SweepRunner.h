@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "EngineInterface/CompressionSettings.h"
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/SerializerService.h"
+#include "EngineInterface/SweepDescription.h"
+
+#include "BackgroundWriter.h"
+
+/**
+ * Executes the runs of a sweep one after another with a single simulation controller. The input is read only once.
+ * Each run creates a new simulation, which resets the GPU, hence the transfer buffers are allocated again per run. Checkpoints and results are serialized by a background task while the next time steps are calculated.
+ * Output layout: <output directory>/<run name>/{checkpoints/, statistics.csv, result.sim} and <output directory>/manifest.json
+ */
+class SweepRunner
+{
+public:
+    SweepRunner(SweepDescription const& description, CompressionSettings const& compressionSettings);
+
+    //failed runs are recorded in the manifest, returns false if the sweep could not be executed at all
+    bool run();
+
+private:
+    bool readInput();
+    boost::property_tree::ptree executeRun(SweepRun const& run);
+    void uploadInput();
+
+    SweepDescription _description;
+    CompressionSettings _compressionSettings;
+
+    DeserializedSimulation _input;
+    bool _isImageInput = false;
+    SimulationController _simController;
+    std::string _gpuName;
+
+    BackgroundWriter _writer;
+};
@@ -26,32 +26,52 @@ __global__ void cudaPrepareForUpdate(SimulationData data)
     data.prepareForNextTimestep();
 }
 
-//assumes that *changeDataTO.numCells == 1
+namespace
+{
+    //binary search over transfer objects sorted by id
+    template <typename TO>
+    __inline__ __device__ TO const* findById(TO const* objects, uint64_t numObjects, uint64_t id)
+    {
+        uint64_t begin = 0;
+        uint64_t end = numObjects;
+        while (begin < end) {
+            auto middle = begin + (end - begin) / 2;
+            if (objects[middle].id < id) {
+                begin = middle + 1;
+            } else {
+                end = middle;
+            }
+        }
+        return begin < numObjects && objects[begin].id == id ? &objects[begin] : nullptr;
+    }
+}
+
+//assumes that the cells in changeDataTO have unique ids and are sorted by id
 __global__ void cudaChangeCell(SimulationData data, DataTO changeDataTO)
 {
     auto const partition = calcAllThreadsPartition(data.objects.cellPointers.getNumEntries());
+    auto const numChangedCells = *changeDataTO.numCells;
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto const& cell = data.objects.cellPointers.at(index);
-        auto const& cellTO = changeDataTO.cells[0];
-        if (cell->id == cellTO.id) {
+        if (auto cellTO = findById(changeDataTO.cells, numChangedCells, cell->id)) {
             ObjectFactory entityFactory;
             entityFactory.init(&data);
-            entityFactory.changeCellFromTO(changeDataTO, cellTO, cell, false);
+            entityFactory.changeCellFromTO(changeDataTO, *cellTO, cell, false);
         }
     }
 }
 
-//assumes that *changeDataTO.numParticles == 1
+//assumes that the particles in changeDataTO have unique ids and are sorted by id
 __global__ void cudaChangeParticle(SimulationData data, DataTO changeDataTO)
 {
     auto const partition = calcAllThreadsPartition(data.objects.particlePointers.getNumEntries());
+    auto const numChangedParticles = *changeDataTO.numParticles;
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto const& particle = data.objects.particlePointers.at(index);
-        auto const& particleTO = changeDataTO.particles[0];
-        if (particle->id == particleTO.id) {
+        if (auto particleTO = findById(changeDataTO.particles, numChangedParticles, particle->id)) {
             ObjectFactory entityFactory;
             entityFactory.init(&data);
-            entityFactory.changeParticleFromTO(particleTO, particle);
+            entityFactory.changeParticleFromTO(*particleTO, particle);
         }
     }
 }
@@ -20,8 +20,8 @@
 
 __global__ void cudaColorSelectedCells(SimulationData data, unsigned char color, bool includeClusters);
 __global__ void cudaPrepareForUpdate(SimulationData data);
-__global__ void cudaChangeCell(SimulationData data, DataTO changeDataTO);  //assumes that *changeDataTO.numCells == 1
-__global__ void cudaChangeParticle(SimulationData data, DataTO changeDataTO); //assumes that *changeDataTO.numParticles == 1
+__global__ void cudaChangeCell(SimulationData data, DataTO changeDataTO);  //assumes unique ids in changeDataTO sorted in ascending order
+__global__ void cudaChangeParticle(SimulationData data, DataTO changeDataTO); //assumes unique ids in changeDataTO sorted in ascending order
 __global__ void cudaRemoveSelectedEntities(SimulationData data, bool includeClusters);
 __global__ void cudaRemoveSelectedCellConnections(SimulationData data, bool includeClusters);
 __global__ void cudaRelaxSelectedEntities(SimulationData data, bool includeClusters);
@@ -226,13 +226,13 @@ void _EditKernelsLauncher::changeSimulationData(GpuSettings const& gpuSettings,
     cudaDeviceSynchronize();
     CHECK_FOR_CUDA_ERROR(cudaGetLastError());
 
-    if (copyToHost(changeDataTO.numCells) == 1) {
+    if (copyToHost(changeDataTO.numCells) > 0) {
         KERNEL_CALL(cudaChangeCell, data, changeDataTO);
         cudaDeviceSynchronize();
         CHECK_FOR_CUDA_ERROR(cudaGetLastError());
 
     }
-    if (copyToHost(changeDataTO.numParticles) == 1) {
+    if (copyToHost(changeDataTO.numParticles) > 0) {
         KERNEL_CALL(cudaChangeParticle, data, changeDataTO);
         cudaDeviceSynchronize();
         CHECK_FOR_CUDA_ERROR(cudaGetLastError());
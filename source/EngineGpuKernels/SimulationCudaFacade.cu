@@ -122,8 +122,10 @@ void _SimulationCudaFacade::calcTimestep(uint64_t timesteps, bool forceUpdateSta
         checkAndProcessSimulationParameterChanges();
 
         auto simulationData = getSimulationDataIntern();
+        auto startTimepoint = std::chrono::steady_clock::now();
         _simulationKernels->calcTimestep(_settings, simulationData, *_cudaSimulationStatistics);
         syncAndCheck();
+        addDuration(_performanceCounters.timestepDuration, startTimepoint);
 
         automaticResizeArrays();
 
@@ -198,18 +200,22 @@ void _SimulationCudaFacade::getSimulationData(
     int2 const& rectLowerRight,
     DataTO const& dataTO)
 {
+    auto startTimepoint = std::chrono::steady_clock::now();
     _dataAccessKernels->getData(_settings.gpuSettings, getSimulationDataIntern(), rectUpperLeft, rectLowerRight, *_cudaAccessTO);
     syncAndCheck();
 
     copyDataTOtoHost(dataTO);
+    addDuration(_performanceCounters.dataTransferDuration, startTimepoint);
 }
 
 void _SimulationCudaFacade::getSelectedSimulationData(bool includeClusters, DataTO const& dataTO)
 {
+    auto startTimepoint = std::chrono::steady_clock::now();
     _dataAccessKernels->getSelectedData(_settings.gpuSettings, getSimulationDataIntern(), includeClusters, *_cudaAccessTO);
     syncAndCheck();
 
     copyDataTOtoHost(dataTO);
+    addDuration(_performanceCounters.dataTransferDuration, startTimepoint);
 }
 
 void _SimulationCudaFacade::getInspectedSimulationData(std::vector<uint64_t> entityIds, DataTO const& dataTO)
@@ -224,9 +230,11 @@ void _SimulationCudaFacade::getInspectedSimulationData(std::vector<uint64_t> ent
     if (entityIds.size() < Const::MaxInspectedObjects) {
         ids.values[entityIds.size()] = 0;
     }
+    auto startTimepoint = std::chrono::steady_clock::now();
     _dataAccessKernels->getInspectedData(_settings.gpuSettings, getSimulationDataIntern(), ids, *_cudaAccessTO);
     syncAndCheck();
     copyDataTOtoHost(dataTO);
+    addDuration(_performanceCounters.dataTransferDuration, startTimepoint);
 }
 
 void _SimulationCudaFacade::getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO)
@@ -242,19 +250,33 @@ void _SimulationCudaFacade::getOverlayData(int2 const& rectUpperLeft, int2 const
 
 void _SimulationCudaFacade::addAndSelectSimulationData(DataTO const& dataTO)
 {
+    auto startTimepoint = std::chrono::steady_clock::now();
     copyDataTOtoDevice(dataTO);
     _editKernels->removeSelection(_settings.gpuSettings, getSimulationDataIntern());
     _dataAccessKernels->addData(_settings.gpuSettings, getSimulationDataIntern(), *_cudaAccessTO, true, true);
     syncAndCheck();
+    addDuration(_performanceCounters.dataTransferDuration, startTimepoint);
     updateStatistics();
 }
 
 void _SimulationCudaFacade::setSimulationData(DataTO const& dataTO)
 {
+    auto startTimepoint = std::chrono::steady_clock::now();
     copyDataTOtoDevice(dataTO);
     _dataAccessKernels->clearData(_settings.gpuSettings, getSimulationDataIntern());
     _dataAccessKernels->addData(_settings.gpuSettings, getSimulationDataIntern(), *_cudaAccessTO, false, false);
     syncAndCheck();
+    addDuration(_performanceCounters.dataTransferDuration, startTimepoint);
+    updateStatistics();
+}
+
+void _SimulationCudaFacade::addSimulationData(DataTO const& dataTO)
+{
+    auto startTimepoint = std::chrono::steady_clock::now();
+    copyDataTOtoDevice(dataTO);
+    _dataAccessKernels->addData(_settings.gpuSettings, getSimulationDataIntern(), *_cudaAccessTO, false, false);
+    syncAndCheck();
+    addDuration(_performanceCounters.dataTransferDuration, startTimepoint);
     updateStatistics();
 }
 
@@ -297,9 +319,11 @@ void _SimulationCudaFacade::setBarrier(bool value, bool includeClusters)
 
 void _SimulationCudaFacade::changeInspectedSimulationData(DataTO const& changeDataTO)
 {
+    auto startTimepoint = std::chrono::steady_clock::now();
     copyDataTOtoDevice(changeDataTO);
     _editKernels->changeSimulationData(_settings.gpuSettings, getSimulationDataIntern(), *_cudaAccessTO);
     syncAndCheck();
+    addDuration(_performanceCounters.dataTransferDuration, startTimepoint);
 
     updateStatistics();
 
@@ -419,6 +443,7 @@ RawStatisticsData _SimulationCudaFacade::getRawStatistics()
 
 void _SimulationCudaFacade::updateStatistics()
 {
+    auto startTimepoint = std::chrono::steady_clock::now();
     _statisticsKernels->updateStatistics(_settings.gpuSettings, getSimulationDataIntern(), *_cudaSimulationStatistics);
     syncAndCheck();
 
@@ -427,6 +452,7 @@ void _SimulationCudaFacade::updateStatistics()
         _statisticsData = _cudaSimulationStatistics->getStatistics();
     }
     _statisticsService->addDataPoint(_statisticsHistory, _statisticsData->timeline, getCurrentTimestep());
+    addDuration(_performanceCounters.statisticsDuration, startTimepoint);
 }
 
 StatisticsHistory const& _SimulationCudaFacade::getStatisticsHistory() const
@@ -472,6 +498,12 @@ void _SimulationCudaFacade::resizeArraysIfNecessary(ArraySizes const& additional
     }
 }
 
+PerformanceCounters _SimulationCudaFacade::getPerformanceCounters() const
+{
+    std::lock_guard lock(_mutexForPerformanceCounters);
+    return _performanceCounters;
+}
+
 void _SimulationCudaFacade::testOnly_mutate(uint64_t cellId, MutationType mutationType)
 {
     {
@@ -594,6 +626,7 @@ void _SimulationCudaFacade::automaticResizeArrays()
 void _SimulationCudaFacade::resizeArrays(ArraySizes const& additionals)
 {
     log(Priority::Important, "resize arrays");
+    auto startTimepoint = std::chrono::steady_clock::now();
 
     _cudaSimulationData->resizeTargetObjects(additionals);
     if (!_cudaSimulationData->isEmpty()) {
@@ -627,6 +660,15 @@ void _SimulationCudaFacade::resizeArrays(ArraySizes const& additionals)
 
     auto const memorySizeAfter = CudaMemoryManager::getInstance().getSizeOfAcquiredMemory();
     log(Priority::Important, std::to_string(memorySizeAfter / (1024 * 1024)) + " MB GPU memory used");
+
+    ArrayResizeEvent resizeEvent;
+    resizeEvent.timestep = getCurrentTimestep();
+    resizeEvent.arraySizes = {cellArraySize, particleArraySize, auxiliaryDataSize};
+    resizeEvent.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
+    {
+        std::lock_guard lock(_mutexForPerformanceCounters);
+        _performanceCounters.resizeEvents.emplace_back(resizeEvent);
+    }
 }
 
 void _SimulationCudaFacade::checkAndProcessSimulationParameterChanges()
@@ -643,6 +685,12 @@ void _SimulationCudaFacade::checkAndProcessSimulationParameterChanges()
     }
 }
 
+void _SimulationCudaFacade::addDuration(std::chrono::microseconds& duration, std::chrono::steady_clock::time_point const& startTimepoint)
+{
+    std::lock_guard lock(_mutexForPerformanceCounters);
+    duration += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
+}
+
 SimulationData _SimulationCudaFacade::getSimulationDataIntern() const
 {
     std::lock_guard lock(_mutexForSimulationData);
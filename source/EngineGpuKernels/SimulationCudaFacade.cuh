@@ -17,6 +17,7 @@
 #include "EngineInterface/SelectionShallowData.h"
 #include "EngineInterface/ShallowUpdateSelectionData.h"
 #include "EngineInterface/MutationType.h"
+#include "EngineInterface/PerformanceCounters.h"
 #include "EngineInterface/StatisticsHistory.h"
 
 #include "Definitions.cuh"
@@ -48,6 +49,7 @@ public:
     void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataTO const& dataTO);
     void addAndSelectSimulationData(DataTO const& dataTO);
     void setSimulationData(DataTO const& dataTO);
+    void addSimulationData(DataTO const& dataTO);
     void removeSelectedObjects(bool includeClusters);
     void relaxSelectedObjects(bool includeClusters);
     void uniformVelocitiesForSelectedObjects(bool includeClusters);
@@ -87,6 +89,8 @@ public:
 
     void resizeArraysIfNecessary(ArraySizes const& additionals = ArraySizes());
 
+    PerformanceCounters getPerformanceCounters() const;
+
     //for tests
     void testOnly_mutate(uint64_t cellId, MutationType mutationType);
 
@@ -99,6 +103,7 @@ private:
     void automaticResizeArrays();
     void resizeArrays(ArraySizes const& additionals = ArraySizes());
     void checkAndProcessSimulationParameterChanges();
+    void addDuration(std::chrono::microseconds& duration, std::chrono::steady_clock::time_point const& startTimepoint);
 
     SimulationData getSimulationDataIntern() const;
 
@@ -123,6 +128,9 @@ private:
     StatisticsHistory _statisticsHistory;
     std::shared_ptr<SimulationStatistics> _cudaSimulationStatistics;
 
+    mutable std::mutex _mutexForPerformanceCounters;
+    PerformanceCounters _performanceCounters;
+
     SimulationKernelsLauncher _simulationKernels;
     DataAccessKernelsLauncher _dataAccessKernels;
     GarbageCollectorKernelsLauncher _garbageCollectorKernels;
@@ -1,63 +1,117 @@
 #include "AccessDataTOCache.h"
 
-_AccessDataTOCache::_AccessDataTOCache()
+#include <cuda_runtime.h>
+
+namespace
+{
+    auto constexpr NumCounters = 3;
+}
+
+_AccessDataTOCache::_AccessDataTOCache(TransferMemory transferMemory, int numBuffers)
+    : _transferMemory(transferMemory)
+    , _buffers(std::max(1, numBuffers))
 {}
 
 _AccessDataTOCache::~_AccessDataTOCache()
 {
-    if(_dataTO) {
-        deleteDataTO(*_dataTO);
+    for (auto& buffer : _buffers) {
+        free(buffer.counters);
+        free(buffer.cells);
+        free(buffer.particles);
+        free(buffer.auxiliaryData);
     }
 }
 
-DataTO _AccessDataTOCache::getDataTO(ArraySizes const& arraySizes)
+DataTO _AccessDataTOCache::getDataTO(ArraySizes const& arraySizes, int bufferIndex)
 {
-    if (_dataTO) {
-        auto existingArraySizes = getArraySizes(*_dataTO);
-        if (fits(existingArraySizes, arraySizes)) {
-            *_dataTO->numCells = 0;
-            *_dataTO->numParticles = 0;
-            *_dataTO->numAuxiliaryData = 0;
-            return *_dataTO;
-        } else {
-            deleteDataTO(*_dataTO);
-        }
-    }
+    auto& buffer = _buffers.at(bufferIndex);
     try {
-        DataTO result;
-        result.numCells = new uint64_t;
-        result.numParticles = new uint64_t;
-        result.numAuxiliaryData = new uint64_t;
-        *result.numCells = 0;
-        *result.numParticles = 0;
-        *result.numAuxiliaryData = 0;
-        result.cells = new CellTO[arraySizes.cellArraySize];
-        result.particles = new ParticleTO[arraySizes.particleArraySize];
-        result.auxiliaryData = new uint8_t[arraySizes.auxiliaryDataSize];
-        _dataTO = result;
-        return result;
+        reserve(buffer.counters, NumCounters, sizeof(uint64_t));
+        reserve(buffer.cells, arraySizes.cellArraySize, sizeof(CellTO));
+        reserve(buffer.particles, arraySizes.particleArraySize, sizeof(ParticleTO));
+        reserve(buffer.auxiliaryData, arraySizes.auxiliaryDataSize, sizeof(uint8_t));
     } catch (std::bad_alloc const&) {
         throw std::runtime_error("There is not sufficient CPU memory available.");
     }
+
+    auto result = toDataTO(buffer);
+    *result.numCells = 0;
+    *result.numParticles = 0;
+    *result.numAuxiliaryData = 0;
+    return result;
 }
 
-bool _AccessDataTOCache::fits(ArraySizes const& left, ArraySizes const& right) const
+DataTO _AccessDataTOCache::getFilledDataTO(int bufferIndex) const
 {
-    return left.cellArraySize >= right.cellArraySize && left.particleArraySize >= right.particleArraySize
-        && left.auxiliaryDataSize >= right.auxiliaryDataSize;
+    return toDataTO(_buffers.at(bufferIndex));
 }
 
-auto _AccessDataTOCache::getArraySizes(DataTO const& dataTO) const -> ArraySizes
+int _AccessDataTOCache::getNumBuffers() const
 {
-    return {*dataTO.numCells, *dataTO.numParticles, *dataTO.numAuxiliaryData};
+    return toInt(_buffers.size());
 }
 
-void _AccessDataTOCache::deleteDataTO(DataTO const& dataTO)
+ArraySizes _AccessDataTOCache::getCapacities(int bufferIndex) const
 {
-    delete dataTO.numCells;
-    delete dataTO.numParticles;
-    delete dataTO.numAuxiliaryData;
-    delete[] dataTO.cells;
-    delete[] dataTO.particles;
-    delete[] dataTO.auxiliaryData;
+    auto const& buffer = _buffers.at(bufferIndex);
+    return {buffer.cells.capacity, buffer.particles.capacity, buffer.auxiliaryData.capacity};
+}
+
+bool _AccessDataTOCache::isPinned(int bufferIndex) const
+{
+    auto const& buffer = _buffers.at(bufferIndex);
+    return buffer.counters.pinned && buffer.cells.pinned && buffer.particles.pinned && buffer.auxiliaryData.pinned;
+}
+
+DataTO _AccessDataTOCache::toDataTO(Buffer const& buffer) const
+{
+    auto counters = reinterpret_cast<uint64_t*>(buffer.counters.data);
+    DataTO result;
+    result.numCells = &counters[0];
+    result.numParticles = &counters[1];
+    result.numAuxiliaryData = &counters[2];
+    result.cells = reinterpret_cast<CellTO*>(buffer.cells.data);
+    result.particles = reinterpret_cast<ParticleTO*>(buffer.particles.data);
+    result.auxiliaryData = reinterpret_cast<uint8_t*>(buffer.auxiliaryData.data);
+    return result;
+}
+
+void _AccessDataTOCache::reserve(HostArray& array, uint64_t size, uint64_t elementSize)
+{
+    if (array.data != nullptr && array.capacity >= size) {
+        return;
+    }
+    //at least one element is allocated such that the pointers of an empty DataTO are valid
+    auto newCapacity = std::max({size, array.capacity + array.capacity / 2, uint64_t(1)});
+    free(array);
+    allocate(array, newCapacity * elementSize);
+    array.capacity = newCapacity;
+}
+
+void _AccessDataTOCache::allocate(HostArray& array, uint64_t numBytes)
+{
+    if (_transferMemory == TransferMemory_Pinned) {
+        if (cudaHostAlloc(&array.data, numBytes, cudaHostAllocDefault) == cudaSuccess) {
+            array.pinned = true;
+            return;
+        }
+        cudaGetLastError();  //reset error state of the failed allocation
+    }
+    array.data = ::operator new(numBytes);
+    array.pinned = false;
+}
+
+void _AccessDataTOCache::free(HostArray& array)
+{
+    if (array.data == nullptr) {
+        return;
+    }
+    if (array.pinned) {
+        cudaFreeHost(array.data);
+    } else {
+        ::operator delete(array.data);
+    }
+    array.data = nullptr;
+    array.capacity = 0;
+    array.pinned = false;
 }
@@ -8,19 +8,53 @@
 
 #include "Definitions.h"
 
+using TransferMemory = int;
+enum TransferMemory_
+{
+    TransferMemory_Pageable,  //pure host memory, does not need a GPU
+    TransferMemory_Pinned     //page-locked memory for faster transfers, falls back to pageable memory if it cannot be allocated
+};
+
+/**
+ * Pool of host-side transfer buffers. The arrays of each buffer grow geometrically and are only reallocated if the requested sizes exceed
+ * their capacities. Several buffers allow to fill one buffer on the CPU while another one is being transferred to the GPU.
+ */
 class _AccessDataTOCache
 {
 public:
-    _AccessDataTOCache();
+    _AccessDataTOCache(TransferMemory transferMemory = TransferMemory_Pageable, int numBuffers = 2);
     ~_AccessDataTOCache();
 
-    DataTO getDataTO(ArraySizes const& arraySizes);
+    //the returned DataTO is empty and remains valid until the same buffer is requested again
+    DataTO getDataTO(ArraySizes const& arraySizes, int bufferIndex = 0);
 
-private:
-    bool fits(ArraySizes const& left, ArraySizes const& right) const;
-    ArraySizes getArraySizes(DataTO const& dataTO) const;
-    void deleteDataTO(DataTO const& dataTO);
+    //returns the DataTO of a buffer without resetting its content
+    DataTO getFilledDataTO(int bufferIndex) const;
 
-    std::optional<DataTO> _dataTO;
-};
+    int getNumBuffers() const;
+    ArraySizes getCapacities(int bufferIndex) const;
+    bool isPinned(int bufferIndex) const;
 
+private:
+    struct HostArray
+    {
+        void* data = nullptr;
+        uint64_t capacity = 0;
+        bool pinned = false;
+    };
+    struct Buffer
+    {
+        HostArray counters;
+        HostArray cells;
+        HostArray particles;
+        HostArray auxiliaryData;
+    };
+
+    DataTO toDataTO(Buffer const& buffer) const;
+    void reserve(HostArray& array, uint64_t size, uint64_t elementSize);
+    void allocate(HostArray& array, uint64_t numBytes);
+    void free(HostArray& array);
+
+    TransferMemory _transferMemory;
+    std::vector<Buffer> _buffers;
+};
@@ -0,0 +1,188 @@
+#include "DataTOImage.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Base/Resources.h"
+#include "EngineInterface/GenomeConstants.h"
+
+namespace
+{
+    char const Magic[] = {'A', 'L', 'I', 'E', 'N', 'I', 'M', 'G'};
+    uint32_t constexpr ImageVersion = 1;
+    uint64_t constexpr SectionAlignment = 64;
+
+    struct ImageHeader
+    {
+        char magic[sizeof(Magic)];
+        uint32_t imageVersion;
+        uint32_t cellTOSize;
+        uint32_t particleTOSize;
+        uint32_t padding;
+        char programVersion[32];
+        uint64_t numCells;
+        uint64_t numParticles;
+        uint64_t numAuxiliaryData;
+        uint64_t cellsOffset;
+        uint64_t particlesOffset;
+        uint64_t auxiliaryDataOffset;
+    };
+    static_assert(std::is_trivially_copyable_v<ImageHeader> && std::is_trivially_copyable_v<CellTO> && std::is_trivially_copyable_v<ParticleTO>);
+
+    uint64_t alignOffset(uint64_t offset)
+    {
+        return (offset + SectionAlignment - 1) / SectionAlignment * SectionAlignment;
+    }
+
+    //the header is not trusted, hence the checks are formulated such that they cannot overflow
+    bool isSectionInside(uint64_t offset, uint64_t numElements, uint64_t elementSize, uint64_t size)
+    {
+        return offset <= size && numElements <= (size - offset) / elementSize;
+    }
+
+    //the index of an empty range is not used
+    bool isRangeInside(uint64_t index, uint64_t rangeSize, uint64_t size)
+    {
+        return rangeSize == 0 || (index <= size && rangeSize <= size - index);
+    }
+
+    //the GPU kernels read the genome header without checking the genome size
+    bool isGenomeValid(uint64_t genomeDataIndex, uint64_t genomeSize, uint64_t numAuxiliaryData)
+    {
+        return genomeSize >= Const::GenomeHeaderSize && isRangeInside(genomeDataIndex, genomeSize, numAuxiliaryData);
+    }
+
+    //the GPU kernels access connected cells and auxiliary data without bounds checks
+    void checkReferences(DataTO const& dataTO)
+    {
+        auto numCells = *dataTO.numCells;
+        auto numAuxiliaryData = *dataTO.numAuxiliaryData;
+        for (uint64_t i = 0; i < numCells; ++i) {
+            auto const& cell = dataTO.cells[i];
+            if (cell.numConnections > MAX_CELL_BONDS) {
+                throw std::runtime_error("Image contains invalid connections.");
+            }
+            for (int j = 0; j < cell.numConnections; ++j) {
+                if (cell.connections[j].cellIndex < 0 || static_cast<uint64_t>(cell.connections[j].cellIndex) >= numCells) {
+                    throw std::runtime_error("Image contains invalid connections.");
+                }
+            }
+            auto isAuxiliaryDataValid = isRangeInside(cell.metadata.nameDataIndex, cell.metadata.nameSize, numAuxiliaryData)
+                && isRangeInside(cell.metadata.descriptionDataIndex, cell.metadata.descriptionSize, numAuxiliaryData);
+            if (cell.cellFunction == CellFunction_Neuron) {
+                isAuxiliaryDataValid &= isRangeInside(
+                    cell.cellFunctionData.neuron.weightsAndBiasesDataIndex, sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1), numAuxiliaryData);
+            } else if (cell.cellFunction == CellFunction_Constructor) {
+                isAuxiliaryDataValid &=
+                    isGenomeValid(cell.cellFunctionData.constructor.genomeDataIndex, cell.cellFunctionData.constructor.genomeSize, numAuxiliaryData);
+            } else if (cell.cellFunction == CellFunction_Injector) {
+                isAuxiliaryDataValid &=
+                    isGenomeValid(cell.cellFunctionData.injector.genomeDataIndex, cell.cellFunctionData.injector.genomeSize, numAuxiliaryData);
+            }
+            if (!isAuxiliaryDataValid) {
+                throw std::runtime_error("Image contains invalid references to auxiliary data.");
+            }
+        }
+    }
+
+    void writePadding(std::ofstream& stream, uint64_t targetOffset)
+    {
+        static char const zeros[SectionAlignment] = {};
+        auto pos = static_cast<uint64_t>(stream.tellp());
+        stream.write(zeros, targetOffset - pos);
+    }
+}
+
+bool DataTOImageService::isDataTOImage(std::string const& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    char magic[sizeof(Magic)];
+    return stream.read(magic, sizeof(magic)) && std::memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+void DataTOImageService::writeImage(std::string const& filename, DataTO const& dataTO)
+{
+    ImageHeader header = {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.imageVersion = ImageVersion;
+    header.cellTOSize = sizeof(CellTO);
+    header.particleTOSize = sizeof(ParticleTO);
+    if (Const::ProgramVersion.size() >= sizeof(header.programVersion)) {
+        throw std::runtime_error("Program version too long.");
+    }
+    std::memcpy(header.programVersion, Const::ProgramVersion.data(), Const::ProgramVersion.size());
+    header.numCells = *dataTO.numCells;
+    header.numParticles = *dataTO.numParticles;
+    header.numAuxiliaryData = *dataTO.numAuxiliaryData;
+    header.cellsOffset = alignOffset(sizeof(ImageHeader));
+    header.particlesOffset = alignOffset(header.cellsOffset + header.numCells * sizeof(CellTO));
+    header.auxiliaryDataOffset = alignOffset(header.particlesOffset + header.numParticles * sizeof(ParticleTO));
+
+    std::ofstream stream(filename, std::ios::binary);
+    if (!stream) {
+        throw std::runtime_error("Could not open file.");
+    }
+    stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    writePadding(stream, header.cellsOffset);
+    stream.write(reinterpret_cast<char const*>(dataTO.cells), header.numCells * sizeof(CellTO));
+    writePadding(stream, header.particlesOffset);
+    stream.write(reinterpret_cast<char const*>(dataTO.particles), header.numParticles * sizeof(ParticleTO));
+    writePadding(stream, header.auxiliaryDataOffset);
+    stream.write(reinterpret_cast<char const*>(dataTO.auxiliaryData), header.numAuxiliaryData);
+    if (!stream) {
+        throw std::runtime_error("Could not write file.");
+    }
+}
+
+MappedDataTOImage::MappedDataTOImage(std::string const& filename)
+    : _file(filename.c_str(), boost::interprocess::read_only)
+    , _region(_file, boost::interprocess::copy_on_write)
+{
+    auto data = static_cast<uint8_t*>(_region.get_address());
+    auto size = _region.get_size();
+
+    ImageHeader header;
+    if (size < sizeof(ImageHeader)) {
+        throw std::runtime_error("No image detected.");
+    }
+    std::memcpy(&header, data, sizeof(ImageHeader));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        throw std::runtime_error("No image detected.");
+    }
+    header.programVersion[sizeof(header.programVersion) - 1] = 0;
+    if (header.imageVersion != ImageVersion || header.cellTOSize != sizeof(CellTO) || header.particleTOSize != sizeof(ParticleTO)
+        || std::string(header.programVersion) != Const::ProgramVersion) {
+        throw std::runtime_error("Image was created by a different program version.");
+    }
+    if (!isSectionInside(header.cellsOffset, header.numCells, sizeof(CellTO), size)
+        || !isSectionInside(header.particlesOffset, header.numParticles, sizeof(ParticleTO), size)
+        || !isSectionInside(header.auxiliaryDataOffset, header.numAuxiliaryData, 1, size)) {
+        throw std::runtime_error("Image is truncated.");
+    }
+    if (header.cellsOffset % alignof(CellTO) != 0 || header.particlesOffset % alignof(ParticleTO) != 0) {
+        throw std::runtime_error("Image sections are not aligned.");
+    }
+
+    _numCells = header.numCells;
+    _numParticles = header.numParticles;
+    _numAuxiliaryData = header.numAuxiliaryData;
+    _dataTO.numCells = &_numCells;
+    _dataTO.numParticles = &_numParticles;
+    _dataTO.numAuxiliaryData = &_numAuxiliaryData;
+    _dataTO.cells = reinterpret_cast<CellTO*>(data + header.cellsOffset);
+    _dataTO.particles = reinterpret_cast<ParticleTO*>(data + header.particlesOffset);
+    _dataTO.auxiliaryData = data + header.auxiliaryDataOffset;
+    checkReferences(_dataTO);
+}
+
+DataTO const& MappedDataTOImage::getDataTO() const
+{
+    return _dataTO;
+}
+
+ArraySizes MappedDataTOImage::getArraySizes() const
+{
+    return {_numCells, _numParticles, _numAuxiliaryData};
+}
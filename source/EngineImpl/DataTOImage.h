@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "EngineInterface/ArraySizes.h"
+#include "EngineGpuKernels/TOs.cuh"
+
+/**
+ * Raw image of a DataTO. The cell, particle and auxiliary data sections have exactly the memory layout of the CellTO, ParticleTO and
+ * auxiliary data arrays such that an image file can be memory-mapped and uploaded to the GPU without any conversion.
+ * Since the layout of the TOs may change between program versions, images are only readable by the same program version.
+ */
+class DataTOImageService
+{
+public:
+    static bool isDataTOImage(std::string const& filename);
+
+    static void writeImage(std::string const& filename, DataTO const& dataTO);
+};
+
+//read-only mapping of an image file, the returned DataTO is valid for the lifetime of the object
+class MappedDataTOImage
+{
+public:
+    MappedDataTOImage(std::string const& filename);
+    MappedDataTOImage(MappedDataTOImage const&) = delete;
+    void operator=(MappedDataTOImage const&) = delete;
+
+    DataTO const& getDataTO() const;
+    ArraySizes getArraySizes() const;
+
+private:
+    boost::interprocess::file_mapping _file;
+    boost::interprocess::mapped_region _region;
+
+    uint64_t _numCells = 0;
+    uint64_t _numParticles = 0;
+    uint64_t _numAuxiliaryData = 0;
+    DataTO _dataTO;
+};
@@ -1,103 +1,72 @@
 #include "DescriptionConverter.h"
 
 #include <cmath>
+#include <cstring>
 #include <algorithm>
-#include <boost/range/adaptor/map.hpp>
+#include <numeric>
 
 #include "Base/NumberGenerator.h"
 #include "Base/Exceptions.h"
+#include "Base/ThreadPool.h"
+#include "EngineInterface/GenomePool.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/GenomeConstants.h"
 
 
 namespace
 {
-    union BytesAsFloat
-    {
-        float f;
-        uint8_t b[4];
-    };
-
     void convert(DataTO const& dataTO, uint64_t sourceSize, uint64_t sourceIndex, std::vector<uint8_t>& target)
     {
-        target.resize(sourceSize);
-        for (int i = 0; i < sourceSize; ++i) {
-            target[i] = dataTO.auxiliaryData[sourceIndex + i];
-        }
+        target.assign(dataTO.auxiliaryData + sourceIndex, dataTO.auxiliaryData + sourceIndex + sourceSize);
     }
 
-    void convert(DataTO const& dataTO, uint64_t sourceSize, uint64_t sourceIndex, std::vector<float>& target)
+    //copies the bytes of source to dataTO.auxiliaryData[dataIndex] and advances dataIndex
+    template <typename Container, typename SizeType>
+    void convert(DataTO const& dataTO, Container const& source, SizeType& targetSize, uint64_t& targetIndex, uint64_t& dataIndex)
     {
-        BytesAsFloat bytesAsFloat;
-        target.resize(sourceSize / 4);
-        for (uint64_t i = 0; i < sourceSize / 4; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                bytesAsFloat.b[j] = dataTO.auxiliaryData[sourceIndex + i * 4 + j];
-            }
-            target[i] = bytesAsFloat.f;
+        auto size = source.size() * sizeof(typename Container::value_type);
+        targetSize = static_cast<SizeType>(size);
+        if (size > 0) {
+            targetIndex = dataIndex;
+            std::memcpy(dataTO.auxiliaryData + dataIndex, source.data(), size);
+            dataIndex += size;
         }
     }
 
-    template<typename Container, typename SizeType>
-    void convert(DataTO const& dataTO, Container const& source, SizeType& targetSize, uint64_t& targetIndex)
-    {
-        targetSize = source.size();
-        if (targetSize > 0) {
-            targetIndex = *dataTO.numAuxiliaryData;
-            uint64_t size = source.size();
-            for (uint64_t i = 0; i < size; ++i) {
-                dataTO.auxiliaryData[targetIndex + i] = source.at(i);
-            }
-            (*dataTO.numAuxiliaryData) += size;
-        }
-    }
+    //the weights are stored row by row followed by the biases
+    auto constexpr WeightsAndBiasesSize = sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1);
 
-    template <>
-    void convert(DataTO const& dataTO, std::vector<float> const& source, int& targetSize, uint64_t& targetIndex)
+    void writeWeightsAndBiases(DataTO const& dataTO, NeuronDescription const& neuron, uint64_t& targetIndex, uint64_t& dataIndex)
     {
-        BytesAsFloat bytesAsFloat;
-        targetSize = source.size() * 4;
-        if (targetSize > 0) {
-            targetIndex = *dataTO.numAuxiliaryData;
-            uint64_t size = source.size();
-            for (uint64_t i = 0; i < size; ++i) {
-                bytesAsFloat.f = source.at(i);
-                for (int j = 0; j < 4; ++j) {
-                    dataTO.auxiliaryData[targetIndex + i * 4 + j] = bytesAsFloat.b[j];
-                }
-            }
-            (*dataTO.numAuxiliaryData) += targetSize;
+        targetIndex = dataIndex;
+        for (int row = 0; row < MAX_CHANNELS; ++row) {
+            std::memcpy(dataTO.auxiliaryData + dataIndex, neuron.weights[row].data(), sizeof(float) * MAX_CHANNELS);
+            dataIndex += sizeof(float) * MAX_CHANNELS;
         }
+        std::memcpy(dataTO.auxiliaryData + dataIndex, neuron.biases.data(), sizeof(float) * MAX_CHANNELS);
+        dataIndex += sizeof(float) * MAX_CHANNELS;
     }
 
-    std::vector<float> unitWeightsAndBias(std::vector<std::vector<float>> const& weights, std::vector<float> const& bias)
+    //neuron needs to have MAX_CHANNELS x MAX_CHANNELS weights and MAX_CHANNELS biases
+    void readWeightsAndBiases(DataTO const& dataTO, uint64_t sourceIndex, NeuronDescription& neuron)
     {
-        std::vector<float> result(MAX_CHANNELS * MAX_CHANNELS + MAX_CHANNELS, 0);
         for (int row = 0; row < MAX_CHANNELS; ++row) {
-            for (int col = 0; col < MAX_CHANNELS; ++col) {
-                result[col + row * MAX_CHANNELS] = weights[row][col];
-            }
-        }
-        for (int col = 0; col < MAX_CHANNELS; ++col) {
-            result[col + MAX_CHANNELS * MAX_CHANNELS] = bias[col];
+            std::memcpy(neuron.weights[row].data(), dataTO.auxiliaryData + sourceIndex, sizeof(float) * MAX_CHANNELS);
+            sourceIndex += sizeof(float) * MAX_CHANNELS;
         }
-
-        return result;
+        std::memcpy(neuron.biases.data(), dataTO.auxiliaryData + sourceIndex, sizeof(float) * MAX_CHANNELS);
     }
 
-    std::pair<std::vector<std::vector<float>>, std::vector<float>> splitWeightsAndBias(std::vector<float> const& weightsAndBias)
+    std::vector<uint8_t> const* getGenome(CellDescription const& cell)
     {
-        std::vector<std::vector<float>> weights(MAX_CHANNELS, std::vector<float>(MAX_CHANNELS, 0));
-        for (int row = 0; row < MAX_CHANNELS; ++row) {
-            for (int col = 0; col < MAX_CHANNELS; ++col) {
-                weights[row][col] = weightsAndBias[col + row * MAX_CHANNELS];
-            }
+        switch (cell.getCellFunctionType()) {
+        case CellFunction_Constructor:
+            return &std::get<ConstructorDescription>(*cell.cellFunction).genome;
+        case CellFunction_Injector:
+            return &std::get<InjectorDescription>(*cell.cellFunction).genome;
+        default:
+            return nullptr;
         }
-
-        std::vector<float> bias;
-        bias = std::vector<float>(weightsAndBias.begin() + MAX_CHANNELS * MAX_CHANNELS, weightsAndBias.end());
-
-        return std::make_pair(weights, bias);
     }
 }
 
@@ -134,31 +103,23 @@ ClusteredDataDescription DescriptionConverter::convertTOtoClusteredDataDescripti
 	ClusteredDataDescription result;
 
     //cells
-    std::vector<ClusterDescription> clusters;
-    std::unordered_set<int> freeCellIndices;
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        freeCellIndices.insert(i);
-    }
-    std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-    std::unordered_map<int, int> cellTOIndexToClusterDescIndex;
-    int clusterDescIndex = 0;
-    while (!freeCellIndices.empty()) {
-        auto freeCellIndex = *freeCellIndices.begin();
-        auto createClusterData = scanAndCreateClusterDescription(dataTO, freeCellIndex, freeCellIndices);
-        clusters.emplace_back(createClusterData.cluster);
-
-        //update index maps
-        cellTOIndexToCellDescIndex.insert(
-            createClusterData.cellTOIndexToCellDescIndex.begin(), createClusterData.cellTOIndexToCellDescIndex.end());
-        for (auto const& cellTOIndex : createClusterData.cellTOIndexToCellDescIndex | boost::adaptors::map_keys) {
-            cellTOIndexToClusterDescIndex.emplace(cellTOIndex, clusterDescIndex);
+    auto numCells = toInt(*dataTO.numCells);
+    auto clusterAssignment = calcClusterAssignment(dataTO);
+    result.clusters.resize(clusterAssignment.clusterSizes.size());
+    for (size_t i = 0; i < result.clusters.size(); ++i) {
+        result.clusters[i].cells.resize(clusterAssignment.clusterSizes[i]);
+    }
+    auto cellRanges = calcCellRanges(numCells);
+    ThreadPool::getInstance().parallelFor(cellRanges.size(), [&](size_t rangeIndex) {
+        for (auto cellIndex = cellRanges[rangeIndex].first; cellIndex < cellRanges[rangeIndex].second; ++cellIndex) {
+            auto& cluster = result.clusters[clusterAssignment.clusterIndices[cellIndex]];
+            cluster.cells[clusterAssignment.indicesInCluster[cellIndex]] = createCellDescription(dataTO, cellIndex);
         }
-        ++clusterDescIndex;
-    }
-    result.addClusters(clusters);
+    });
 
     //particles
     std::vector<ParticleDescription> particles;
+    particles.reserve(*dataTO.numParticles);
     for (int i = 0; i < *dataTO.numParticles; ++i) {
         ParticleTO const& particle = dataTO.particles[i];
         particles.emplace_back(ParticleDescription()
@@ -178,14 +139,17 @@ DataDescription DescriptionConverter::convertTOtoDataDescription(DataTO const& d
     DataDescription result;
 
     //cells
-    std::vector<CellDescription> cells;
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        cells.emplace_back(createCellDescription(dataTO, i));
-    }
-    result.addCells(cells);
+    auto cellRanges = calcCellRanges(toInt(*dataTO.numCells));
+    result.cells.resize(*dataTO.numCells);
+    ThreadPool::getInstance().parallelFor(cellRanges.size(), [&](size_t rangeIndex) {
+        for (auto cellIndex = cellRanges[rangeIndex].first; cellIndex < cellRanges[rangeIndex].second; ++cellIndex) {
+            result.cells[cellIndex] = createCellDescription(dataTO, cellIndex);
+        }
+    });
 
     //particles
     std::vector<ParticleDescription> particles;
+    particles.reserve(*dataTO.numParticles);
     for (int i = 0; i < *dataTO.numParticles; ++i) {
         ParticleTO const& particle = dataTO.particles[i];
         particles.emplace_back(ParticleDescription()
@@ -228,21 +192,128 @@ OverlayDescription DescriptionConverter::convertTOtoOverlayDescription(DataTO co
     return result;
 }
 
-void DescriptionConverter::convertDescriptionToTO(DataTO& result, ClusteredDataDescription const& description) const
+SimulationSnapshot DescriptionConverter::convertTOtoSnapshot(DataTO const& dataTO) const
 {
-    std::unordered_map<uint64_t, int> cellIndexByIds;
-    for (auto const& cluster: description.clusters) {
-        for (auto const& cell : cluster.cells) {
-            addCell(result, cell, cellIndexByIds);
+    static_assert(sizeof(CellFunctionTO) <= sizeof(SnapshotCellFunctionData));
+
+    SimulationSnapshot result;
+
+    //cells
+    auto numCells = toInt(*dataTO.numCells);
+    result.cellIds.resize(numCells);
+    result.cellPositions.resize(numCells);
+    result.cellVelocities.resize(numCells);
+    result.cellEnergies.resize(numCells);
+    result.cellStiffnesses.resize(numCells);
+    result.cellColors.resize(numCells);
+    result.cellMaxConnections.resize(numCells);
+    result.cellBarriers.resize(numCells);
+    result.cellAges.resize(numCells);
+    result.cellLivingStates.resize(numCells);
+    result.cellCreatureIds.resize(numCells);
+    result.cellMutationIds.resize(numCells);
+    result.cellAncestorMutationIds.resize(numCells);
+    result.cellGenomeComplexities.resize(numCells);
+    result.cellExecutionOrderNumbers.resize(numCells);
+    result.cellInputExecutionOrderNumbers.resize(numCells);
+    result.cellOutputBlocked.resize(numCells);
+    result.cellFunctions.resize(numCells);
+    result.cellFunctionData.resize(numCells);
+    result.cellActivities.resize(numCells);
+    result.cellActivationTimes.resize(numCells);
+    result.cellDetectedByCreatureIds.resize(numCells);
+    result.cellFunctionUsed.resize(numCells);
+    result.cellSelected.resize(numCells);
+    result.cellGenomes.resize(numCells);
+    result.cellNames.resize(numCells);
+    result.cellDescriptions.resize(numCells);
+
+    result.connectionOffsets.resize(numCells + 1);
+    result.connectionOffsets[0] = 0;
+    for (int i = 0; i < numCells; ++i) {
+        result.connectionOffsets[i + 1] = result.connectionOffsets[i] + dataTO.cells[i].numConnections;
+    }
+    auto numConnections = result.connectionOffsets.back();
+    result.connectionCellIndices.resize(numConnections);
+    result.connectionDistances.resize(numConnections);
+    result.connectionAnglesFromPrevious.resize(numConnections);
+
+    auto cellRanges = calcCellRanges(numCells);
+    ThreadPool::getInstance().parallelFor(cellRanges.size(), [&](size_t rangeIndex) {
+        for (auto i = cellRanges[rangeIndex].first; i < cellRanges[rangeIndex].second; ++i) {
+            auto const& cellTO = dataTO.cells[i];
+            result.cellIds[i] = cellTO.id;
+            result.cellPositions[i] = {cellTO.pos.x, cellTO.pos.y};
+            result.cellVelocities[i] = {cellTO.vel.x, cellTO.vel.y};
+            result.cellEnergies[i] = cellTO.energy;
+            result.cellStiffnesses[i] = cellTO.stiffness;
+            result.cellColors[i] = cellTO.color;
+            result.cellMaxConnections[i] = cellTO.maxConnections;
+            result.cellBarriers[i] = cellTO.barrier;
+            result.cellAges[i] = cellTO.age;
+            result.cellLivingStates[i] = cellTO.livingState;
+            result.cellCreatureIds[i] = cellTO.creatureId;
+            result.cellMutationIds[i] = cellTO.mutationId;
+            result.cellAncestorMutationIds[i] = cellTO.ancestorMutationId;
+            result.cellGenomeComplexities[i] = cellTO.genomeComplexity;
+            result.cellExecutionOrderNumbers[i] = cellTO.executionOrderNumber;
+            result.cellInputExecutionOrderNumbers[i] = cellTO.inputExecutionOrderNumber;
+            result.cellOutputBlocked[i] = cellTO.outputBlocked;
+            result.cellFunctions[i] = cellTO.cellFunction;
+            std::memcpy(result.cellFunctionData[i].bytes, &cellTO.cellFunctionData, sizeof(CellFunctionTO));
+            std::memcpy(result.cellActivities[i].data(), cellTO.activity.channels, sizeof(float) * MAX_CHANNELS);
+            result.cellActivationTimes[i] = cellTO.activationTime;
+            result.cellDetectedByCreatureIds[i] = cellTO.detectedByCreatureId;
+            result.cellFunctionUsed[i] = cellTO.cellFunctionUsed;
+            result.cellSelected[i] = cellTO.selected;
+            if (cellTO.cellFunction == CellFunction_Constructor) {
+                result.cellGenomes[i] = {cellTO.cellFunctionData.constructor.genomeDataIndex, cellTO.cellFunctionData.constructor.genomeSize};
+            } else if (cellTO.cellFunction == CellFunction_Injector) {
+                result.cellGenomes[i] = {cellTO.cellFunctionData.injector.genomeDataIndex, cellTO.cellFunctionData.injector.genomeSize};
+            }
+            result.cellNames[i] = {cellTO.metadata.nameDataIndex, cellTO.metadata.nameSize};
+            result.cellDescriptions[i] = {cellTO.metadata.descriptionDataIndex, cellTO.metadata.descriptionSize};
+
+            auto connectionIndex = result.connectionOffsets[i];
+            for (int j = 0; j < cellTO.numConnections; ++j, ++connectionIndex) {
+                result.connectionCellIndices[connectionIndex] = cellTO.connections[j].cellIndex;
+                result.connectionDistances[connectionIndex] = cellTO.connections[j].distance;
+                result.connectionAnglesFromPrevious[connectionIndex] = cellTO.connections[j].angleFromPrevious;
+            }
         }
+    });
+
+    //particles
+    auto numParticles = toInt(*dataTO.numParticles);
+    result.particleIds.resize(numParticles);
+    result.particlePositions.resize(numParticles);
+    result.particleVelocities.resize(numParticles);
+    result.particleEnergies.resize(numParticles);
+    result.particleColors.resize(numParticles);
+    result.particleSelected.resize(numParticles);
+    for (int i = 0; i < numParticles; ++i) {
+        auto const& particleTO = dataTO.particles[i];
+        result.particleIds[i] = particleTO.id;
+        result.particlePositions[i] = {particleTO.pos.x, particleTO.pos.y};
+        result.particleVelocities[i] = {particleTO.vel.x, particleTO.vel.y};
+        result.particleEnergies[i] = particleTO.energy;
+        result.particleColors[i] = particleTO.color;
+        result.particleSelected[i] = particleTO.selected;
     }
+
+    result.auxiliaryData.assign(dataTO.auxiliaryData, dataTO.auxiliaryData + *dataTO.numAuxiliaryData);
+    return result;
+}
+
+void DescriptionConverter::convertDescriptionToTO(DataTO& result, ClusteredDataDescription const& description) const
+{
+    std::vector<CellDescription const*> cells;
     for (auto const& cluster : description.clusters) {
         for (auto const& cell : cluster.cells) {
-            if (cell.id != 0) {
-                setConnections(result, cell, cellIndexByIds);
-            }
+            cells.emplace_back(&cell);
         }
     }
+    addCells(result, cells, true);
     for (auto const& particle : description.particles) {
         addParticle(result, particle);
     }
@@ -250,15 +321,12 @@ void DescriptionConverter::convertDescriptionToTO(DataTO& result, ClusteredDataD
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, DataDescription const& description) const
 {
-    std::unordered_map<uint64_t, int> cellIndexByIds;
-    for (auto const& cell : description.cells) {
-        addCell(result, cell, cellIndexByIds);
-    }
+    std::vector<CellDescription const*> cells;
+    cells.reserve(description.cells.size());
     for (auto const& cell : description.cells) {
-        if (cell.id != 0) {
-            setConnections(result, cell, cellIndexByIds);
-        }
+        cells.emplace_back(&cell);
     }
+    addCells(result, cells, true);
     for (auto const& particle : description.particles) {
         addParticle(result, particle);
     }
@@ -266,8 +334,7 @@ void DescriptionConverter::convertDescriptionToTO(DataTO& result, DataDescriptio
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, CellDescription const& cell) const
 {
-    std::unordered_map<uint64_t, int> cellIndexByIds;
-    addCell(result, cell, cellIndexByIds);
+    addCells(result, {&cell}, false);
 }
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, ParticleDescription const& particle) const
@@ -275,88 +342,196 @@ void DescriptionConverter::convertDescriptionToTO(DataTO& result, ParticleDescri
     addParticle(result, particle);
 }
 
-void DescriptionConverter::addAdditionalDataSizeForCell(CellDescription const& cell, uint64_t& additionalDataSize) const
+void DescriptionConverter::convertSnapshotToTO(DataTO& result, SimulationSnapshot const& snapshot) const
 {
-    additionalDataSize += cell.metadata.name.size() + cell.metadata.description.size();
-    switch (cell.getCellFunctionType()) {
-    case CellFunction_Neuron: {
-        additionalDataSize += MAX_CHANNELS * (MAX_CHANNELS + 1) * sizeof(float);
-    } break;
-    case CellFunction_Transmitter:
-        break;
-    case CellFunction_Constructor:
-        additionalDataSize += std::get<ConstructorDescription>(*cell.cellFunction).genome.size();
-        break;
-    case CellFunction_Sensor:
-        break;
-    case CellFunction_Nerve:
-        break;
-    case CellFunction_Attacker:
-        break;
-    case CellFunction_Injector:
-        additionalDataSize += std::get<InjectorDescription>(*cell.cellFunction).genome.size();
-        break;
-    case CellFunction_Muscle:
-        break;
-    case CellFunction_Defender:
-        break;
-    case CellFunction_Reconnector:
-        break;
-    case CellFunction_Detonator:
-        break;
+    auto numCells = toInt(snapshot.getNumCells());
+
+    //the connections are copied into fixed arrays of the cells and refer to cells on the GPU, hence they are checked beforehand
+    for (int i = 0; i < numCells; ++i) {
+        if (snapshot.getNumConnections(i) > MAX_CELL_BONDS) {
+            throw std::runtime_error("Snapshot contains a cell with too many connections.");
+        }
+    }
+    if (std::ranges::any_of(snapshot.connectionCellIndices, [&](int cellIndex) { return cellIndex < 0 || cellIndex >= numCells; })) {
+        throw std::runtime_error("Snapshot contains a connection to a non-existent cell.");
     }
+
+    //the auxiliary data ranges are stored with 16 bit sizes and are dereferenced on the GPU without further checks (offsets of empty ranges are unused)
+    auto numAuxiliaryData = snapshot.auxiliaryData.size();
+    auto isRangeValid = [&](SnapshotDataRange const& range) {
+        return range.size == 0
+            || (range.size <= std::numeric_limits<uint16_t>::max() && range.offset <= numAuxiliaryData && range.size <= numAuxiliaryData - range.offset);
+    };
+    for (int i = 0; i < numCells; ++i) {
+        auto isAuxiliaryDataValid = isRangeValid(snapshot.cellGenomes[i]) && isRangeValid(snapshot.cellNames[i]) && isRangeValid(snapshot.cellDescriptions[i]);
+        if (snapshot.cellFunctions[i] == CellFunction_Neuron) {
+            CellFunctionTO cellFunctionTO;
+            std::memcpy(&cellFunctionTO, snapshot.cellFunctionData[i].bytes, sizeof(CellFunctionTO));
+            isAuxiliaryDataValid &= isRangeValid({cellFunctionTO.neuron.weightsAndBiasesDataIndex, WeightsAndBiasesSize});
+        }
+        if (!isAuxiliaryDataValid) {
+            throw std::runtime_error("Snapshot contains a cell with invalid auxiliary data.");
+        }
+    }
+
+    auto cellRanges = calcCellRanges(numCells);
+    ThreadPool::getInstance().parallelFor(cellRanges.size(), [&](size_t rangeIndex) {
+        for (auto i = cellRanges[rangeIndex].first; i < cellRanges[rangeIndex].second; ++i) {
+            auto& cellTO = result.cells[i];
+            cellTO.id = snapshot.cellIds[i];
+            cellTO.pos = {snapshot.cellPositions[i].x, snapshot.cellPositions[i].y};
+            cellTO.vel = {snapshot.cellVelocities[i].x, snapshot.cellVelocities[i].y};
+            cellTO.energy = snapshot.cellEnergies[i];
+            cellTO.stiffness = snapshot.cellStiffnesses[i];
+            cellTO.color = snapshot.cellColors[i];
+            cellTO.maxConnections = snapshot.cellMaxConnections[i];
+            cellTO.barrier = snapshot.cellBarriers[i];
+            cellTO.age = snapshot.cellAges[i];
+            cellTO.livingState = snapshot.cellLivingStates[i];
+            cellTO.creatureId = snapshot.cellCreatureIds[i];
+            cellTO.mutationId = snapshot.cellMutationIds[i];
+            cellTO.ancestorMutationId = snapshot.cellAncestorMutationIds[i];
+            cellTO.genomeComplexity = snapshot.cellGenomeComplexities[i];
+            cellTO.executionOrderNumber = snapshot.cellExecutionOrderNumbers[i];
+            cellTO.inputExecutionOrderNumber = snapshot.cellInputExecutionOrderNumbers[i];
+            cellTO.outputBlocked = snapshot.cellOutputBlocked[i];
+            cellTO.cellFunction = snapshot.cellFunctions[i];
+            std::memcpy(&cellTO.cellFunctionData, snapshot.cellFunctionData[i].bytes, sizeof(CellFunctionTO));
+            if (cellTO.cellFunction == CellFunction_Constructor) {
+                cellTO.cellFunctionData.constructor.genomeDataIndex = snapshot.cellGenomes[i].offset;
+                cellTO.cellFunctionData.constructor.genomeSize = static_cast<uint16_t>(snapshot.cellGenomes[i].size);
+            } else if (cellTO.cellFunction == CellFunction_Injector) {
+                cellTO.cellFunctionData.injector.genomeDataIndex = snapshot.cellGenomes[i].offset;
+                cellTO.cellFunctionData.injector.genomeSize = static_cast<uint16_t>(snapshot.cellGenomes[i].size);
+            }
+            std::memcpy(cellTO.activity.channels, snapshot.cellActivities[i].data(), sizeof(float) * MAX_CHANNELS);
+            cellTO.activationTime = snapshot.cellActivationTimes[i];
+            cellTO.detectedByCreatureId = snapshot.cellDetectedByCreatureIds[i];
+            cellTO.cellFunctionUsed = snapshot.cellFunctionUsed[i];
+            cellTO.selected = snapshot.cellSelected[i];
+            cellTO.metadata.nameDataIndex = snapshot.cellNames[i].offset;
+            cellTO.metadata.nameSize = static_cast<uint16_t>(snapshot.cellNames[i].size);
+            cellTO.metadata.descriptionDataIndex = snapshot.cellDescriptions[i].offset;
+            cellTO.metadata.descriptionSize = static_cast<uint16_t>(snapshot.cellDescriptions[i].size);
+
+            auto connectionIndex = snapshot.connectionOffsets[i];
+            cellTO.numConnections = static_cast<uint8_t>(snapshot.getNumConnections(i));
+            for (int j = 0; j < cellTO.numConnections; ++j, ++connectionIndex) {
+                cellTO.connections[j].cellIndex = snapshot.connectionCellIndices[connectionIndex];
+                cellTO.connections[j].distance = snapshot.connectionDistances[connectionIndex];
+                cellTO.connections[j].angleFromPrevious = snapshot.connectionAnglesFromPrevious[connectionIndex];
+            }
+        }
+    });
+    *result.numCells = numCells;
+
+    auto numParticles = toInt(snapshot.getNumParticles());
+    for (int i = 0; i < numParticles; ++i) {
+        auto& particleTO = result.particles[i];
+        particleTO.id = snapshot.particleIds[i];
+        particleTO.pos = {snapshot.particlePositions[i].x, snapshot.particlePositions[i].y};
+        particleTO.vel = {snapshot.particleVelocities[i].x, snapshot.particleVelocities[i].y};
+        particleTO.energy = snapshot.particleEnergies[i];
+        particleTO.color = snapshot.particleColors[i];
+        particleTO.selected = snapshot.particleSelected[i];
+    }
+    *result.numParticles = numParticles;
+
+    if (!snapshot.auxiliaryData.empty()) {
+        std::memcpy(result.auxiliaryData, snapshot.auxiliaryData.data(), snapshot.auxiliaryData.size());
+    }
+    *result.numAuxiliaryData = snapshot.auxiliaryData.size();
+}
+
+void DescriptionConverter::addAdditionalDataSizeForCell(CellDescription const& cell, uint64_t& additionalDataSize) const
+{
+    additionalDataSize += cell.getAuxiliaryDataSize();
 }    
 
 namespace
 {
-    template <typename T>
-    void setInplaceDifference(std::unordered_set<T>& a, std::unordered_set<T> const& b)
+    //union-find with path halving, the root of a set is its smallest index, i.e. parents[i] <= i holds at all times
+    int findRoot(std::vector<int>& parents, int index)
     {
-        for (auto const& element : b) {
-            a.erase(element);
+        while (parents[index] != index) {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
+        }
+        return index;
+    }
+
+    void unite(std::vector<int>& parents, int index1, int index2)
+    {
+        auto root1 = findRoot(parents, index1);
+        auto root2 = findRoot(parents, index2);
+        if (root1 < root2) {
+            parents[root2] = root1;
+        } else if (root2 < root1) {
+            parents[root1] = root2;
         }
     }
 }
 
-auto DescriptionConverter::scanAndCreateClusterDescription(
-    DataTO const& dataTO,
-    int startCellIndex,
-    std::unordered_set<int>& freeCellIndices) const
-    -> CreateClusterReturnData
+auto DescriptionConverter::calcCellRanges(int numCells) const -> std::vector<std::pair<int, int>>
+{
+    auto constexpr MinCellsPerRange = 4096;
+    auto numRanges = std::max(1, std::min(ThreadPool::getInstance().getNumThreads() * 4, numCells / MinCellsPerRange));
+    std::vector<std::pair<int, int>> result;
+    result.reserve(numRanges);
+    for (int i = 0; i < numRanges; ++i) {
+        result.emplace_back(toInt(int64_t(numCells) * i / numRanges), toInt(int64_t(numCells) * (i + 1) / numRanges));
+    }
+    return result;
+}
+
+auto DescriptionConverter::calcClusterAssignment(DataTO const& dataTO) const -> ClusterAssignment
 {
-    CreateClusterReturnData result; 
-
-    std::unordered_set<int> currentCellIndices;
-    currentCellIndices.insert(startCellIndex);
-    std::unordered_set<int> scannedCellIndices = currentCellIndices;
-
-    std::vector<CellDescription> cells;
-    std::unordered_set<int> nextCellIndices;
-    int cellDescIndex = 0;
-    do {
-        for (auto const& currentCellIndex : currentCellIndices) {
-            cells.emplace_back(createCellDescription(dataTO, currentCellIndex));
-            result.cellTOIndexToCellDescIndex.emplace(currentCellIndex, cellDescIndex);
-            auto const& cellTO = dataTO.cells[currentCellIndex];
+    auto numCells = toInt(*dataTO.numCells);
+    std::vector<int> parents(numCells);
+    std::iota(parents.begin(), parents.end(), 0);
+
+    //connected components within each cell range are calculated in parallel since the union-find only touches indices of the same range,
+    //connections across ranges are merged afterwards
+    auto cellRanges = calcCellRanges(numCells);
+    std::vector<std::vector<std::pair<int, int>>> crossRangeConnections(cellRanges.size());
+    ThreadPool::getInstance().parallelFor(cellRanges.size(), [&](size_t rangeIndex) {
+        auto [rangeStart, rangeEnd] = cellRanges[rangeIndex];
+        for (auto cellIndex = rangeStart; cellIndex < rangeEnd; ++cellIndex) {
+            auto const& cellTO = dataTO.cells[cellIndex];
             for (int i = 0; i < cellTO.numConnections; ++i) {
-                auto connectionTO = cellTO.connections[i];
-                if (connectionTO.cellIndex != -1) {
-                    if (scannedCellIndices.find(connectionTO.cellIndex) == scannedCellIndices.end()) {
-                        nextCellIndices.insert(connectionTO.cellIndex);
-                        scannedCellIndices.insert(connectionTO.cellIndex);
-                    }
+                auto connectedCellIndex = cellTO.connections[i].cellIndex;
+                if (connectedCellIndex == -1) {
+                    continue;
+                }
+                if (connectedCellIndex >= rangeStart && connectedCellIndex < rangeEnd) {
+                    unite(parents, cellIndex, connectedCellIndex);
+                } else {
+                    crossRangeConnections[rangeIndex].emplace_back(cellIndex, connectedCellIndex);
                 }
             }
-            ++cellDescIndex;
         }
-        currentCellIndices = nextCellIndices;
-        nextCellIndices.clear();
-    } while (!currentCellIndices.empty());
-
-    setInplaceDifference(freeCellIndices, scannedCellIndices);
-
-    result.cluster.addCells(cells);
+    });
+    for (auto const& connections : crossRangeConnections) {
+        for (auto const& [cellIndex, connectedCellIndex] : connections) {
+            unite(parents, cellIndex, connectedCellIndex);
+        }
+    }
 
+    //clusters are numbered in the order of their smallest cell index and the cells of a cluster keep their order from the DataTO
+    ClusterAssignment result;
+    result.clusterIndices.resize(numCells);
+    result.indicesInCluster.resize(numCells);
+    for (int cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+        auto root = parents[parents[cellIndex]];
+        parents[cellIndex] = root;
+        if (root == cellIndex) {
+            result.clusterIndices[cellIndex] = toInt(result.clusterSizes.size());
+            result.clusterSizes.emplace_back(0);
+        } else {
+            result.clusterIndices[cellIndex] = result.clusterIndices[root];
+        }
+        result.indicesInCluster[cellIndex] = result.clusterSizes[result.clusterIndices[cellIndex]]++;
+    }
     return result;
 }
 
@@ -372,6 +547,7 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
     result.stiffness = cellTO.stiffness;
     result.maxConnections = cellTO.maxConnections;
     std::vector<ConnectionDescription> connections;
+    connections.reserve(cellTO.numConnections);
     for (int i = 0; i < cellTO.numConnections; ++i) {
         auto const& connectionTO = cellTO.connections[i];
         ConnectionDescription connection;
@@ -384,7 +560,7 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
         connection.angleFromPrevious = connectionTO.angleFromPrevious;
         connections.emplace_back(connection);
     }
-    result.connections = connections;
+    result.connections = std::move(connections);
     result.livingState = cellTO.livingState;
     result.creatureId = cellTO.creatureId;
     result.mutationId = cellTO.mutationId;
@@ -415,9 +591,7 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
     switch (cellTO.cellFunction) {
     case CellFunction_Neuron: {
         NeuronDescription neuron;
-        std::vector<float> weigthsAndBias;
-        convert(dataTO, sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1), cellTO.cellFunctionData.neuron.weightsAndBiasesDataIndex, weigthsAndBias);
-        std::tie(neuron.weights, neuron.biases) = splitWeightsAndBias(weigthsAndBias);
+        readWeightsAndBiases(dataTO, cellTO.cellFunctionData.neuron.weightsAndBiasesDataIndex, neuron);
         for (int i = 0; i < MAX_CHANNELS; ++i) {
             neuron.activationFunctions[i] = cellTO.cellFunctionData.neuron.activationFunctions[i];
         }
@@ -540,12 +714,83 @@ void DescriptionConverter::addParticle(DataTO const& dataTO, ParticleDescription
     particleTO.color = particleDesc.color;
 }
 
+void DescriptionConverter::addCells(DataTO const& dataTO, std::vector<CellDescription const*> const& cells, bool withConnections) const
+{
+    auto numCells = toInt(cells.size());
+    auto firstCellIndex = toInt(*dataTO.numCells);
+
+    //ids and genome deduplication need to be processed sequentially
+    std::vector<uint64_t> cellIds(numCells);
+    std::unordered_map<uint64_t, int> cellIndexByIds;
+    cellIndexByIds.reserve(numCells);
+    GenomePool genomePool;
+    std::vector<int> genomeOwners;  //genome handle -> cell which writes the genome into the auxiliary data
+    std::vector<int> genomeHandles(numCells, -1);
+    for (int i = 0; i < numCells; ++i) {
+        auto const& cell = *cells[i];
+        cellIds[i] = cell.id == 0 ? NumberGenerator::getInstance().getId() : cell.id;
+        cellIndexByIds.insert_or_assign(cellIds[i], firstCellIndex + i);
+        if (auto genome = getGenome(cell)) {
+            CHECK(genome->size() >= Const::GenomeHeaderSize)
+            auto handle = toInt(genomePool.add(*genome));
+            if (handle == toInt(genomeOwners.size())) {
+                genomeOwners.emplace_back(i);
+            }
+            genomeHandles[i] = handle;
+        }
+    }
+
+    //the auxiliary data of each cell starts at an index given by a prefix sum over the sizes
+    auto cellRanges = calcCellRanges(numCells);
+    std::vector<uint64_t> dataIndices(numCells);
+    ThreadPool::getInstance().parallelFor(cellRanges.size(), [&](size_t rangeIndex) {
+        for (auto i = cellRanges[rangeIndex].first; i < cellRanges[rangeIndex].second; ++i) {
+            auto const& cell = *cells[i];
+            dataIndices[i] = cell.metadata.name.size() + cell.metadata.description.size();
+            if (cell.getCellFunctionType() == CellFunction_Neuron) {
+                dataIndices[i] += WeightsAndBiasesSize;
+            }
+            if (genomeHandles[i] != -1 && genomeOwners[genomeHandles[i]] == i) {
+                dataIndices[i] += getGenome(cell)->size();
+            }
+        }
+    });
+    auto auxiliaryDataSize = numCells > 0 ? dataIndices.back() : 0;
+    std::exclusive_scan(dataIndices.begin(), dataIndices.end(), dataIndices.begin(), *dataTO.numAuxiliaryData);
+    if (numCells > 0) {
+        auxiliaryDataSize += dataIndices.back() - *dataTO.numAuxiliaryData;
+    }
+
+    ThreadPool::getInstance().parallelFor(cellRanges.size(), [&](size_t rangeIndex) {
+        for (auto i = cellRanges[rangeIndex].first; i < cellRanges[rangeIndex].second; ++i) {
+            auto genomeDataIndex = genomeHandles[i] != -1 ? dataIndices[genomeOwners[genomeHandles[i]]] : 0;
+            addCell(dataTO, *cells[i], firstCellIndex + i, cellIds[i], dataIndices[i], genomeDataIndex);
+        }
+    });
+    *dataTO.numCells += numCells;
+    *dataTO.numAuxiliaryData += auxiliaryDataSize;
+
+    if (withConnections) {
+        ThreadPool::getInstance().parallelFor(cellRanges.size(), [&](size_t rangeIndex) {
+            for (auto i = cellRanges[rangeIndex].first; i < cellRanges[rangeIndex].second; ++i) {
+                if (cells[i]->id != 0) {
+                    setConnections(dataTO, *cells[i], cellIndexByIds);
+                }
+            }
+        });
+    }
+}
+
 void DescriptionConverter::addCell(
-    DataTO const& dataTO, CellDescription const& cellDesc, std::unordered_map<uint64_t, int>& cellIndexTOByIds) const
+    DataTO const& dataTO,
+    CellDescription const& cellDesc,
+    int cellIndex,
+    uint64_t cellId,
+    uint64_t dataIndex,
+    uint64_t genomeDataIndex) const
 {
-    int cellIndex = (*dataTO.numCells)++;
     CellTO& cellTO = dataTO.cells[cellIndex];
-    cellTO.id = cellDesc.id == 0 ? NumberGenerator::getInstance().getId() : cellDesc.id;
+    cellTO.id = cellId;
 	cellTO.pos= { cellDesc.pos.x, cellDesc.pos.y };
     cellTO.vel = {cellDesc.vel.x, cellDesc.vel.y};
     cellTO.energy = cellDesc.energy;
@@ -566,10 +811,7 @@ void DescriptionConverter::addCell(
     case CellFunction_Neuron: {
         NeuronTO neuronTO;
         auto const& neuronDesc = std::get<NeuronDescription>(*cellDesc.cellFunction);
-        std::vector<float> weigthsAndBias = unitWeightsAndBias(neuronDesc.weights, neuronDesc.biases);
-        int targetSize;
-        convert(dataTO, weigthsAndBias, targetSize, neuronTO.weightsAndBiasesDataIndex);
-        CHECK(targetSize == sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1));
+        writeWeightsAndBiases(dataTO, neuronDesc, neuronTO.weightsAndBiasesDataIndex, dataIndex);
         for (int i = 0; i < MAX_CHANNELS; ++i) {
             neuronTO.activationFunctions[i] = neuronDesc.activationFunctions[i];
         }
@@ -586,8 +828,12 @@ void DescriptionConverter::addCell(
         ConstructorTO constructorTO;
         constructorTO.activationMode = constructorDesc.activationMode;
         constructorTO.constructionActivationTime = constructorDesc.constructionActivationTime;
-        CHECK(constructorDesc.genome.size() >= Const::GenomeHeaderSize)
-        convert(dataTO, constructorDesc.genome, constructorTO.genomeSize, constructorTO.genomeDataIndex);
+        if (genomeDataIndex == dataIndex) {
+            convert(dataTO, constructorDesc.genome, constructorTO.genomeSize, constructorTO.genomeDataIndex, dataIndex);
+        } else {
+            constructorTO.genomeSize = static_cast<uint16_t>(constructorDesc.genome.size());
+            constructorTO.genomeDataIndex = genomeDataIndex;
+        }
         constructorTO.numInheritedGenomeNodes = static_cast<uint16_t>(constructorDesc.numInheritedGenomeNodes);
         constructorTO.lastConstructedCellId = constructorDesc.lastConstructedCellId;
         constructorTO.genomeCurrentNodeIndex = static_cast<uint16_t>(constructorDesc.genomeCurrentNodeIndex);
@@ -635,8 +881,12 @@ void DescriptionConverter::addCell(
         InjectorTO injectorTO;
         injectorTO.mode = injectorDesc.mode;
         injectorTO.counter = injectorDesc.counter;
-        CHECK(injectorDesc.genome.size() >= Const::GenomeHeaderSize)
-        convert(dataTO, injectorDesc.genome, injectorTO.genomeSize, injectorTO.genomeDataIndex);
+        if (genomeDataIndex == dataIndex) {
+            convert(dataTO, injectorDesc.genome, injectorTO.genomeSize, injectorTO.genomeDataIndex, dataIndex);
+        } else {
+            injectorTO.genomeSize = static_cast<uint16_t>(injectorDesc.genome.size());
+            injectorTO.genomeDataIndex = genomeDataIndex;
+        }
         injectorTO.genomeGeneration = injectorDesc.genomeGeneration;
         cellTO.cellFunctionData.injector = injectorTO;
     } break;
@@ -679,9 +929,8 @@ void DescriptionConverter::addCell(
     cellTO.age = cellDesc.age;
     cellTO.color = cellDesc.color;
     cellTO.genomeComplexity = cellDesc.genomeComplexity;
-    convert(dataTO, cellDesc.metadata.name, cellTO.metadata.nameSize, cellTO.metadata.nameDataIndex);
-    convert(dataTO, cellDesc.metadata.description, cellTO.metadata.descriptionSize, cellTO.metadata.descriptionDataIndex);
-	cellIndexTOByIds.insert_or_assign(cellTO.id, cellIndex);
+    convert(dataTO, cellDesc.metadata.name, cellTO.metadata.nameSize, cellTO.metadata.nameDataIndex, dataIndex);
+    convert(dataTO, cellDesc.metadata.description, cellTO.metadata.descriptionSize, cellTO.metadata.descriptionDataIndex, dataIndex);
 }
 
 void DescriptionConverter::setConnections(DataTO const& dataTO, CellDescription const& cellToAdd, std::unordered_map<uint64_t, int> const& cellIndexByIds) const
@@ -7,6 +7,7 @@
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/OverlayDescriptions.h"
 #include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/SimulationSnapshot.h"
 #include "EngineGpuKernels/TOs.cuh"
 #include "Definitions.h"
 
@@ -15,33 +16,43 @@ class DescriptionConverter
 public:
     DescriptionConverter(SimulationParameters const& parameters);
 
+    //the auxiliary data size covers a separate genome copy for each cell since the GPU does not share genomes
     ArraySizes getArraySizes(DataDescription const& data) const;
     ArraySizes getArraySizes(ClusteredDataDescription const& data) const;
 
     ClusteredDataDescription convertTOtoClusteredDataDescription(DataTO const& dataTO) const;
     DataDescription convertTOtoDataDescription(DataTO const& dataTO) const;
     OverlayDescription convertTOtoOverlayDescription(DataTO const& dataTO) const;
+    SimulationSnapshot convertTOtoSnapshot(DataTO const& dataTO) const;
     void convertDescriptionToTO(DataTO& result, ClusteredDataDescription const& description) const;
     void convertDescriptionToTO(DataTO& result, DataDescription const& description) const;
     void convertDescriptionToTO(DataTO& result, CellDescription const& cell) const;
     void convertDescriptionToTO(DataTO& result, ParticleDescription const& particle) const;
 
+    //replaces the content of the DataTO, the genome ranges of the snapshot take precedence over the indices in the cell function data
+    //throws std::runtime_error if a cell has more than MAX_CELL_BONDS connections or a connection refers to a non-existent cell
+    void convertSnapshotToTO(DataTO& result, SimulationSnapshot const& snapshot) const;
+
 private:
     void addAdditionalDataSizeForCell(CellDescription const& cell, uint64_t& additionalDataSize) const;
 
-	struct CreateClusterReturnData
+    //splits the cell indices into ranges which are processed in parallel
+    std::vector<std::pair<int, int>> calcCellRanges(int numCells) const;
+
+    //connected components of the cells w.r.t. CellTO::connections
+    struct ClusterAssignment
     {
-        ClusterDescription cluster;
-        std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-	};
-    CreateClusterReturnData scanAndCreateClusterDescription(
-        DataTO const& dataTO,
-        int startCellIndex,
-        std::unordered_set<int>& freeCellIndices) const;
+        std::vector<int> clusterIndices;    //cell index -> cluster index
+        std::vector<int> indicesInCluster;  //cell index -> index in cluster
+        std::vector<int> clusterSizes;
+    };
+    ClusterAssignment calcClusterAssignment(DataTO const& dataTO) const;
     CellDescription createCellDescription(DataTO const& dataTO, int cellIndex) const;
 
-	void addCell(
-        DataTO const& dataTO, CellDescription const& cellToAdd, std::unordered_map<uint64_t, int>& cellIndexTOByIds) const;
+    //the cells are converted in parallel, byte-identical genomes are written only once into the auxiliary data
+    void addCells(DataTO const& dataTO, std::vector<CellDescription const*> const& cells, bool withConnections) const;
+    //the auxiliary data of the cell is written from dataIndex on, the genome is only written if genomeDataIndex coincides with dataIndex
+    void addCell(DataTO const& dataTO, CellDescription const& cellDesc, int cellIndex, uint64_t cellId, uint64_t dataIndex, uint64_t genomeDataIndex) const;
     void addParticle(DataTO const& dataTO, ParticleDescription const& particleDesc) const;
 
 	void setConnections(
@@ -1,10 +1,12 @@
 #include "EngineWorker.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include "EngineGpuKernels/TOs.cuh"
 #include "EngineGpuKernels/SimulationCudaFacade.cuh"
 #include "AccessDataTOCache.h"
+#include "DataTOImage.h"
 #include "DescriptionConverter.h"
 
 namespace
@@ -14,10 +16,13 @@ namespace
 
 void EngineWorker::newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters)
 {
+    waitForCommands(_numPendingCommands, 0);
     _accessState = 0;
     _settings.generalSettings = generalSettings;
     _settings.simulationParameters = parameters;
-    _dataTOCache = std::make_shared<_AccessDataTOCache>();
+    _dataTOCache = std::make_shared<_AccessDataTOCache>(TransferMemory_Pinned);
+    _changeDataTOCache = std::make_shared<_AccessDataTOCache>(TransferMemory_Pinned, 1);
+    _nextUploadBufferIndex = 0;
     _simulationCudaFacade = std::make_shared<_SimulationCudaFacade>(timestep, _settings);
 
     if (_imageResource) {
@@ -106,6 +111,7 @@ bool EngineWorker::isSyncSimulationWithRendering() const
 void EngineWorker::setSyncSimulationWithRendering(bool value)
 {
     _syncSimulationWithRendering = value;
+    notifyWorker();
 }
 
 int EngineWorker::getSyncSimulationWithRenderingRatio() const
@@ -251,6 +257,79 @@ void EngineWorker::setSimulationData(DataDescription const& dataToUpdate)
     _simulationCudaFacade->setSimulationData(dataTO);
 }
 
+void EngineWorker::setSimulationData(DataTO const& dataTO)
+{
+    EngineWorkerGuard access(this);
+
+    _simulationCudaFacade->resizeArraysIfNecessary({*dataTO.numCells, *dataTO.numParticles, *dataTO.numAuxiliaryData});
+    _simulationCudaFacade->setSimulationData(dataTO);
+}
+
+void EngineWorker::reserveSimulationData(ArraySizes const& arraySizes)
+{
+    EngineWorkerGuard access(this);
+
+    _simulationCudaFacade->resizeArraysIfNecessary(arraySizes);
+}
+
+void EngineWorker::addClusteredSimulationData(ClusteredDataDescription const& dataToAdd)
+{
+    DescriptionConverter converter(_settings.simulationParameters);
+    auto arraySizes = converter.getArraySizes(dataToAdd);
+
+    //the conversion of this batch overlaps with the transfer of the previous batch by the worker thread
+    auto bufferIndex = _nextUploadBufferIndex;
+    _nextUploadBufferIndex = (_nextUploadBufferIndex + 1) % _dataTOCache->getNumBuffers();
+    waitForCommands(_numPendingUploadJobs, _dataTOCache->getNumBuffers() - 1);
+
+    //transfer data is only sized for the added data (not for the whole simulation) in order to keep the host memory bounded
+    DataTO dataTO = _dataTOCache->getDataTO(arraySizes, bufferIndex);
+    converter.convertDescriptionToTO(dataTO, dataToAdd);
+
+    pushCommand(UploadJob{arraySizes, bufferIndex});
+}
+
+void EngineWorker::saveSimulationDataImage(std::string const& filename, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    EngineWorkerGuard access(this);
+
+    DataTO dataTO = provideTO();
+    _simulationCudaFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+
+    DataTOImageService::writeImage(filename, dataTO);
+}
+
+void EngineWorker::loadSimulationDataImage(std::string const& filename)
+{
+    MappedDataTOImage image(filename);
+    setSimulationData(image.getDataTO());
+}
+
+SimulationSnapshot EngineWorker::getSnapshot(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    EngineWorkerGuard access(this);
+
+    DataTO dataTO = provideTO();
+    _simulationCudaFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+
+    DescriptionConverter converter(_settings.simulationParameters);
+    return converter.convertTOtoSnapshot(dataTO);
+}
+
+void EngineWorker::setSnapshot(SimulationSnapshot const& snapshot)
+{
+    DescriptionConverter converter(_settings.simulationParameters);
+
+    EngineWorkerGuard access(this);
+
+    _simulationCudaFacade->resizeArraysIfNecessary({snapshot.getNumCells(), snapshot.getNumParticles(), snapshot.auxiliaryData.size()});
+
+    DataTO dataTO = provideTO();
+    converter.convertSnapshotToTO(dataTO, snapshot);
+
+    _simulationCudaFacade->setSimulationData(dataTO);
+}
+
 void EngineWorker::removeSelectedObjects(bool includeClusters)
 {
     EngineWorkerGuard access(this);
@@ -295,26 +374,12 @@ void EngineWorker::setBarrier(bool value, bool includeClusters)
 
 void EngineWorker::changeCell(CellDescription const& changedCell)
 {
-    EngineWorkerGuard access(this);
-
-    auto dataTO = provideTO();
-
-    DescriptionConverter converter(_settings.simulationParameters);
-    converter.convertDescriptionToTO(dataTO, changedCell);
-
-    _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+    pushCommand(ChangeCellCommand{changedCell});
 }
 
 void EngineWorker::changeParticle(ParticleDescription const& changedParticle)
 {
-    EngineWorkerGuard access(this);
-
-    auto dataTO = provideTO();
-
-    DescriptionConverter converter(_settings.simulationParameters);
-    converter.convertDescriptionToTO(dataTO, changedParticle);
-
-    _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+    pushCommand(ChangeParticleCommand{changedParticle});
 }
 
 void EngineWorker::calcTimesteps(uint64_t timesteps)
@@ -333,29 +398,58 @@ void EngineWorker::applyCataclysm(int power)
 void EngineWorker::beginShutdown()
 {
     _isShutdown.store(true);
+    notifyWorker();
 }
 
 void EngineWorker::endShutdown()
 {
+    _commandQueue.popAll();
+    _numPendingCommands = 0;
+    _numPendingUploadJobs = 0;
     _isSimulationRunning = false;
     _isShutdown = false;
+
+    //pinned transfer buffers must be released before the facade since its destructor resets the device, which frees all pinned host memory
+    _dataTOCache.reset();
+    _changeDataTOCache.reset();
     _simulationCudaFacade.reset();
 }
 
 int EngineWorker::getTpsRestriction() const
 {
-    auto result = _tpsRestriction.load();
-    return result;
+    return _timestepGovernor.getSettings().maxTps.value_or(0);
 }
 
 void EngineWorker::setTpsRestriction(int value)
 {
-    _tpsRestriction.store(value);
+    auto settings = _timestepGovernor.getSettings();
+    settings.maxTps = value > 0 ? std::make_optional(value) : std::nullopt;
+    _timestepGovernor.setSettings(settings);
+}
+
+TimestepGovernorSettings EngineWorker::getTimestepGovernorSettings() const
+{
+    return _timestepGovernor.getSettings();
+}
+
+void EngineWorker::setTimestepGovernorSettings(TimestepGovernorSettings const& settings)
+{
+    _timestepGovernor.setSettings(settings);
+}
+
+TimestepGovernorMetrics EngineWorker::getTimestepGovernorMetrics() const
+{
+    return _timestepGovernor.getMetrics();
+}
+
+PerformanceCounters EngineWorker::getPerformanceCounters() const
+{
+    return _simulationCudaFacade->getPerformanceCounters();
 }
 
 float EngineWorker::getTps() const
 {
-    return _tps.load();
+    return _timestepGovernor.getMetrics().tps;
 }
 
 uint64_t EngineWorker::getCurrentTimestep() const
@@ -382,8 +476,7 @@ void EngineWorker::setSimulationParameters(SimulationParameters const& parameter
 
 void EngineWorker::setGpuSettings_async(GpuSettings const& gpuSettings)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _updateGpuSettingsJob = gpuSettings;
+    pushCommand(SetGpuSettingsCommand{gpuSettings});
 }
 
 void EngineWorker::applyForce_async(
@@ -392,8 +485,22 @@ void EngineWorker::applyForce_async(
     RealVector2D const& force,
     float radius)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _applyForceJobs.emplace_back(ApplyForceJob{start, end, force, radius});
+    pushCommand(ApplyForceCommand{start, end, force, radius});
+}
+
+std::future<void> EngineWorker::executeCommands_async(std::vector<EngineCommand> const& commands)
+{
+    auto completion = std::make_shared<std::promise<void>>();
+    auto result = completion->get_future();
+    if (commands.empty()) {
+        completion->set_value();
+        return result;
+    }
+    for (size_t i = 0; i + 1 < commands.size(); ++i) {
+        pushCommand(commands[i]);
+    }
+    pushCommand(commands.back(), completion);
+    return result;
 }
 
 void EngineWorker::switchSelection(RealVector2D const& pos, float radius)
@@ -416,14 +523,12 @@ SelectionShallowData EngineWorker::getSelectionShallowData(RealVector2D const& r
 
 void EngineWorker::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->setSelection(AreaSelectionData{{startPos.x, startPos.y}, {endPos.x, endPos.y}});
+    pushCommand(SetSelectionCommand{startPos, endPos});
 }
 
 void EngineWorker::removeSelection()
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->removeSelection();
+    pushCommand(RemoveSelectionCommand());
 }
 
 void EngineWorker::updateSelection()
@@ -434,14 +539,12 @@ void EngineWorker::updateSelection()
 
 void EngineWorker::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->shallowUpdateSelectedObjects(updateData);
+    pushCommand(ShallowUpdateSelectedObjectsCommand{updateData});
 }
 
 void EngineWorker::colorSelectedObjects(unsigned char color, bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->colorSelectedObjects(color, includeClusters);
+    pushCommand(ColorSelectedObjectsCommand{color, includeClusters});
 }
 
 void EngineWorker::reconnectSelectedObjects()
@@ -459,23 +562,26 @@ void EngineWorker::setDetached(bool value)
 void EngineWorker::runThreadLoop()
 {
     try {
-        std::mutex mutexForLoop;
-        std::unique_lock<std::mutex> lockForLoop(mutexForLoop);
-
         while (!_isShutdown.load()) {
 
-            if (!_syncSimulationWithRendering && _accessState == 0) {
-                if (_isSimulationRunning.load()) {
-                    _simulationCudaFacade->calcTimestep(1, false);
+            if (!_syncSimulationWithRendering && _accessState == 0 && _isSimulationRunning.load()) {
+                calcTimestepAndRegister(false);
+                auto pause = _timestepGovernor.calcPause(std::chrono::steady_clock::now());
+                if (pause.count() > 0) {
+                    waitAndAllowAccess(pause);
                 }
-                measureTPS();
-                slowdownTPS();
             }
             
-            processJobs();
+            processCommands();
 
             if (_accessState == 1) {
-                _accessState = 2;
+                allowAccessAndWaitForRelease();
+                continue;
+            }
+
+            //no busy waiting if there are no timesteps to calculate
+            if (!_isSimulationRunning.load() || _syncSimulationWithRendering) {
+                waitForNotification();
             }
         }
     } catch (std::exception const& e) {
@@ -487,12 +593,14 @@ void EngineWorker::runThreadLoop()
 void EngineWorker::runSimulation()
 {
     _isSimulationRunning.store(true);
+    notifyWorker();
 }
 
 void EngineWorker::pauseSimulation()
 {
     EngineWorkerGuard access(this);
     _isSimulationRunning.store(false);
+    _timestepGovernor.reset();
 }
 
 bool EngineWorker::isSimulationRunning() const
@@ -516,119 +624,281 @@ void EngineWorker::resetTimeIntervalStatistics()
     _simulationCudaFacade->resetTimeIntervalStatistics();
 }
 
-void EngineWorker::processJobs()
+void EngineWorker::pushCommand(std::variant<EngineCommand, UploadJob> const& command, std::shared_ptr<std::promise<void>> const& completion)
+{
+    ++_numPendingCommands;
+    if (std::holds_alternative<UploadJob>(command)) {
+        ++_numPendingUploadJobs;
+    }
+    _commandQueue.push(QueuedCommand{command, completion});
+    notifyWorker();
+}
+
+void EngineWorker::processCommands()
+{
+    auto commands = _commandQueue.popAll();
+    if (commands.empty()) {
+        return;
+    }
+
+    auto finishCommands = [&](size_t startIndex, size_t endIndex) {
+        for (auto index = startIndex; index < endIndex; ++index) {
+            if (commands[index].completion) {
+                commands[index].completion->set_value();
+            }
+            if (std::holds_alternative<UploadJob>(commands[index].command)) {
+                --_numPendingUploadJobs;
+            }
+        }
+        {
+            std::unique_lock<std::mutex> uniqueLock(_mutexForCommands);
+            _numPendingCommands -= toInt(endIndex - startIndex);
+        }
+        _commandsProcessedCondition.notify_all();
+    };
+    auto getChange = [&](size_t index) -> EngineCommand const* {
+        if (auto command = std::get_if<EngineCommand>(&commands[index].command)) {
+            if (std::holds_alternative<ChangeCellCommand>(*command) || std::holds_alternative<ChangeParticleCommand>(*command)) {
+                return command;
+            }
+        }
+        return nullptr;
+    };
+
+    size_t index = 0;
+    try {
+        while (index < commands.size()) {
+            if (getChange(index)) {
+
+                //consecutive changes are transferred together, only the last change of an object is taken
+                std::vector<CellDescription> cells;
+                std::vector<ParticleDescription> particles;
+                std::unordered_map<uint64_t, size_t> cellIndexById;
+                std::unordered_map<uint64_t, size_t> particleIndexById;
+                auto endIndex = index;
+                for (; endIndex < commands.size(); ++endIndex) {
+                    auto change = getChange(endIndex);
+                    if (!change) {
+                        break;
+                    }
+                    if (auto changeCell = std::get_if<ChangeCellCommand>(change)) {
+                        auto [it, inserted] = cellIndexById.try_emplace(changeCell->cell.id, cells.size());
+                        if (inserted) {
+                            cells.emplace_back(changeCell->cell);
+                        } else {
+                            cells.at(it->second) = changeCell->cell;
+                        }
+                    }
+                    if (auto changeParticle = std::get_if<ChangeParticleCommand>(change)) {
+                        auto [it, inserted] = particleIndexById.try_emplace(changeParticle->particle.id, particles.size());
+                        if (inserted) {
+                            particles.emplace_back(changeParticle->particle);
+                        } else {
+                            particles.at(it->second) = changeParticle->particle;
+                        }
+                    }
+                }
+                executeChanges(std::move(cells), std::move(particles));
+                finishCommands(index, endIndex);
+                index = endIndex;
+            } else {
+                if (auto command = std::get_if<EngineCommand>(&commands[index].command)) {
+                    executeCommand(*command);
+                } else {
+                    executeUploadJob(std::get<UploadJob>(commands[index].command));
+                }
+                finishCommands(index, index + 1);
+                ++index;
+            }
+        }
+    } catch (...) {
+        for (; index < commands.size(); ++index) {
+            if (commands[index].completion) {
+                commands[index].completion->set_exception(std::current_exception());
+            }
+        }
+        throw;
+    }
+}
+
+void EngineWorker::executeCommand(EngineCommand const& command)
+{
+    if (auto applyForceCommand = std::get_if<ApplyForceCommand>(&command)) {
+        _simulationCudaFacade->applyForce(
+            {{applyForceCommand->start.x, applyForceCommand->start.y},
+             {applyForceCommand->end.x, applyForceCommand->end.y},
+             {applyForceCommand->force.x, applyForceCommand->force.y},
+             applyForceCommand->radius,
+             false});
+    }
+    if (auto setGpuSettingsCommand = std::get_if<SetGpuSettingsCommand>(&command)) {
+        _simulationCudaFacade->setGpuConstants(setGpuSettingsCommand->gpuSettings);
+    }
+    if (auto setSelectionCommand = std::get_if<SetSelectionCommand>(&command)) {
+        _simulationCudaFacade->setSelection(AreaSelectionData{
+            {setSelectionCommand->startPos.x, setSelectionCommand->startPos.y}, {setSelectionCommand->endPos.x, setSelectionCommand->endPos.y}});
+    }
+    if (std::holds_alternative<RemoveSelectionCommand>(command)) {
+        _simulationCudaFacade->removeSelection();
+    }
+    if (auto shallowUpdateCommand = std::get_if<ShallowUpdateSelectedObjectsCommand>(&command)) {
+        _simulationCudaFacade->shallowUpdateSelectedObjects(shallowUpdateCommand->updateData);
+    }
+    if (auto colorCommand = std::get_if<ColorSelectedObjectsCommand>(&command)) {
+        _simulationCudaFacade->colorSelectedObjects(colorCommand->color, colorCommand->includeClusters);
+    }
+}
+
+void EngineWorker::executeUploadJob(UploadJob const& job)
+{
+    //the transfer buffer of the job is not touched by the calling thread until the job is finished
+    _simulationCudaFacade->resizeArraysIfNecessary(job.arraySizes);
+    _simulationCudaFacade->addSimulationData(_dataTOCache->getFilledDataTO(job.bufferIndex));
+}
+
+void EngineWorker::executeChanges(std::vector<CellDescription> cells, std::vector<ParticleDescription> particles)
 {
-    std::unique_lock<std::mutex> asyncJobsLock(_mutexForAsyncJobs);
-    if (_updateGpuSettingsJob) {
-        _simulationCudaFacade->setGpuConstants(*_updateGpuSettingsJob);
-        _updateGpuSettingsJob = std::nullopt;
+    //the change kernels look up the objects by binary search over their ids
+    std::ranges::sort(cells, [](auto const& cell1, auto const& cell2) { return cell1.id < cell2.id; });
+    std::ranges::sort(particles, [](auto const& particle1, auto const& particle2) { return particle1.id < particle2.id; });
+
+    DescriptionConverter converter(_settings.simulationParameters);
+    auto arraySizes = converter.getArraySizes(DataDescription().addCells(cells).addParticles(particles));
+    auto dataTO = _changeDataTOCache->getDataTO(arraySizes);
+    for (auto const& cell : cells) {
+        converter.convertDescriptionToTO(dataTO, cell);
+    }
+    for (auto const& particle : particles) {
+        converter.convertDescriptionToTO(dataTO, particle);
     }
-    if (!_applyForceJobs.empty()) {
-        for (auto const& applyForceJob : _applyForceJobs) {
-            _simulationCudaFacade->applyForce(
-                {{applyForceJob.start.x, applyForceJob.start.y},
-                 {applyForceJob.end.x, applyForceJob.end.y},
-                 {applyForceJob.force.x, applyForceJob.force.y},
-                 applyForceJob.radius,
-                 false});
+    _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+}
+
+bool EngineWorker::waitForCommands(
+    std::atomic<int> const& numPendingCommands,
+    int maxNumPendingCommands,
+    std::optional<std::chrono::milliseconds> const& maxDuration)
+{
+    auto startTimepoint = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> uniqueLock(_mutexForCommands);
+    while (numPendingCommands.load() > maxNumPendingCommands) {
+        if (maxDuration && std::chrono::steady_clock::now() - startTimepoint > *maxDuration) {
+            return false;
         }
-        _applyForceJobs.clear();
+        {
+            std::unique_lock<std::mutex> exceptionLock(_exceptionData.mutex);
+            if (_exceptionData.errorMessage) {
+                throw std::runtime_error("GPU worker thread is in an invalid state.");
+            }
+        }
+        _commandsProcessedCondition.wait_for(uniqueLock, std::chrono::milliseconds(10));
     }
+    return true;
 }
 
 void EngineWorker::syncSimulationWithRenderingIfDesired()
 {
     if (_syncSimulationWithRendering && _isSimulationRunning) {
-        for (int i = 0; i < _syncSimulationWithRenderingRatio; ++i) {
-            calcTimesteps(1);
-            measureTPS();
-            slowdownTPS();
+        auto numTimesteps = _timestepGovernor.calcTimestepsForFrame(std::chrono::steady_clock::now(), _syncSimulationWithRenderingRatio);
+        if (numTimesteps == 0) {
+            return;
+        }
+        EngineWorkerGuard access(this);
+        for (int i = 0; i < numTimesteps; ++i) {
+            calcTimestepAndRegister(true);
         }
     }
 }
 
-void EngineWorker::waitAndAllowAccess(std::chrono::microseconds const& duration)
+void EngineWorker::notifyWorker()
 {
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint) < duration) {
-        if (_accessState == 1) {
-            _accessState = 2;
-        }
+    {
+        std::unique_lock<std::mutex> uniqueLock(_mutexForWorkerLoop);
+        _workerNotified = true;
     }
+    _workerLoopCondition.notify_all();
 }
 
-void EngineWorker::measureTPS()
+bool EngineWorker::waitForNotification(std::optional<std::chrono::steady_clock::time_point> const& until)
 {
-    if (_isSimulationRunning.load()) {
-        auto timepoint = std::chrono::steady_clock::now();
-        if (!_measureTimepoint) {
-            _measureTimepoint = timepoint;
-        } else {
-            int duration = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(timepoint - *_measureTimepoint).count());
-            if (duration > 199) {
-                _measureTimepoint = timepoint;
-                if (duration < 350) {
-                    _tps.store(toFloat(_timestepsSinceMeasurement) * 5 * 200 / duration);
-                } else {
-                    _tps.store(1000.0f / duration);
-                }
-                _timestepsSinceMeasurement = 0;
-            }
+    std::unique_lock<std::mutex> uniqueLock(_mutexForWorkerLoop);
+    if (until) {
+        if (!_workerLoopCondition.wait_until(uniqueLock, *until, [this] { return _workerNotified; })) {
+            return false;
         }
-        ++_timestepsSinceMeasurement;
     } else {
-        _tps.store(0);
+        _workerLoopCondition.wait(uniqueLock, [this] { return _workerNotified; });
     }
+    _workerNotified = false;
+    return true;
 }
 
-void EngineWorker::slowdownTPS()
+void EngineWorker::allowAccessAndWaitForRelease()
 {
-    if (_slowDownTimepoint) {
-        auto timestepDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - *_slowDownTimepoint);
-        if (_slowDownOvershot) {
-            timestepDuration += *_slowDownOvershot;
+    {
+        std::unique_lock<std::mutex> uniqueLock(_mutexForAccess);
+        _accessState = 2;
+    }
+    _accessGrantedCondition.notify_all();
+
+    //EngineWorkerGuard notifies on release
+    while (_accessState == 2 && !_isShutdown.load()) {
+        waitForNotification();
+    }
+}
+
+void EngineWorker::waitAndAllowAccess(std::chrono::microseconds const& duration)
+{
+    auto endTimepoint = std::chrono::steady_clock::now() + duration;
+    while (!_isShutdown.load()) {
+
+        //queued commands are executed during the pause since guards wait for them before requesting access
+        processCommands();
+        if (_accessState == 1) {
+            allowAccessAndWaitForRelease();
         }
-        auto tpsRestriction = _tpsRestriction.load();
-        if (_isSimulationRunning.load() && tpsRestriction > 0) {
-            auto desiredDuration = std::chrono::microseconds(1000000 / tpsRestriction);
-            if (desiredDuration > timestepDuration) {
-                waitAndAllowAccess(desiredDuration - timestepDuration);
-            } else {
-            }
-            _slowDownOvershot = std::min(std::max(timestepDuration - desiredDuration, std::chrono::microseconds(0)), desiredDuration);
+        if (!waitForNotification(endTimepoint)) {
+            break;
         }
     }
-    _slowDownTimepoint = std::chrono::steady_clock::now();
+}
+
+void EngineWorker::calcTimestepAndRegister(bool forceUpdateStatistics)
+{
+    auto startTimepoint = std::chrono::steady_clock::now();
+    _simulationCudaFacade->calcTimestep(1, forceUpdateStatistics);
+    _timestepGovernor.registerTimestep(startTimepoint, std::chrono::steady_clock::now());
 }
 
 EngineWorkerGuard::EngineWorkerGuard(EngineWorker* worker, std::optional<std::chrono::milliseconds> const& maxDuration)
     : _worker(worker)
 {
+    //pending commands have to be finished first in order to preserve the order of the operations
+    //(not possible for nested access since the worker thread does not process commands while access is granted)
+    if (worker->_accessState != 2 && !worker->waitForCommands(worker->_numPendingCommands, 0, maxDuration)) {
+        _isTimeout = true;
+        return;
+    }
     checkForException(worker->_exceptionData);
 
     worker->_accessState = 1;
-
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (worker->_accessState == 1) {
-        auto timePassed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
-        if (maxDuration) {
-            if (timePassed > *maxDuration) {
-                _isTimeout = true;
-                break;
-            }
-        } else {
-            if (timePassed > std::chrono::seconds(7)) {
-                _isTimeout = true;
-                throw std::runtime_error("GPU worker thread is not reachable.");
-            }
+    worker->notifyWorker();
+
+    std::unique_lock<std::mutex> uniqueLock(worker->_mutexForAccess);
+    auto accessGranted = worker->_accessGrantedCondition.wait_for(
+        uniqueLock, maxDuration.value_or(std::chrono::seconds(7)), [worker] { return worker->_accessState != 1; });
+    if (!accessGranted) {
+        _isTimeout = true;
+        if (!maxDuration) {
+            throw std::runtime_error("GPU worker thread is not reachable.");
         }
     }
-
 }
 
 EngineWorkerGuard::~EngineWorkerGuard()
 {
     _worker->_accessState = 0;
+    _worker->notifyWorker();
 }
 
 bool EngineWorkerGuard::isTimeout() const
@@ -3,6 +3,8 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <future>
+#include <variant>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -10,21 +12,27 @@
 #include <GL/gl.h>
 
 #include "Base/Definitions.h"
+#include "Base/MpscQueue.h"
 
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/ArraySizes.h"
+#include "EngineInterface/EngineCommands.h"
 #include "EngineInterface/SimulationParameters.h"
 #include "EngineInterface/GpuSettings.h"
 #include "EngineInterface/RawStatisticsData.h"
 #include "EngineInterface/OverlayDescriptions.h"
 #include "EngineInterface/Settings.h"
 #include "EngineInterface/SelectionShallowData.h"
+#include "EngineInterface/SimulationSnapshot.h"
 #include "EngineInterface/ShallowUpdateSelectionData.h"
 #include "EngineInterface/MutationType.h"
+#include "EngineInterface/PerformanceCounters.h"
 #include "EngineInterface/StatisticsHistory.h"
 
 #include "EngineGpuKernels/Definitions.h"
 
 #include "Definitions.h"
+#include "TimestepGovernor.h"
 
 struct ExceptionData
 {
@@ -65,6 +73,13 @@ public:
     void addAndSelectSimulationData(DataDescription const& dataToUpdate);
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate);
     void setSimulationData(DataDescription const& dataToUpdate);
+    void setSimulationData(DataTO const& dataTO);
+    void reserveSimulationData(ArraySizes const& arraySizes);
+    void addClusteredSimulationData(ClusteredDataDescription const& dataToAdd);
+    void saveSimulationDataImage(std::string const& filename, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    void loadSimulationDataImage(std::string const& filename);
+    SimulationSnapshot getSnapshot(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    void setSnapshot(SimulationSnapshot const& snapshot);
     void removeSelectedObjects(bool includeClusters);
     void relaxSelectedObjects(bool includeClusters);
     void uniformVelocitiesForSelectedObjects(bool includeClusters);
@@ -83,6 +98,11 @@ public:
     int getTpsRestriction() const;
     void setTpsRestriction(int value);
 
+    TimestepGovernorSettings getTimestepGovernorSettings() const;
+    void setTimestepGovernorSettings(TimestepGovernorSettings const& settings);
+    TimestepGovernorMetrics getTimestepGovernorMetrics() const;
+    PerformanceCounters getPerformanceCounters() const;
+
     float getTps() const;
     uint64_t getCurrentTimestep() const;
     void setCurrentTimestep(uint64_t value);
@@ -92,6 +112,7 @@ public:
     void setGpuSettings_async(GpuSettings const& gpuSettings);
 
     void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius);
+    std::future<void> executeCommands_async(std::vector<EngineCommand> const& commands);
 
     void switchSelection(RealVector2D const& pos, float radius);
     void swapSelection(RealVector2D const& pos, float radius);
@@ -113,15 +134,37 @@ public:
     void testOnly_mutate(uint64_t cellId, MutationType mutationType);
 
 private:
+    //upload jobs contain batches which are converted on the calling thread, each job occupies one transfer buffer
+    struct UploadJob
+    {
+        ArraySizes arraySizes;
+        int bufferIndex;
+    };
+    struct QueuedCommand
+    {
+        std::variant<EngineCommand, UploadJob> command;
+        std::shared_ptr<std::promise<void>> completion;
+    };
+
     DataTO provideTO(); 
     void resetTimeIntervalStatistics();
     void updateStatistics(bool afterMinDuration = false);
-    void processJobs();
+    void pushCommand(std::variant<EngineCommand, UploadJob> const& command, std::shared_ptr<std::promise<void>> const& completion = nullptr);
+    void processCommands();
+    void executeCommand(EngineCommand const& command);
+    void executeUploadJob(UploadJob const& job);
+    void executeChanges(std::vector<CellDescription> cells, std::vector<ParticleDescription> particles);
+    bool waitForCommands(
+        std::atomic<int> const& numPendingCommands,
+        int maxNumPendingCommands,
+        std::optional<std::chrono::milliseconds> const& maxDuration = std::nullopt);
 
     void syncSimulationWithRenderingIfDesired();
+    void notifyWorker();
+    bool waitForNotification(std::optional<std::chrono::steady_clock::time_point> const& until = std::nullopt);
+    void allowAccessAndWaitForRelease();
     void waitAndAllowAccess(std::chrono::microseconds const& duration);
-    void measureTPS();
-    void slowdownTPS();
+    void calcTimestepAndRegister(bool forceUpdateStatistics);
 
     CudaSimulationFacade _simulationCudaFacade;
 
@@ -136,31 +179,30 @@ private:
     std::atomic<bool> _isShutdown{false};
     ExceptionData _exceptionData;
 
-    //async jobs
-    mutable std::mutex _mutexForAsyncJobs;
-    std::optional<GpuSettings> _updateGpuSettingsJob;
+    //the worker thread sleeps while there is nothing to do and is woken up by notifyWorker
+    std::mutex _mutexForWorkerLoop;
+    std::condition_variable _workerLoopCondition;
+    bool _workerNotified = false;
+    std::mutex _mutexForAccess;
+    std::condition_variable _accessGrantedCondition;
+
     std::optional<GLuint> _imageResource;
 
-    struct ApplyForceJob
-    {
-        RealVector2D start;
-        RealVector2D end;
-        RealVector2D force;
-        float radius;
-    };
-    std::vector<ApplyForceJob> _applyForceJobs;
-
-    //time step measurements
-    std::atomic<int> _tpsRestriction{0};  //0 = no restriction
-    std::atomic<float> _tps;
-    int _timestepsSinceMeasurement = 0;
-    std::optional<std::chrono::steady_clock::time_point> _measureTimepoint;
-    std::optional<std::chrono::steady_clock::time_point> _slowDownTimepoint;
-    std::optional<std::chrono::microseconds> _slowDownOvershot;
+    //commands can be queued from any thread and are executed by the worker thread
+    MpscQueue<QueuedCommand> _commandQueue;
+    std::atomic<int> _numPendingCommands{0};
+    std::atomic<int> _numPendingUploadJobs{0};
+    std::mutex _mutexForCommands;
+    std::condition_variable _commandsProcessedCondition;
+    int _nextUploadBufferIndex = 0;
+
+    //time step measurements and rate control
+    TimestepGovernor _timestepGovernor;
   
     //internals
     void* _cudaResource;
     AccessDataTOCache _dataTOCache;
+    AccessDataTOCache _changeDataTOCache;  //separate buffer since the upload buffers may already be filled with queued batches
 };
 
 class EngineWorkerGuard
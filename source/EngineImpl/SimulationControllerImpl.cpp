@@ -124,6 +124,41 @@ void _SimulationControllerImpl::setSimulationData(DataDescription const& dataToU
     _selectionNeedsUpdate = true;
 }
 
+void _SimulationControllerImpl::reserveSimulationData(uint64_t numCells, uint64_t numParticles, uint64_t auxiliaryDataSize)
+{
+    _worker.reserveSimulationData({numCells, numParticles, auxiliaryDataSize});
+}
+
+void _SimulationControllerImpl::addClusteredSimulationData(ClusteredDataDescription const& dataToAdd)
+{
+    _worker.addClusteredSimulationData(dataToAdd);
+    _selectionNeedsUpdate = true;
+}
+
+void _SimulationControllerImpl::saveSimulationDataImage(std::string const& filename)
+{
+    auto size = getWorldSize();
+    _worker.saveSimulationDataImage(filename, {-10, -10}, {size.x + 10, size.y + 10});
+}
+
+void _SimulationControllerImpl::loadSimulationDataImage(std::string const& filename)
+{
+    _worker.loadSimulationDataImage(filename);
+    _selectionNeedsUpdate = true;
+}
+
+SimulationSnapshot _SimulationControllerImpl::getSnapshot()
+{
+    auto size = getWorldSize();
+    return _worker.getSnapshot({-10, -10}, {size.x + 10, size.y + 10});
+}
+
+void _SimulationControllerImpl::setSnapshot(SimulationSnapshot const& snapshot)
+{
+    _worker.setSnapshot(snapshot);
+    _selectionNeedsUpdate = true;
+}
+
 void _SimulationControllerImpl::removeSelectedObjects(bool includeClusters)
 {
     _worker.removeSelectedObjects(includeClusters);
@@ -292,6 +327,11 @@ void _SimulationControllerImpl::applyForce_async(
     _worker.applyForce_async(start, end, force, radius);
 }
 
+std::future<void> _SimulationControllerImpl::executeCommands_async(std::vector<EngineCommand> const& commands)
+{
+    return _worker.executeCommands_async(commands);
+}
+
 void _SimulationControllerImpl::switchSelection(RealVector2D const& pos, float radius)
 {
     _worker.switchSelection(pos, radius);
@@ -368,6 +408,26 @@ void _SimulationControllerImpl::setTpsRestriction(std::optional<int> const& valu
     _worker.setTpsRestriction(value ? *value : 0);
 }
 
+TimestepGovernorSettings _SimulationControllerImpl::getTimestepGovernorSettings() const
+{
+    return _worker.getTimestepGovernorSettings();
+}
+
+void _SimulationControllerImpl::setTimestepGovernorSettings(TimestepGovernorSettings const& settings)
+{
+    _worker.setTimestepGovernorSettings(settings);
+}
+
+TimestepGovernorMetrics _SimulationControllerImpl::getTimestepGovernorMetrics() const
+{
+    return _worker.getTimestepGovernorMetrics();
+}
+
+PerformanceCounters _SimulationControllerImpl::getPerformanceCounters() const
+{
+    return _worker.getPerformanceCounters();
+}
+
 float _SimulationControllerImpl::getTps() const
 {
     return _worker.getTps();
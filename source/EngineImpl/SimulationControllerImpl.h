@@ -54,6 +54,12 @@ public:
     void addAndSelectSimulationData(DataDescription const& dataToAdd) override;
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) override;
     void setSimulationData(DataDescription const& dataToUpdate) override;
+    void reserveSimulationData(uint64_t numCells, uint64_t numParticles, uint64_t auxiliaryDataSize) override;
+    void addClusteredSimulationData(ClusteredDataDescription const& dataToAdd) override;
+    void saveSimulationDataImage(std::string const& filename) override;
+    void loadSimulationDataImage(std::string const& filename) override;
+    SimulationSnapshot getSnapshot() override;
+    void setSnapshot(SimulationSnapshot const& snapshot) override;
     void removeSelectedObjects(bool includeClusters) override;
     void relaxSelectedObjects(bool includeClusters) override;
     void uniformVelocitiesForSelectedObjects(bool includeClusters) override;
@@ -91,6 +97,7 @@ public:
     void setGpuSettings_async(GpuSettings const& gpuSettings) override;
 
     void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius) override;
+    std::future<void> executeCommands_async(std::vector<EngineCommand> const& commands) override;
 
     void switchSelection(RealVector2D const& pos, float radius) override;
     void swapSelection(RealVector2D const& pos, float radius) override;
@@ -109,6 +116,11 @@ public:
     std::optional<int> getTpsRestriction() const override;
     void setTpsRestriction(std::optional<int> const& value) override;
 
+    TimestepGovernorSettings getTimestepGovernorSettings() const override;
+    void setTimestepGovernorSettings(TimestepGovernorSettings const& settings) override;
+    TimestepGovernorMetrics getTimestepGovernorMetrics() const override;
+    PerformanceCounters getPerformanceCounters() const override;
+
     float getTps() const override;
 
     //for tests
@@ -0,0 +1,163 @@
+#include "TimestepGovernor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    auto constexpr DurationSmoothingFactor = 0.1;
+    auto constexpr RateSmoothingTime = 500000.0;  //in microseconds
+    auto constexpr MaxTimestepsPerFrame = 1000;
+    auto constexpr MaxTpsCreditTime = 0.1;  //in seconds, limits the catch-up after slow frames
+
+    double toMicroseconds(TimestepGovernor::Clock::duration const& duration)
+    {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    }
+
+    double smooth(std::optional<double> const& estimate, double value, double factor)
+    {
+        return estimate ? *estimate + (value - *estimate) * factor : value;
+    }
+}
+
+TimestepGovernorSettings TimestepGovernor::getSettings() const
+{
+    std::lock_guard lock(_mutex);
+    return _settings;
+}
+
+void TimestepGovernor::setSettings(TimestepGovernorSettings const& settings)
+{
+    std::lock_guard lock(_mutex);
+    if (settings.maxTps != _settings.maxTps) {
+        _nextTimestepStart.reset();
+        _tpsCredit = 0;
+    }
+    _settings = settings;
+}
+
+TimestepGovernorMetrics TimestepGovernor::getMetrics() const
+{
+    std::lock_guard lock(_mutex);
+    return _metrics;
+}
+
+void TimestepGovernor::reset()
+{
+    std::lock_guard lock(_mutex);
+    resetIntern();
+}
+
+void TimestepGovernor::registerTimestep(Clock::time_point const& startTimepoint, Clock::time_point const& endTimepoint)
+{
+    std::lock_guard lock(_mutex);
+    auto duration = toMicroseconds(endTimepoint - startTimepoint);
+    _timestepDuration = smooth(_timestepDuration, duration, DurationSmoothingFactor);
+    _timestepDurationsInFrame += duration;
+
+    //rates are obtained from exponentially decaying sums over time such that they are not biased by varying intervals
+    if (_lastTimestepStart) {
+        auto interval = std::max(1.0, toMicroseconds(startTimepoint - *_lastTimestepStart));
+        auto decay = std::exp(-interval / RateSmoothingTime);
+        _decayingNumTimesteps = _decayingNumTimesteps * decay + 1.0;
+        _decayingTime = _decayingTime * decay + interval;
+        _decayingBusyTime = _decayingBusyTime * decay + std::min(duration, interval);
+        _metrics.tps = static_cast<float>(_decayingNumTimesteps * 1000000.0 / _decayingTime);
+        _metrics.coreUsage = static_cast<float>(_decayingBusyTime / _decayingTime);
+    }
+    _lastTimestepStart = startTimepoint;
+    _metrics.timestepDuration = static_cast<float>(*_timestepDuration / 1000);
+}
+
+std::chrono::microseconds TimestepGovernor::calcPause(Clock::time_point const& timepoint)
+{
+    std::lock_guard lock(_mutex);
+    double pause = 0;
+    _metrics.limit = GovernorLimit_None;
+
+    if (_settings.maxCoreUsage && *_settings.maxCoreUsage > 0 && *_settings.maxCoreUsage < 1.0f && _timestepDuration) {
+        auto corePause = *_timestepDuration * (1.0 / *_settings.maxCoreUsage - 1.0);
+        if (corePause > pause) {
+            pause = corePause;
+            _metrics.limit = GovernorLimit_CoreUsage;
+        }
+    }
+
+    if (_settings.maxTps && *_settings.maxTps > 0) {
+
+        //the time steps are scheduled on a fixed grid such that overshooting pauses are compensated
+        auto interval = std::chrono::microseconds(1000000 / *_settings.maxTps);
+        _nextTimestepStart = (_nextTimestepStart ? *_nextTimestepStart : _lastTimestepStart.value_or(timepoint)) + interval;
+        if (*_nextTimestepStart + interval < timepoint) {
+            _nextTimestepStart = timepoint;  //no catch-up after a long interruption
+        }
+        auto tpsPause = toMicroseconds(*_nextTimestepStart - timepoint);
+        if (tpsPause > pause) {
+            pause = tpsPause;
+            _metrics.limit = GovernorLimit_Tps;
+        }
+        _nextTimestepStart = std::max(*_nextTimestepStart, timepoint + std::chrono::microseconds(static_cast<int64_t>(pause)));
+    }
+
+    _metrics.pauseDuration = static_cast<float>(pause / 1000);
+    return std::chrono::microseconds(static_cast<int64_t>(pause));
+}
+
+int TimestepGovernor::calcTimestepsForFrame(Clock::time_point const& frameTimepoint, int defaultTimestepsPerFrame)
+{
+    std::lock_guard lock(_mutex);
+    auto isFirstFrame = !_lastFrameTimepoint.has_value();
+    double lastFrameDuration = 0;
+    if (!isFirstFrame) {
+        lastFrameDuration = toMicroseconds(frameTimepoint - *_lastFrameTimepoint);
+        _frameDuration = smooth(_frameDuration, std::max(0.0, lastFrameDuration - _timestepDurationsInFrame), DurationSmoothingFactor);
+        _metrics.frameDuration = static_cast<float>(*_frameDuration / 1000);
+    }
+    _lastFrameTimepoint = frameTimepoint;
+    _timestepDurationsInFrame = 0;
+
+    auto result = defaultTimestepsPerFrame;
+    _metrics.limit = GovernorLimit_None;
+
+    if (_settings.targetFps && *_settings.targetFps > 0 && _timestepDuration && _frameDuration) {
+        auto budget = 1000000.0 / *_settings.targetFps - *_frameDuration;
+        result = std::clamp(static_cast<int>(budget / std::max(1.0, *_timestepDuration)), 1, MaxTimestepsPerFrame);
+        _metrics.limit = GovernorLimit_FrameBudget;
+    }
+
+    //the allowed time steps are accumulated over the frames such that TPS below the frame rate are possible
+    if (_settings.maxTps && *_settings.maxTps > 0) {
+        auto maxTps = static_cast<double>(*_settings.maxTps);
+        _tpsCredit = std::min(_tpsCredit + maxTps * lastFrameDuration / 1000000.0, std::max(1.0, maxTps * MaxTpsCreditTime));
+        if (isFirstFrame) {
+            _tpsCredit = 1.0;
+        }
+        auto maxTimesteps = static_cast<int>(_tpsCredit);
+        if (maxTimesteps < result) {
+            result = maxTimesteps;
+            _metrics.limit = GovernorLimit_Tps;
+        }
+        _tpsCredit -= result;
+    }
+
+    _metrics.timestepsPerFrame = result;
+    return result;
+}
+
+void TimestepGovernor::resetIntern()
+{
+    _decayingNumTimesteps = 0;
+    _decayingTime = 0;
+    _decayingBusyTime = 0;
+    _metrics.tps = 0;
+    _metrics.coreUsage = 0;
+    _metrics.pauseDuration = 0;
+    _metrics.timestepsPerFrame = 0;
+    _metrics.limit = GovernorLimit_None;
+    _lastTimestepStart.reset();
+    _nextTimestepStart.reset();
+    _lastFrameTimepoint.reset();
+    _timestepDurationsInFrame = 0;
+    _tpsCredit = 0;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+
+#include "EngineInterface/TimestepGovernorSettings.h"
+
+/**
+ * Decides how fast time steps are calculated based on a smoothed estimate of the time step duration.
+ * Free running simulation: the worker thread pauses between time steps to meet the TPS and core usage constraints.
+ * Sync with rendering: the number of time steps per frame is adapted to the frame budget given by the target FPS.
+ * The time points are passed by the caller such that the decisions can be tested without a clock.
+ */
+class TimestepGovernor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TimestepGovernorSettings getSettings() const;
+    void setSettings(TimestepGovernorSettings const& settings);
+
+    TimestepGovernorMetrics getMetrics() const;
+
+    //should be called when the simulation is paused
+    void reset();
+
+    void registerTimestep(Clock::time_point const& startTimepoint, Clock::time_point const& endTimepoint);
+
+    //free running simulation: pause before the next time step
+    std::chrono::microseconds calcPause(Clock::time_point const& timepoint);
+
+    //sync with rendering: should be called once per frame, defaultTimestepsPerFrame is used if there is no target FPS
+    int calcTimestepsForFrame(Clock::time_point const& frameTimepoint, int defaultTimestepsPerFrame);
+
+private:
+    void resetIntern();
+
+    mutable std::mutex _mutex;
+    TimestepGovernorSettings _settings;
+    TimestepGovernorMetrics _metrics;
+
+    //estimates, durations in microseconds
+    std::optional<double> _timestepDuration;
+    std::optional<double> _frameDuration;
+    double _decayingNumTimesteps = 0;
+    double _decayingTime = 0;
+    double _decayingBusyTime = 0;
+
+    std::optional<Clock::time_point> _lastTimestepStart;
+    std::optional<Clock::time_point> _nextTimestepStart;
+    std::optional<Clock::time_point> _lastFrameTimepoint;
+    double _timestepDurationsInFrame = 0;
+    double _tpsCredit = 0;
+};
@@ -1,11 +1,31 @@
 #include "AuxiliaryDataParserService.h"
 
+#include <array>
+
 #include "GeneralSettings.h"
 #include "Settings.h"
 #include "LegacySimulationParametersService.h"
 
 namespace
 {
+    //suffixes for the color vector and color matrix elements, e.g. "[2]" and "[2, 5]"
+    auto const ColorVectorSuffixes = [] {
+        std::array<std::string, MAX_COLORS> result;
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            result[i] = "[" + std::to_string(i) + "]";
+        }
+        return result;
+    }();
+    auto const ColorMatrixSuffixes = [] {
+        std::array<std::array<std::string, MAX_COLORS>, MAX_COLORS> result;
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            for (int j = 0; j < MAX_COLORS; ++j) {
+                result[i][j] = "[" + std::to_string(i) + ", " + std::to_string(j) + "]";
+            }
+        }
+        return result;
+    }();
+
     //return true if value does not exist in tree
     template <typename T>
     bool encodeDecodeProperty(boost::property_tree::ptree& tree, T& parameter, T const& defaultValue, std::string const& node, ParserTask task)
@@ -22,8 +42,10 @@ namespace
         ParserTask task)
     {
         auto result = false;
+        std::string elementNode;
         for (int i = 0; i < MAX_COLORS; ++i) {
-            result |= encodeDecodeProperty(tree, parameter[i], defaultValue[i], node + "[" + std::to_string(i) + "]", task);
+            elementNode.assign(node).append(ColorVectorSuffixes[i]);
+            result |= encodeDecodeProperty(tree, parameter[i], defaultValue[i], elementNode, task);
         }
         return result;
     }
@@ -37,8 +59,10 @@ namespace
         ParserTask task)
     {
         auto result = false;
+        std::string elementNode;
         for (int i = 0; i < MAX_COLORS; ++i) {
-            result |= encodeDecodeProperty(tree, parameter[i], defaultValue[i], node + "[" + std::to_string(i) + "]", task);
+            elementNode.assign(node).append(ColorVectorSuffixes[i]);
+            result |= encodeDecodeProperty(tree, parameter[i], defaultValue[i], elementNode, task);
         }
         return result;
     }
@@ -52,10 +76,11 @@ namespace
         ParserTask task)
     {
         auto result = false;
+        std::string elementNode;
         for (int i = 0; i < MAX_COLORS; ++i) {
             for (int j = 0; j < MAX_COLORS; ++j) {
-                result |=
-                    encodeDecodeProperty(tree, parameter[i][j], defaultValue[i][j], node + "[" + std::to_string(i) + ", " + std::to_string(j) + "]", task);
+                elementNode.assign(node).append(ColorMatrixSuffixes[i][j]);
+                result |= encodeDecodeProperty(tree, parameter[i][j], defaultValue[i][j], elementNode, task);
             }
         }
         return result;
@@ -70,10 +95,11 @@ namespace
         ParserTask task)
     {
         auto result = false;
+        std::string elementNode;
         for (int i = 0; i < MAX_COLORS; ++i) {
             for (int j = 0; j < MAX_COLORS; ++j) {
-                result |=
-                    encodeDecodeProperty(tree, parameter[i][j], defaultValue[i][j], node + "[" + std::to_string(i) + ", " + std::to_string(j) + "]", task);
+                elementNode.assign(node).append(ColorMatrixSuffixes[i][j]);
+                result |= encodeDecodeProperty(tree, parameter[i][j], defaultValue[i][j], elementNode, task);
             }
         }
         return result;
@@ -88,10 +114,11 @@ namespace
         ParserTask task)
     {
         auto result = false;
+        std::string elementNode;
         for (int i = 0; i < MAX_COLORS; ++i) {
             for (int j = 0; j < MAX_COLORS; ++j) {
-                result |=
-                    encodeDecodeProperty(tree, parameter[i][j], defaultValue[i][j], node + "[" + std::to_string(i) + ", " + std::to_string(j) + "]", task);
+                elementNode.assign(node).append(ColorMatrixSuffixes[i][j]);
+                result |= encodeDecodeProperty(tree, parameter[i][j], defaultValue[i][j], elementNode, task);
             }
         }
         return result;
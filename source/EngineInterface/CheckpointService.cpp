@@ -0,0 +1,99 @@
+#include "CheckpointService.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include "Base/LoggingService.h"
+
+namespace
+{
+    std::string const CheckpointPrefix = "timestep-";
+    std::string const PartialSuffix = ".partial";
+    std::string const SimulationFilename = "simulation.sim";
+    std::string const InfoFilename = "checkpoint.json";
+}
+
+bool CheckpointService::writeCheckpoint(
+    std::string const& directory,
+    DeserializedSimulation const& simulation,
+    uint64_t startTimestep,
+    CompressionSettings const& compressionSettings)
+{
+    try {
+        auto timestep = simulation.auxiliaryData.timestep;
+        auto checkpointPath = std::filesystem::path(directory) / (CheckpointPrefix + std::to_string(timestep));
+        auto partialPath = std::filesystem::path(directory) / (CheckpointPrefix + std::to_string(timestep) + PartialSuffix);
+        std::filesystem::remove_all(partialPath);
+        std::filesystem::create_directories(partialPath);
+
+        if (!SerializerService::serializeSimulationToFiles((partialPath / SimulationFilename).string(), simulation, compressionSettings)) {
+            return false;
+        }
+        boost::property_tree::ptree tree;
+        tree.put("time step", timestep);
+        tree.put("start time step", startTimestep);
+        boost::property_tree::json_parser::write_json((partialPath / InfoFilename).string(), tree);
+
+        std::filesystem::remove_all(checkpointPath);
+        std::filesystem::rename(partialPath, checkpointPath);
+        log(Priority::Important, "checkpoint written to " + checkpointPath.string());
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+std::vector<CheckpointInfo> CheckpointService::getCheckpoints(std::string const& directory)
+{
+    std::vector<CheckpointInfo> result;
+    try {
+        if (!std::filesystem::is_directory(directory)) {
+            return result;
+        }
+        for (auto const& entry : std::filesystem::directory_iterator(directory)) {
+            auto name = entry.path().filename().string();
+            if (!entry.is_directory() || !name.starts_with(CheckpointPrefix) || name.ends_with(PartialSuffix)) {
+                continue;
+            }
+            try {
+                boost::property_tree::ptree tree;
+                boost::property_tree::json_parser::read_json((entry.path() / InfoFilename).string(), tree);
+                CheckpointInfo info;
+                info.filename = (entry.path() / SimulationFilename).string();
+                info.timestep = tree.get<uint64_t>("time step");
+                info.startTimestep = tree.get<uint64_t>("start time step");
+                result.emplace_back(info);
+            } catch (...) {
+                //checkpoint without valid info file
+            }
+        }
+    } catch (...) {
+        return {};
+    }
+    std::sort(result.begin(), result.end(), [](auto const& left, auto const& right) { return left.timestep > right.timestep; });
+    return result;
+}
+
+std::optional<CheckpointInfo> CheckpointService::loadLatestCheckpoint(DeserializedSimulation& simulation, std::string const& directory)
+{
+    for (auto const& checkpoint : getCheckpoints(directory)) {
+        DeserializedSimulation checkpointSimulation;
+        if (SerializerService::deserializeSimulationFromFiles(checkpointSimulation, checkpoint.filename)) {
+            simulation = std::move(checkpointSimulation);
+            return checkpoint;
+        }
+        log(Priority::Important, "checkpoint " + checkpoint.filename + " could not be read");
+    }
+    return std::nullopt;
+}
+
+void CheckpointService::removeOldCheckpoints(std::string const& directory, int numCheckpointsToKeep)
+{
+    auto checkpoints = getCheckpoints(directory);
+    for (size_t i = std::max(0, numCheckpointsToKeep); i < checkpoints.size(); ++i) {
+        std::error_code errorCode;
+        std::filesystem::remove_all(std::filesystem::path(checkpoints.at(i).filename).parent_path(), errorCode);
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "CompressionSettings.h"
+#include "SerializerService.h"
+
+struct CheckpointInfo
+{
+    std::string filename;  //simulation file of the checkpoint
+    uint64_t timestep = 0;
+    uint64_t startTimestep = 0;  //time step at which the checkpointed run has been started
+};
+
+/**
+ * Checkpoints are stored in <directory>/timestep-<time step>/ and consist of a simulation file and a checkpoint.json.
+ * A checkpoint is written to a temporary directory which is renamed at the end such that incomplete checkpoints are never found.
+ */
+class CheckpointService
+{
+public:
+    static bool writeCheckpoint(
+        std::string const& directory,
+        DeserializedSimulation const& simulation,
+        uint64_t startTimestep,
+        CompressionSettings const& compressionSettings = CompressionSettings());
+
+    //newest checkpoint first
+    static std::vector<CheckpointInfo> getCheckpoints(std::string const& directory);
+
+    //checkpoints which cannot be read are skipped
+    static std::optional<CheckpointInfo> loadLatestCheckpoint(DeserializedSimulation& simulation, std::string const& directory);
+
+    //only the newest checkpoints are kept
+    static void removeOldCheckpoints(std::string const& directory, int numCheckpointsToKeep);
+};
@@ -0,0 +1,500 @@
+#include "ChunkedSerializerService.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+
+#include "Base/ThreadPool.h"
+
+#include "ColumnarSerializerService.h"
+#include "CompressionService.h"
+
+namespace
+{
+    char const Magic[] = {'A', 'L', 'I', 'E', 'N', 'C', 'H', 'K'};
+    char const IndexMagic[] = {'A', 'L', 'I', 'E', 'N', 'I', 'D', 'X'};
+    uint32_t constexpr ContainerVersion = 4;
+
+    //each block holds the clusters and particles of one square tile of the world, tiles are only split if they exceed the maximum block sizes
+    auto constexpr TileSize = 256.0f;
+    auto constexpr MaxCellsPerBlock = 1 << 16;
+    auto constexpr MaxParticlesPerBlock = 1 << 18;
+
+    struct BlockRange
+    {
+        size_t clusterBegin = 0;
+        size_t clusterEnd = 0;
+        size_t particleBegin = 0;
+        size_t particleEnd = 0;
+        uint64_t numCells = 0;
+    };
+
+    //bounding box of the cluster centers and particle positions of a block
+    struct BlockBounds
+    {
+        RealVector2D topLeft{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+        RealVector2D bottomRight{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    };
+
+    struct BlockEntry
+    {
+        uint64_t offset = 0;
+        uint64_t compressedSize = 0;
+        uint64_t uncompressedSize = 0;
+        CompressionCodec codec = CompressionCodec_Zstd;
+        uint64_t numClusters = 0;
+        uint64_t numCells = 0;
+        uint64_t numParticles = 0;
+        BlockBounds bounds;
+        uint64_t auxiliaryDataSize = 0;
+    };
+
+    //read-only stream on a memory range without copying it
+    class MemoryBuffer : public std::streambuf
+    {
+    public:
+        MemoryBuffer(char const* data, size_t size)
+        {
+            auto begin = const_cast<char*>(data);
+            setg(begin, begin, begin + size);
+        }
+
+    protected:
+        //seeking allows the columnar deserializer to check sizes against the block size
+        pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+        {
+            auto base = dir == std::ios_base::beg ? eback() : dir == std::ios_base::cur ? gptr() : egptr();
+            if (!(which & std::ios_base::in) || offset < eback() - base || offset > egptr() - base) {
+                return pos_type(off_type(-1));
+            }
+            setg(eback(), base + offset, egptr());
+            return pos_type(gptr() - eback());
+        }
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override { return seekoff(off_type(pos), std::ios_base::beg, which); }
+    };
+
+    template <typename T>
+    void write(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T read(std::istream& stream)
+    {
+        T result;
+        if (!stream.read(reinterpret_cast<char*>(&result), sizeof(T))) {
+            throw std::runtime_error("Unexpected end of stream.");
+        }
+        return result;
+    }
+
+    //position of the tile on a z-curve, i.e. consecutive blocks cover nearby regions of the world
+    uint64_t calcTileKey(RealVector2D const& pos)
+    {
+        auto spreadBits = [](uint64_t value) {
+            value &= 0xffffffff;
+            value = (value | (value << 16)) & 0x0000ffff0000ffff;
+            value = (value | (value << 8)) & 0x00ff00ff00ff00ff;
+            value = (value | (value << 4)) & 0x0f0f0f0f0f0f0f0f;
+            value = (value | (value << 2)) & 0x3333333333333333;
+            value = (value | (value << 1)) & 0x5555555555555555;
+            return value;
+        };
+        auto tileX = static_cast<uint64_t>(std::max(0.0f, pos.x / TileSize));
+        auto tileY = static_cast<uint64_t>(std::max(0.0f, pos.y / TileSize));
+        return spreadBits(tileX) | (spreadBits(tileY) << 1);
+    }
+
+    template <typename T>
+    struct TiledObjects
+    {
+        std::vector<uint64_t> tileKeys;
+        std::vector<T const*> objects;
+    };
+
+    template <typename T, typename PosFunc>
+    TiledObjects<T> sortByTile(std::vector<T> const& objects, PosFunc const& getPos)
+    {
+        std::vector<std::pair<uint64_t, T const*>> keyedObjects;
+        keyedObjects.reserve(objects.size());
+        for (auto const& object : objects) {
+            keyedObjects.emplace_back(calcTileKey(getPos(object)), &object);
+        }
+        std::stable_sort(keyedObjects.begin(), keyedObjects.end(), [](auto const& left, auto const& right) { return left.first < right.first; });
+
+        TiledObjects<T> result;
+        result.tileKeys.reserve(objects.size());
+        result.objects.reserve(objects.size());
+        for (auto const& [tileKey, object] : keyedObjects) {
+            result.tileKeys.emplace_back(tileKey);
+            result.objects.emplace_back(object);
+        }
+        return result;
+    }
+
+    std::vector<BlockRange> calcBlockRanges(TiledObjects<ClusterDescription> const& clusters, TiledObjects<ParticleDescription> const& particles)
+    {
+        std::vector<BlockRange> result;
+        size_t clusterIndex = 0;
+        size_t particleIndex = 0;
+        auto numClusters = clusters.objects.size();
+        auto numParticles = particles.objects.size();
+        while (clusterIndex < numClusters || particleIndex < numParticles) {
+            auto tileKey = std::min(
+                clusterIndex < numClusters ? clusters.tileKeys[clusterIndex] : std::numeric_limits<uint64_t>::max(),
+                particleIndex < numParticles ? particles.tileKeys[particleIndex] : std::numeric_limits<uint64_t>::max());
+            auto isClusterInTile = [&] { return clusterIndex < numClusters && clusters.tileKeys[clusterIndex] == tileKey; };
+            auto isParticleInTile = [&] { return particleIndex < numParticles && particles.tileKeys[particleIndex] == tileKey; };
+
+            //an over-full tile is split into several blocks
+            while (isClusterInTile() || isParticleInTile()) {
+                BlockRange range{.clusterBegin = clusterIndex, .particleBegin = particleIndex};
+                while (isClusterInTile() && range.numCells < MaxCellsPerBlock) {
+                    range.numCells += clusters.objects[clusterIndex]->cells.size();
+                    ++clusterIndex;
+                }
+                while (isParticleInTile() && particleIndex - range.particleBegin < MaxParticlesPerBlock) {
+                    ++particleIndex;
+                }
+                range.clusterEnd = clusterIndex;
+                range.particleEnd = particleIndex;
+                result.emplace_back(range);
+            }
+        }
+        return result;
+    }
+
+    BlockBounds calcBounds(std::span<ClusterDescription const* const> clusters, std::span<ParticleDescription const* const> particles)
+    {
+        BlockBounds result{.topLeft = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max()},
+                           .bottomRight = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()}};
+        auto extend = [&result](RealVector2D const& pos) {
+            result.topLeft.x = std::min(result.topLeft.x, pos.x);
+            result.topLeft.y = std::min(result.topLeft.y, pos.y);
+            result.bottomRight.x = std::max(result.bottomRight.x, pos.x);
+            result.bottomRight.y = std::max(result.bottomRight.y, pos.y);
+        };
+        for (auto const& cluster : clusters) {
+            extend(cluster->getClusterPosFromCells());
+        }
+        for (auto const& particle : particles) {
+            extend(particle->pos);
+        }
+        return result;
+    }
+
+    bool isInside(RealVector2D const& pos, RealRect const& rect)
+    {
+        return pos.x >= rect.topLeft.x && pos.y >= rect.topLeft.y && pos.x < rect.bottomRight.x && pos.y < rect.bottomRight.y;
+    }
+
+    bool isOverlapping(BlockBounds const& bounds, RealRect const& rect)
+    {
+        return bounds.topLeft.x < rect.bottomRight.x && bounds.topLeft.y < rect.bottomRight.y && bounds.bottomRight.x >= rect.topLeft.x
+            && bounds.bottomRight.y >= rect.topLeft.y;
+    }
+
+    struct Index
+    {
+        std::streampos startPos;
+        uint32_t containerVersion = 0;
+        std::vector<BlockEntry> entries;
+    };
+
+    //a block contains the original indices of its clusters and particles followed by the columnar data
+    struct Block
+    {
+        ClusteredDataDescription data;
+        std::vector<uint64_t> clusterIndices;
+        std::vector<uint64_t> particleIndices;
+    };
+
+    template <typename T>
+    void writeOriginalIndices(std::ostream& stream, std::span<T const* const> objects, std::vector<T> const& originalObjects)
+    {
+        std::vector<uint64_t> indices;
+        indices.reserve(objects.size());
+        for (auto const& object : objects) {
+            indices.emplace_back(static_cast<uint64_t>(object - originalObjects.data()));
+        }
+        stream.write(reinterpret_cast<char const*>(indices.data()), indices.size() * sizeof(uint64_t));
+    }
+
+    std::vector<uint64_t> readOriginalIndices(std::istream& stream, uint64_t numIndices, size_t blockSize)
+    {
+        if (numIndices > blockSize / sizeof(uint64_t)) {
+            throw std::runtime_error("Block too small.");
+        }
+        std::vector<uint64_t> result(numIndices);
+        if (!stream.read(reinterpret_cast<char*>(result.data()), result.size() * sizeof(uint64_t))) {
+            throw std::runtime_error("Unexpected end of stream.");
+        }
+        return result;
+    }
+
+    Index readIndex(std::istream& stream)
+    {
+        Index result;
+        result.startPos = stream.tellg();
+        char magic[sizeof(Magic)];
+        if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0) {
+            throw std::runtime_error("No chunked format detected.");
+        }
+        auto containerVersion = read<uint32_t>(stream);
+        result.containerVersion = containerVersion;
+        if (containerVersion > ContainerVersion) {
+            throw std::runtime_error("Container version not supported.");
+        }
+
+        stream.seekg(-static_cast<std::streamoff>(sizeof(uint64_t) + sizeof(IndexMagic)), std::ios::end);
+        auto indexOffset = read<uint64_t>(stream);
+        char indexMagic[sizeof(IndexMagic)];
+        if (!stream.read(indexMagic, sizeof(indexMagic)) || std::memcmp(indexMagic, IndexMagic, sizeof(IndexMagic)) != 0) {
+            throw std::runtime_error("No index found.");
+        }
+        stream.seekg(result.startPos + static_cast<std::streamoff>(indexOffset));
+        result.entries.resize(read<uint32_t>(stream));
+        for (auto& entry : result.entries) {
+            entry.offset = read<uint64_t>(stream);
+            entry.compressedSize = read<uint64_t>(stream);
+            entry.uncompressedSize = read<uint64_t>(stream);
+            entry.codec = read<uint8_t>(stream);
+            entry.numClusters = read<uint64_t>(stream);
+            entry.numCells = read<uint64_t>(stream);
+            entry.numParticles = read<uint64_t>(stream);
+            if (containerVersion >= 2) {
+                entry.bounds.topLeft.x = read<float>(stream);
+                entry.bounds.topLeft.y = read<float>(stream);
+                entry.bounds.bottomRight.x = read<float>(stream);
+                entry.bounds.bottomRight.y = read<float>(stream);
+            }
+            if (containerVersion >= 3) {
+                entry.auxiliaryDataSize = read<uint64_t>(stream);
+            }
+        }
+        return result;
+    }
+
+    //reads and decodes the given blocks in parallel
+    std::vector<Block> readBlocks(std::istream& stream, Index const& index, std::vector<size_t> const& blockIndices)
+    {
+        std::vector<std::vector<char>> compressedBlocks(blockIndices.size());
+        for (size_t i = 0; i < blockIndices.size(); ++i) {
+            auto const& entry = index.entries.at(blockIndices.at(i));
+            auto& compressedBlock = compressedBlocks.at(i);
+            compressedBlock.resize(entry.compressedSize);
+            stream.seekg(index.startPos + static_cast<std::streamoff>(entry.offset));
+            if (!stream.read(compressedBlock.data(), compressedBlock.size())) {
+                throw std::runtime_error("Unexpected end of stream.");
+            }
+        }
+
+        std::vector<Block> result(blockIndices.size());
+        ThreadPool::getInstance().parallelFor(blockIndices.size(), [&](size_t i) {
+            auto const& entry = index.entries.at(blockIndices.at(i));
+            auto uncompressedBlock = CompressionService::decompress(compressedBlocks.at(i), entry.uncompressedSize, entry.codec);
+            compressedBlocks.at(i) = {};
+
+            MemoryBuffer buffer(uncompressedBlock.data(), uncompressedBlock.size());
+            std::istream blockStream(&buffer);
+            auto& block = result.at(i);
+            if (index.containerVersion >= 4) {
+                block.clusterIndices = readOriginalIndices(blockStream, entry.numClusters, uncompressedBlock.size());
+                block.particleIndices = readOriginalIndices(blockStream, entry.numParticles, uncompressedBlock.size());
+            }
+            ColumnarSerializerService::deserialize(block.data, blockStream);
+            if (block.data.clusters.size() != entry.numClusters || block.data.particles.size() != entry.numParticles) {
+                throw std::runtime_error("Block does not match the index.");
+            }
+        });
+        return result;
+    }
+
+    std::vector<Block> readBlocks(std::istream& stream, Index const& index, size_t begin, size_t end)
+    {
+        std::vector<size_t> blockIndices(end - begin);
+        std::iota(blockIndices.begin(), blockIndices.end(), begin);
+        return readBlocks(stream, index, blockIndices);
+    }
+
+    MainDataSummary calcSummary(Index const& index)
+    {
+        MainDataSummary result;
+        for (auto const& entry : index.entries) {
+            result.numClusters += entry.numClusters;
+            result.numCells += entry.numCells;
+            result.numParticles += entry.numParticles;
+            result.auxiliaryDataSize += entry.auxiliaryDataSize;
+        }
+        return result;
+    }
+}
+
+bool ChunkedSerializerService::isChunkedFormat(std::istream& stream)
+{
+    auto startPos = stream.tellg();
+    char magic[sizeof(Magic)];
+    auto result = static_cast<bool>(stream.read(magic, sizeof(magic))) && std::memcmp(magic, Magic, sizeof(Magic)) == 0;
+    stream.clear();
+    stream.seekg(startPos);
+    return result;
+}
+
+void ChunkedSerializerService::serialize(ClusteredDataDescription const& data, std::ostream& stream, CompressionSettings const& settings)
+{
+    auto tiledClusters = sortByTile(data.clusters, [](ClusterDescription const& cluster) { return cluster.getClusterPosFromCells(); });
+    auto tiledParticles = sortByTile(data.particles, [](ParticleDescription const& particle) { return particle.pos; });
+    auto blockRanges = calcBlockRanges(tiledClusters, tiledParticles);
+
+    std::vector<std::vector<char>> compressedBlocks(blockRanges.size());
+    std::vector<BlockEntry> entries(blockRanges.size());
+    ThreadPool::getInstance().parallelFor(blockRanges.size(), [&](size_t index) {
+        auto const& range = blockRanges.at(index);
+        std::span<ClusterDescription const* const> clusters(tiledClusters.objects.data() + range.clusterBegin, range.clusterEnd - range.clusterBegin);
+        std::span<ParticleDescription const* const> particles(
+            tiledParticles.objects.data() + range.particleBegin, range.particleEnd - range.particleBegin);
+
+        std::ostringstream blockStream(std::ios::binary);
+        writeOriginalIndices(blockStream, clusters, data.clusters);
+        writeOriginalIndices(blockStream, particles, data.particles);
+        ColumnarSerializerService::serialize(clusters, particles, blockStream);
+        auto uncompressedBlock = blockStream.str();
+        compressedBlocks.at(index) = CompressionService::compress(uncompressedBlock, settings);
+
+        auto& entry = entries.at(index);
+        entry.compressedSize = compressedBlocks.at(index).size();
+        entry.uncompressedSize = uncompressedBlock.size();
+        entry.codec = settings.codec;
+        entry.numClusters = clusters.size();
+        entry.numCells = range.numCells;
+        entry.numParticles = particles.size();
+        entry.bounds = calcBounds(clusters, particles);
+        for (auto const& cluster : clusters) {
+            for (auto const& cell : cluster->cells) {
+                entry.auxiliaryDataSize += cell.getAuxiliaryDataSize();
+            }
+        }
+    });
+
+    auto startPos = stream.tellp();
+    stream.write(Magic, sizeof(Magic));
+    write(stream, ContainerVersion);
+    for (size_t i = 0; i < compressedBlocks.size(); ++i) {
+        entries.at(i).offset = static_cast<uint64_t>(stream.tellp() - startPos);
+        stream.write(compressedBlocks.at(i).data(), compressedBlocks.at(i).size());
+    }
+
+    auto indexOffset = static_cast<uint64_t>(stream.tellp() - startPos);
+    write(stream, static_cast<uint32_t>(entries.size()));
+    for (auto const& entry : entries) {
+        write(stream, entry.offset);
+        write(stream, entry.compressedSize);
+        write(stream, entry.uncompressedSize);
+        write(stream, static_cast<uint8_t>(entry.codec));
+        write(stream, entry.numClusters);
+        write(stream, entry.numCells);
+        write(stream, entry.numParticles);
+        write(stream, entry.bounds.topLeft.x);
+        write(stream, entry.bounds.topLeft.y);
+        write(stream, entry.bounds.bottomRight.x);
+        write(stream, entry.bounds.bottomRight.y);
+        write(stream, entry.auxiliaryDataSize);
+    }
+    write(stream, indexOffset);
+    stream.write(IndexMagic, sizeof(IndexMagic));
+    if (!stream) {
+        throw std::runtime_error("Could not write stream.");
+    }
+}
+
+void ChunkedSerializerService::deserialize(ClusteredDataDescription& data, std::istream& stream)
+{
+    auto index = readIndex(stream);
+    auto blocks = readBlocks(stream, index, 0, index.entries.size());
+
+    auto summary = calcSummary(index);
+    data.clear();
+    if (index.containerVersion < 4) {
+        //older containers do not store the original order, hence the blocks are merged in their spatial order
+        data.clusters.reserve(summary.numClusters);
+        data.particles.reserve(summary.numParticles);
+        for (auto& block : blocks) {
+            std::move(block.data.clusters.begin(), block.data.clusters.end(), std::back_inserter(data.clusters));
+            std::move(block.data.particles.begin(), block.data.particles.end(), std::back_inserter(data.particles));
+        }
+        return;
+    }
+
+    data.clusters.resize(summary.numClusters);
+    data.particles.resize(summary.numParticles);
+    std::vector<bool> isClusterAssigned(summary.numClusters, false);
+    std::vector<bool> isParticleAssigned(summary.numParticles, false);
+    auto moveToOriginalIndices = [](auto& objects, std::vector<uint64_t> const& indices, auto& targets, std::vector<bool>& isAssigned) {
+        for (size_t i = 0; i < objects.size(); ++i) {
+            auto index = indices.at(i);
+            if (index >= targets.size() || isAssigned.at(index)) {
+                throw std::runtime_error("Invalid object order.");
+            }
+            targets.at(index) = std::move(objects.at(i));
+            isAssigned.at(index) = true;
+        }
+    };
+    for (auto& block : blocks) {
+        moveToOriginalIndices(block.data.clusters, block.clusterIndices, data.clusters, isClusterAssigned);
+        moveToOriginalIndices(block.data.particles, block.particleIndices, data.particles, isParticleAssigned);
+    }
+}
+
+MainDataSummary ChunkedSerializerService::readSummary(std::istream& stream)
+{
+    auto startPos = stream.tellg();
+    auto result = calcSummary(readIndex(stream));
+    stream.seekg(startPos);
+    return result;
+}
+
+void ChunkedSerializerService::deserializeInBatches(std::istream& stream, std::function<void(ClusteredDataDescription const& batch)> const& batchCallback)
+{
+    auto index = readIndex(stream);
+
+    //one block per thread is decoded at the same time
+    size_t numBlocksInParallel = ThreadPool::getInstance().getNumThreads();
+    for (size_t begin = 0; begin < index.entries.size(); begin += numBlocksInParallel) {
+        auto end = std::min(begin + numBlocksInParallel, index.entries.size());
+        for (auto const& block : readBlocks(stream, index, begin, end)) {
+            batchCallback(block.data);
+        }
+    }
+}
+
+size_t ChunkedSerializerService::deserializeRegion(ClusteredDataDescription& data, std::istream& stream, RealRect const& rect)
+{
+    auto index = readIndex(stream);
+    std::vector<size_t> blockIndices;
+    for (size_t i = 0; i < index.entries.size(); ++i) {
+        if (isOverlapping(index.entries.at(i).bounds, rect)) {
+            blockIndices.emplace_back(i);
+        }
+    }
+
+    data.clear();
+    for (auto& block : readBlocks(stream, index, blockIndices)) {
+        for (auto& cluster : block.data.clusters) {
+            if (isInside(cluster.getClusterPosFromCells(), rect)) {
+                data.clusters.emplace_back(std::move(cluster));
+            }
+        }
+        for (auto& particle : block.data.particles) {
+            if (isInside(particle.pos, rect)) {
+                data.particles.emplace_back(std::move(particle));
+            }
+        }
+    }
+    return blockIndices.size();
+}
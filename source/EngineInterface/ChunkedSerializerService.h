@@ -0,0 +1,40 @@
+#pragma once
+
+#include <functional>
+#include <istream>
+#include <ostream>
+
+#include "Base/Definitions.h"
+
+#include "CompressionSettings.h"
+#include "Descriptions.h"
+#include "MainDataSummary.h"
+
+/**
+ * Container for the main data of a simulation: the clusters and particles are split into blocks which are encoded in the columnar format and
+ * compressed independently. An index at the end of the container lists the position of each block so that blocks can be compressed and
+ * decompressed in parallel.
+ * The world is divided into fixed square tiles and each block contains the clusters (by their centers) and particles of one tile. A tile is
+ * only split into several blocks if it contains too many objects. The index stores the bounding box of each block, i.e. a region of the
+ * world can be loaded by decoding only the overlapping blocks.
+ * Each block stores the original indices of its objects, hence a full deserialization preserves the order of the clusters and particles.
+ */
+class ChunkedSerializerService
+{
+public:
+    //checks the magic number at the current stream position without consuming it
+    static bool isChunkedFormat(std::istream& stream);
+
+    static void serialize(ClusteredDataDescription const& data, std::ostream& stream, CompressionSettings const& settings = CompressionSettings());
+
+    //stream must be seekable for all following methods
+    static void deserialize(ClusteredDataDescription& data, std::istream& stream);
+
+    static MainDataSummary readSummary(std::istream& stream);
+
+    //passes the blocks in their spatial order to the callback, only a few blocks are held in memory at the same time
+    static void deserializeInBatches(std::istream& stream, std::function<void(ClusteredDataDescription const& batch)> const& batchCallback);
+
+    //returns the clusters whose centers and the particles whose positions lie in the rectangle, the number of decoded blocks is returned
+    static size_t deserializeRegion(ClusteredDataDescription& data, std::istream& stream, RealRect const& rect);
+};
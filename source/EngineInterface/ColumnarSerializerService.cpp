@@ -0,0 +1,1044 @@
+#include "ColumnarSerializerService.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <optional>
+#include <stdexcept>
+
+#include "Base/Resources.h"
+#include "Base/VersionChecker.h"
+
+#include "GenomePool.h"
+
+//columns are written in host byte order
+static_assert(std::endian::native == std::endian::little, "Columnar format requires a little-endian platform.");
+
+namespace
+{
+    char const Magic[] = {'A', 'L', 'I', 'E', 'N', 'C', 'O', 'L'};
+    uint32_t constexpr FormatVersion = 2;
+
+    auto constexpr Id_Cluster_NumCells = 0;
+
+    auto constexpr Id_Cell_Id = 100;
+    auto constexpr Id_Cell_PosX = 101;
+    auto constexpr Id_Cell_PosY = 102;
+    auto constexpr Id_Cell_VelX = 103;
+    auto constexpr Id_Cell_VelY = 104;
+    auto constexpr Id_Cell_Energy = 105;
+    auto constexpr Id_Cell_Stiffness = 106;
+    auto constexpr Id_Cell_Color = 107;
+    auto constexpr Id_Cell_MaxConnections = 108;
+    auto constexpr Id_Cell_Barrier = 109;
+    auto constexpr Id_Cell_Age = 110;
+    auto constexpr Id_Cell_LivingState = 111;
+    auto constexpr Id_Cell_CreatureId = 112;
+    auto constexpr Id_Cell_MutationId = 113;
+    auto constexpr Id_Cell_AncestorMutationId = 114;
+    auto constexpr Id_Cell_GenomeComplexity = 115;
+    auto constexpr Id_Cell_ExecutionOrderNumber = 116;
+    auto constexpr Id_Cell_InputExecutionOrderNumber = 117;
+    auto constexpr Id_Cell_OutputBlocked = 118;
+    auto constexpr Id_Cell_CellFunction = 119;
+    auto constexpr Id_Cell_ActivityChannels = 120;
+    auto constexpr Id_Cell_ActivationTime = 121;
+    auto constexpr Id_Cell_DetectedByCreatureId = 122;
+    auto constexpr Id_Cell_CellFunctionUsed = 123;
+    auto constexpr Id_Cell_NameSize = 124;
+    auto constexpr Id_Cell_Name = 125;
+    auto constexpr Id_Cell_DescriptionSize = 126;
+    auto constexpr Id_Cell_Description = 127;
+    auto constexpr Id_Cell_NumConnections = 128;
+
+    auto constexpr Id_Connection_CellId = 200;
+    auto constexpr Id_Connection_Distance = 201;
+    auto constexpr Id_Connection_AngleFromPrevious = 202;
+
+    auto constexpr Id_Neuron_Weights = 300;
+    auto constexpr Id_Neuron_Biases = 301;
+    auto constexpr Id_Neuron_ActivationFunctions = 302;
+
+    auto constexpr Id_Transmitter_Mode = 400;
+
+    auto constexpr Id_Constructor_ActivationMode = 500;
+    auto constexpr Id_Constructor_ConstructionActivationTime = 501;
+    auto constexpr Id_Constructor_GenomeSize = 502;
+    auto constexpr Id_Constructor_Genome = 503;
+    auto constexpr Id_Constructor_NumInheritedGenomeNodes = 504;
+    auto constexpr Id_Constructor_GenomeGeneration = 505;
+    auto constexpr Id_Constructor_ConstructionAngle1 = 506;
+    auto constexpr Id_Constructor_ConstructionAngle2 = 507;
+    auto constexpr Id_Constructor_LastConstructedCellId = 508;
+    auto constexpr Id_Constructor_GenomeCurrentNodeIndex = 509;
+    auto constexpr Id_Constructor_GenomeCurrentRepetition = 510;
+    auto constexpr Id_Constructor_CurrentBranch = 511;
+    auto constexpr Id_Constructor_OffspringCreatureId = 512;
+    auto constexpr Id_Constructor_OffspringMutationId = 513;
+    auto constexpr Id_Constructor_GenomeHandle = 514;
+
+    auto constexpr Id_Sensor_FixedAngle = 600;
+    auto constexpr Id_Sensor_MinDensity = 601;
+    auto constexpr Id_Sensor_MinRange = 602;
+    auto constexpr Id_Sensor_MaxRange = 603;
+    auto constexpr Id_Sensor_RestrictToColor = 604;
+    auto constexpr Id_Sensor_RestrictToMutants = 605;
+    auto constexpr Id_Sensor_MemoryChannel1 = 606;
+    auto constexpr Id_Sensor_MemoryChannel2 = 607;
+    auto constexpr Id_Sensor_MemoryChannel3 = 608;
+    auto constexpr Id_Sensor_TargetX = 609;
+    auto constexpr Id_Sensor_TargetY = 610;
+
+    auto constexpr Id_Nerve_PulseMode = 700;
+    auto constexpr Id_Nerve_AlternationMode = 701;
+
+    auto constexpr Id_Attacker_Mode = 800;
+
+    auto constexpr Id_Injector_Mode = 900;
+    auto constexpr Id_Injector_Counter = 901;
+    auto constexpr Id_Injector_GenomeSize = 902;
+    auto constexpr Id_Injector_Genome = 903;
+    auto constexpr Id_Injector_GenomeGeneration = 904;
+    auto constexpr Id_Injector_GenomeHandle = 905;
+
+    auto constexpr Id_Muscle_Mode = 1000;
+    auto constexpr Id_Muscle_LastBendingDirection = 1001;
+    auto constexpr Id_Muscle_LastBendingSourceIndex = 1002;
+    auto constexpr Id_Muscle_ConsecutiveBendingAngle = 1003;
+
+    auto constexpr Id_Defender_Mode = 1100;
+
+    auto constexpr Id_Reconnector_RestrictToColor = 1200;
+    auto constexpr Id_Reconnector_RestrictToMutants = 1201;
+
+    auto constexpr Id_Detonator_State = 1300;
+    auto constexpr Id_Detonator_Countdown = 1301;
+
+    auto constexpr Id_Particle_Id = 1400;
+    auto constexpr Id_Particle_PosX = 1401;
+    auto constexpr Id_Particle_PosY = 1402;
+    auto constexpr Id_Particle_VelX = 1403;
+    auto constexpr Id_Particle_VelY = 1404;
+    auto constexpr Id_Particle_Energy = 1405;
+    auto constexpr Id_Particle_Color = 1406;
+
+    //genomes are stored once per distinct content and referenced by handles (Id_Constructor_GenomeHandle, Id_Injector_GenomeHandle)
+    //older files contain the genomes inline (Id_Constructor_GenomeSize, Id_Constructor_Genome, ...)
+    auto constexpr Id_Genome_Size = 1500;
+    auto constexpr Id_Genome_Data = 1501;
+
+    enum class ColumnType : uint8_t
+    {
+        UInt8,
+        Int32,
+        UInt32,
+        UInt64,
+        Float
+    };
+
+    template <typename T>
+    constexpr ColumnType getColumnType()
+    {
+        if constexpr (std::is_same_v<T, uint8_t>) {
+            return ColumnType::UInt8;
+        } else if constexpr (std::is_same_v<T, int32_t>) {
+            return ColumnType::Int32;
+        } else if constexpr (std::is_same_v<T, uint32_t>) {
+            return ColumnType::UInt32;
+        } else if constexpr (std::is_same_v<T, uint64_t>) {
+            return ColumnType::UInt64;
+        } else {
+            static_assert(std::is_same_v<T, float>, "Unsupported column type.");
+            return ColumnType::Float;
+        }
+    }
+
+    struct Column
+    {
+        ColumnType type = ColumnType::UInt8;
+        std::vector<uint8_t> data;
+    };
+    using Columns = std::map<int, Column>;
+
+    //columns for writing are addressed directly by their ids, the type of a column is set when it is created
+    auto constexpr NumColumnIds = Id_Genome_Data + 1;
+    using ColumnArray = std::vector<std::optional<Column>>;
+
+    //optional values are encoded by a reserved value
+    auto constexpr NoIntValue = std::numeric_limits<int32_t>::min();
+
+    int32_t encodeOptional(std::optional<int> const& value)
+    {
+        return value.value_or(NoIntValue);
+    }
+    float encodeOptional(std::optional<float> const& value)
+    {
+        return value.value_or(std::numeric_limits<float>::quiet_NaN());
+    }
+    std::optional<int> decodeOptional(int32_t value)
+    {
+        return value != NoIntValue ? std::make_optional(value) : std::nullopt;
+    }
+    std::optional<float> decodeOptional(float value)
+    {
+        return !std::isnan(value) ? std::make_optional(value) : std::nullopt;
+    }
+
+    std::vector<uint8_t>& getColumnData(ColumnArray& columns, int id, ColumnType type)
+    {
+        auto& column = columns[id];
+        if (!column) {
+            column = Column{.type = type};
+        }
+        return column->data;
+    }
+
+    template <typename T>
+    void push(ColumnArray& columns, int id, T const& value)
+    {
+        auto& data = getColumnData(columns, id, getColumnType<T>());
+        auto bytes = reinterpret_cast<uint8_t const*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename Container>
+    void pushRange(ColumnArray& columns, int id, Container const& values)
+    {
+        auto& data = getColumnData(columns, id, ColumnType::UInt8);
+        data.insert(data.end(), values.begin(), values.end());
+    }
+
+    //reads values sequentially from a column; if the column is not present the target values remain untouched
+    template <typename T>
+    class ColumnReader
+    {
+    public:
+        ColumnReader(Columns const& columns, int id)
+        {
+            auto findResult = columns.find(id);
+            if (findResult != columns.end()) {
+                if (findResult->second.type != getColumnType<T>()) {
+                    throw std::runtime_error("Column type mismatch.");
+                }
+                _column = &findResult->second;
+            }
+        }
+
+        bool exists() const { return _column != nullptr; }
+
+        size_t getNumRemainingValues() const { return _column ? (_column->data.size() - _pos) / sizeof(T) : 0; }
+
+        template <typename Target>
+        void read(Target& target)
+        {
+            if (!_column) {
+                return;
+            }
+            if (_pos + sizeof(T) > _column->data.size()) {
+                throw std::runtime_error("Column too short.");
+            }
+            T value;
+            std::memcpy(&value, _column->data.data() + _pos, sizeof(T));
+            _pos += sizeof(T);
+            target = static_cast<Target>(value);
+        }
+
+        template <typename Target>
+        void readOptional(std::optional<Target>& target)
+        {
+            if (!_column) {
+                return;
+            }
+            T value;
+            read(value);
+            target = decodeOptional(value);
+        }
+
+        template <typename Container>
+        void readRange(Container& target, size_t size)
+        {
+            static_assert(std::is_same_v<T, uint8_t>);
+            if (!_column) {
+                return;
+            }
+            if (_pos + size > _column->data.size()) {
+                throw std::runtime_error("Column too short.");
+            }
+            auto begin = _column->data.data() + _pos;
+            target.assign(begin, begin + size);
+            _pos += size;
+        }
+
+    private:
+        Column const* _column = nullptr;
+        size_t _pos = 0;
+    };
+
+    template <typename T>
+    void write(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T read(std::istream& stream)
+    {
+        T result;
+        if (!stream.read(reinterpret_cast<char*>(&result), sizeof(T))) {
+            throw std::runtime_error("Unexpected end of stream.");
+        }
+        return result;
+    }
+
+    void writeString(std::ostream& stream, std::string const& value)
+    {
+        write(stream, static_cast<uint32_t>(value.size()));
+        stream.write(value.data(), value.size());
+    }
+
+    //sizes read from the stream are not trusted and are checked against the remaining size of seekable streams before memory is allocated
+    std::optional<uint64_t> getRemainingSize(std::istream& stream)
+    {
+        auto pos = stream.tellg();
+        if (pos == std::streampos(-1)) {
+            return std::nullopt;
+        }
+        stream.seekg(0, std::ios::end);
+        auto endPos = stream.tellg();
+        stream.clear();
+        stream.seekg(pos);
+        if (endPos == std::streampos(-1) || endPos < pos) {
+            return std::nullopt;
+        }
+        return static_cast<uint64_t>(endPos - pos);
+    }
+
+    //reads in bounded steps such that a corrupt size in a non-seekable stream fails at the end of the stream
+    void readBytes(std::istream& stream, std::vector<uint8_t>& data, uint64_t size)
+    {
+        auto constexpr MaxStepSize = uint64_t(1) << 24;
+        data.clear();
+        while (data.size() < size) {
+            auto offset = data.size();
+            auto stepSize = std::min(size - offset, MaxStepSize);
+            data.resize(offset + stepSize);
+            if (!stream.read(reinterpret_cast<char*>(data.data() + offset), stepSize)) {
+                throw std::runtime_error("Unexpected end of stream.");
+            }
+        }
+    }
+
+    std::string readString(std::istream& stream)
+    {
+        std::string result(read<uint32_t>(stream), '\0');
+        if (!stream.read(result.data(), result.size())) {
+            throw std::runtime_error("Unexpected end of stream.");
+        }
+        return result;
+    }
+
+    void pushCell(ColumnArray& columns, GenomePool& genomePool, CellDescription const& cell)
+    {
+        push<uint64_t>(columns, Id_Cell_Id, cell.id);
+        push<float>(columns, Id_Cell_PosX, cell.pos.x);
+        push<float>(columns, Id_Cell_PosY, cell.pos.y);
+        push<float>(columns, Id_Cell_VelX, cell.vel.x);
+        push<float>(columns, Id_Cell_VelY, cell.vel.y);
+        push<float>(columns, Id_Cell_Energy, cell.energy);
+        push<float>(columns, Id_Cell_Stiffness, cell.stiffness);
+        push<int32_t>(columns, Id_Cell_Color, cell.color);
+        push<int32_t>(columns, Id_Cell_MaxConnections, cell.maxConnections);
+        push<uint8_t>(columns, Id_Cell_Barrier, cell.barrier);
+        push<int32_t>(columns, Id_Cell_Age, cell.age);
+        push<int32_t>(columns, Id_Cell_LivingState, cell.livingState);
+        push<int32_t>(columns, Id_Cell_CreatureId, cell.creatureId);
+        push<int32_t>(columns, Id_Cell_MutationId, cell.mutationId);
+        push<uint8_t>(columns, Id_Cell_AncestorMutationId, cell.ancestorMutationId);
+        push<float>(columns, Id_Cell_GenomeComplexity, cell.genomeComplexity);
+        push<int32_t>(columns, Id_Cell_ExecutionOrderNumber, cell.executionOrderNumber);
+        push<int32_t>(columns, Id_Cell_InputExecutionOrderNumber, encodeOptional(cell.inputExecutionOrderNumber));
+        push<uint8_t>(columns, Id_Cell_OutputBlocked, cell.outputBlocked);
+        for (int i = 0; i < MAX_CHANNELS; ++i) {
+            push<float>(columns, Id_Cell_ActivityChannels, cell.activity.channels[i]);
+        }
+        push<int32_t>(columns, Id_Cell_ActivationTime, cell.activationTime);
+        push<uint8_t>(columns, Id_Cell_DetectedByCreatureId, cell.detectedByCreatureId);
+        push<uint8_t>(columns, Id_Cell_CellFunctionUsed, cell.cellFunctionUsed);
+        push<uint32_t>(columns, Id_Cell_NameSize, static_cast<uint32_t>(cell.metadata.name.size()));
+        pushRange(columns, Id_Cell_Name, cell.metadata.name);
+        push<uint32_t>(columns, Id_Cell_DescriptionSize, static_cast<uint32_t>(cell.metadata.description.size()));
+        pushRange(columns, Id_Cell_Description, cell.metadata.description);
+
+        push<uint32_t>(columns, Id_Cell_NumConnections, static_cast<uint32_t>(cell.connections.size()));
+        for (auto const& connection : cell.connections) {
+            push<uint64_t>(columns, Id_Connection_CellId, connection.cellId);
+            push<float>(columns, Id_Connection_Distance, connection.distance);
+            push<float>(columns, Id_Connection_AngleFromPrevious, connection.angleFromPrevious);
+        }
+
+        auto cellFunctionType = cell.getCellFunctionType();
+        push<uint8_t>(columns, Id_Cell_CellFunction, static_cast<uint8_t>(cellFunctionType));
+        switch (cellFunctionType) {
+        case CellFunction_Neuron: {
+            auto const& neuron = std::get<NeuronDescription>(*cell.cellFunction);
+            for (int row = 0; row < MAX_CHANNELS; ++row) {
+                for (int col = 0; col < MAX_CHANNELS; ++col) {
+                    push<float>(columns, Id_Neuron_Weights, neuron.weights[row][col]);
+                }
+            }
+            for (int i = 0; i < MAX_CHANNELS; ++i) {
+                push<float>(columns, Id_Neuron_Biases, neuron.biases[i]);
+            }
+            for (int i = 0; i < MAX_CHANNELS; ++i) {
+                push<int32_t>(columns, Id_Neuron_ActivationFunctions, neuron.activationFunctions[i]);
+            }
+        } break;
+        case CellFunction_Transmitter: {
+            auto const& transmitter = std::get<TransmitterDescription>(*cell.cellFunction);
+            push<int32_t>(columns, Id_Transmitter_Mode, transmitter.mode);
+        } break;
+        case CellFunction_Constructor: {
+            auto const& constructor = std::get<ConstructorDescription>(*cell.cellFunction);
+            push<int32_t>(columns, Id_Constructor_ActivationMode, constructor.activationMode);
+            push<int32_t>(columns, Id_Constructor_ConstructionActivationTime, constructor.constructionActivationTime);
+            push<uint32_t>(columns, Id_Constructor_GenomeHandle, genomePool.add(constructor.genome));
+            push<int32_t>(columns, Id_Constructor_NumInheritedGenomeNodes, constructor.numInheritedGenomeNodes);
+            push<int32_t>(columns, Id_Constructor_GenomeGeneration, constructor.genomeGeneration);
+            push<float>(columns, Id_Constructor_ConstructionAngle1, constructor.constructionAngle1);
+            push<float>(columns, Id_Constructor_ConstructionAngle2, constructor.constructionAngle2);
+            push<uint64_t>(columns, Id_Constructor_LastConstructedCellId, constructor.lastConstructedCellId);
+            push<int32_t>(columns, Id_Constructor_GenomeCurrentNodeIndex, constructor.genomeCurrentNodeIndex);
+            push<int32_t>(columns, Id_Constructor_GenomeCurrentRepetition, constructor.genomeCurrentRepetition);
+            push<int32_t>(columns, Id_Constructor_CurrentBranch, constructor.currentBranch);
+            push<int32_t>(columns, Id_Constructor_OffspringCreatureId, constructor.offspringCreatureId);
+            push<int32_t>(columns, Id_Constructor_OffspringMutationId, constructor.offspringMutationId);
+        } break;
+        case CellFunction_Sensor: {
+            auto const& sensor = std::get<SensorDescription>(*cell.cellFunction);
+            push<float>(columns, Id_Sensor_FixedAngle, encodeOptional(sensor.fixedAngle));
+            push<float>(columns, Id_Sensor_MinDensity, sensor.minDensity);
+            push<int32_t>(columns, Id_Sensor_MinRange, encodeOptional(sensor.minRange));
+            push<int32_t>(columns, Id_Sensor_MaxRange, encodeOptional(sensor.maxRange));
+            push<int32_t>(columns, Id_Sensor_RestrictToColor, encodeOptional(sensor.restrictToColor));
+            push<int32_t>(columns, Id_Sensor_RestrictToMutants, sensor.restrictToMutants);
+            push<float>(columns, Id_Sensor_MemoryChannel1, sensor.memoryChannel1);
+            push<float>(columns, Id_Sensor_MemoryChannel2, sensor.memoryChannel2);
+            push<float>(columns, Id_Sensor_MemoryChannel3, sensor.memoryChannel3);
+            push<float>(columns, Id_Sensor_TargetX, sensor.targetX);
+            push<float>(columns, Id_Sensor_TargetY, sensor.targetY);
+        } break;
+        case CellFunction_Nerve: {
+            auto const& nerve = std::get<NerveDescription>(*cell.cellFunction);
+            push<int32_t>(columns, Id_Nerve_PulseMode, nerve.pulseMode);
+            push<int32_t>(columns, Id_Nerve_AlternationMode, nerve.alternationMode);
+        } break;
+        case CellFunction_Attacker: {
+            auto const& attacker = std::get<AttackerDescription>(*cell.cellFunction);
+            push<int32_t>(columns, Id_Attacker_Mode, attacker.mode);
+        } break;
+        case CellFunction_Injector: {
+            auto const& injector = std::get<InjectorDescription>(*cell.cellFunction);
+            push<int32_t>(columns, Id_Injector_Mode, injector.mode);
+            push<int32_t>(columns, Id_Injector_Counter, injector.counter);
+            push<uint32_t>(columns, Id_Injector_GenomeHandle, genomePool.add(injector.genome));
+            push<int32_t>(columns, Id_Injector_GenomeGeneration, injector.genomeGeneration);
+        } break;
+        case CellFunction_Muscle: {
+            auto const& muscle = std::get<MuscleDescription>(*cell.cellFunction);
+            push<int32_t>(columns, Id_Muscle_Mode, muscle.mode);
+            push<int32_t>(columns, Id_Muscle_LastBendingDirection, muscle.lastBendingDirection);
+            push<int32_t>(columns, Id_Muscle_LastBendingSourceIndex, muscle.lastBendingSourceIndex);
+            push<float>(columns, Id_Muscle_ConsecutiveBendingAngle, muscle.consecutiveBendingAngle);
+        } break;
+        case CellFunction_Defender: {
+            auto const& defender = std::get<DefenderDescription>(*cell.cellFunction);
+            push<int32_t>(columns, Id_Defender_Mode, defender.mode);
+        } break;
+        case CellFunction_Reconnector: {
+            auto const& reconnector = std::get<ReconnectorDescription>(*cell.cellFunction);
+            push<int32_t>(columns, Id_Reconnector_RestrictToColor, encodeOptional(reconnector.restrictToColor));
+            push<int32_t>(columns, Id_Reconnector_RestrictToMutants, reconnector.restrictToMutants);
+        } break;
+        case CellFunction_Detonator: {
+            auto const& detonator = std::get<DetonatorDescription>(*cell.cellFunction);
+            push<int32_t>(columns, Id_Detonator_State, detonator.state);
+            push<int32_t>(columns, Id_Detonator_Countdown, detonator.countdown);
+        } break;
+        }
+    }
+
+    void pushGenomes(ColumnArray& columns, GenomePool const& genomePool)
+    {
+        for (size_t i = 0; i < genomePool.getNumGenomes(); ++i) {
+            auto const& genome = genomePool.get(static_cast<uint32_t>(i));
+            push<uint32_t>(columns, Id_Genome_Size, static_cast<uint32_t>(genome.size()));
+            pushRange(columns, Id_Genome_Data, genome);
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> readGenomes(Columns const& columns)
+    {
+        std::vector<std::vector<uint8_t>> result;
+        ColumnReader<uint32_t> genomeSize(columns, Id_Genome_Size);
+        ColumnReader<uint8_t> genomeData(columns, Id_Genome_Data);
+        if (!genomeSize.exists()) {
+            return result;
+        }
+        auto numGenomes = columns.at(Id_Genome_Size).data.size() / sizeof(uint32_t);
+        result.resize(numGenomes);
+        for (auto& genome : result) {
+            uint32_t size = 0;
+            genomeSize.read(size);
+            genomeData.readRange(genome, size);
+        }
+        return result;
+    }
+
+    void pushParticle(ColumnArray& columns, ParticleDescription const& particle)
+    {
+        push<uint64_t>(columns, Id_Particle_Id, particle.id);
+        push<float>(columns, Id_Particle_PosX, particle.pos.x);
+        push<float>(columns, Id_Particle_PosY, particle.pos.y);
+        push<float>(columns, Id_Particle_VelX, particle.vel.x);
+        push<float>(columns, Id_Particle_VelY, particle.vel.y);
+        push<float>(columns, Id_Particle_Energy, particle.energy);
+        push<int32_t>(columns, Id_Particle_Color, particle.color);
+    }
+
+    class CellReader
+    {
+    public:
+        CellReader(Columns const& columns)
+            : _genomes(readGenomes(columns))
+            , _id(columns, Id_Cell_Id)
+            , _posX(columns, Id_Cell_PosX)
+            , _posY(columns, Id_Cell_PosY)
+            , _velX(columns, Id_Cell_VelX)
+            , _velY(columns, Id_Cell_VelY)
+            , _energy(columns, Id_Cell_Energy)
+            , _stiffness(columns, Id_Cell_Stiffness)
+            , _color(columns, Id_Cell_Color)
+            , _maxConnections(columns, Id_Cell_MaxConnections)
+            , _barrier(columns, Id_Cell_Barrier)
+            , _age(columns, Id_Cell_Age)
+            , _livingState(columns, Id_Cell_LivingState)
+            , _creatureId(columns, Id_Cell_CreatureId)
+            , _mutationId(columns, Id_Cell_MutationId)
+            , _ancestorMutationId(columns, Id_Cell_AncestorMutationId)
+            , _genomeComplexity(columns, Id_Cell_GenomeComplexity)
+            , _executionOrderNumber(columns, Id_Cell_ExecutionOrderNumber)
+            , _inputExecutionOrderNumber(columns, Id_Cell_InputExecutionOrderNumber)
+            , _outputBlocked(columns, Id_Cell_OutputBlocked)
+            , _cellFunction(columns, Id_Cell_CellFunction)
+            , _activityChannels(columns, Id_Cell_ActivityChannels)
+            , _activationTime(columns, Id_Cell_ActivationTime)
+            , _detectedByCreatureId(columns, Id_Cell_DetectedByCreatureId)
+            , _cellFunctionUsed(columns, Id_Cell_CellFunctionUsed)
+            , _nameSize(columns, Id_Cell_NameSize)
+            , _name(columns, Id_Cell_Name)
+            , _descriptionSize(columns, Id_Cell_DescriptionSize)
+            , _description(columns, Id_Cell_Description)
+            , _numConnections(columns, Id_Cell_NumConnections)
+            , _connectionCellId(columns, Id_Connection_CellId)
+            , _connectionDistance(columns, Id_Connection_Distance)
+            , _connectionAngleFromPrevious(columns, Id_Connection_AngleFromPrevious)
+            , _neuronWeights(columns, Id_Neuron_Weights)
+            , _neuronBiases(columns, Id_Neuron_Biases)
+            , _neuronActivationFunctions(columns, Id_Neuron_ActivationFunctions)
+            , _transmitterMode(columns, Id_Transmitter_Mode)
+            , _constructorActivationMode(columns, Id_Constructor_ActivationMode)
+            , _constructorConstructionActivationTime(columns, Id_Constructor_ConstructionActivationTime)
+            , _constructorGenomeSize(columns, Id_Constructor_GenomeSize)
+            , _constructorGenome(columns, Id_Constructor_Genome)
+            , _constructorGenomeHandle(columns, Id_Constructor_GenomeHandle)
+            , _constructorNumInheritedGenomeNodes(columns, Id_Constructor_NumInheritedGenomeNodes)
+            , _constructorGenomeGeneration(columns, Id_Constructor_GenomeGeneration)
+            , _constructorConstructionAngle1(columns, Id_Constructor_ConstructionAngle1)
+            , _constructorConstructionAngle2(columns, Id_Constructor_ConstructionAngle2)
+            , _constructorLastConstructedCellId(columns, Id_Constructor_LastConstructedCellId)
+            , _constructorGenomeCurrentNodeIndex(columns, Id_Constructor_GenomeCurrentNodeIndex)
+            , _constructorGenomeCurrentRepetition(columns, Id_Constructor_GenomeCurrentRepetition)
+            , _constructorCurrentBranch(columns, Id_Constructor_CurrentBranch)
+            , _constructorOffspringCreatureId(columns, Id_Constructor_OffspringCreatureId)
+            , _constructorOffspringMutationId(columns, Id_Constructor_OffspringMutationId)
+            , _sensorFixedAngle(columns, Id_Sensor_FixedAngle)
+            , _sensorMinDensity(columns, Id_Sensor_MinDensity)
+            , _sensorMinRange(columns, Id_Sensor_MinRange)
+            , _sensorMaxRange(columns, Id_Sensor_MaxRange)
+            , _sensorRestrictToColor(columns, Id_Sensor_RestrictToColor)
+            , _sensorRestrictToMutants(columns, Id_Sensor_RestrictToMutants)
+            , _sensorMemoryChannel1(columns, Id_Sensor_MemoryChannel1)
+            , _sensorMemoryChannel2(columns, Id_Sensor_MemoryChannel2)
+            , _sensorMemoryChannel3(columns, Id_Sensor_MemoryChannel3)
+            , _sensorTargetX(columns, Id_Sensor_TargetX)
+            , _sensorTargetY(columns, Id_Sensor_TargetY)
+            , _nervePulseMode(columns, Id_Nerve_PulseMode)
+            , _nerveAlternationMode(columns, Id_Nerve_AlternationMode)
+            , _attackerMode(columns, Id_Attacker_Mode)
+            , _injectorMode(columns, Id_Injector_Mode)
+            , _injectorCounter(columns, Id_Injector_Counter)
+            , _injectorGenomeSize(columns, Id_Injector_GenomeSize)
+            , _injectorGenome(columns, Id_Injector_Genome)
+            , _injectorGenomeHandle(columns, Id_Injector_GenomeHandle)
+            , _injectorGenomeGeneration(columns, Id_Injector_GenomeGeneration)
+            , _muscleMode(columns, Id_Muscle_Mode)
+            , _muscleLastBendingDirection(columns, Id_Muscle_LastBendingDirection)
+            , _muscleLastBendingSourceIndex(columns, Id_Muscle_LastBendingSourceIndex)
+            , _muscleConsecutiveBendingAngle(columns, Id_Muscle_ConsecutiveBendingAngle)
+            , _defenderMode(columns, Id_Defender_Mode)
+            , _reconnectorRestrictToColor(columns, Id_Reconnector_RestrictToColor)
+            , _reconnectorRestrictToMutants(columns, Id_Reconnector_RestrictToMutants)
+            , _detonatorState(columns, Id_Detonator_State)
+            , _detonatorCountdown(columns, Id_Detonator_Countdown)
+        {}
+
+        CellDescription read()
+        {
+            CellDescription result;
+            _id.read(result.id);
+            _posX.read(result.pos.x);
+            _posY.read(result.pos.y);
+            _velX.read(result.vel.x);
+            _velY.read(result.vel.y);
+            _energy.read(result.energy);
+            _stiffness.read(result.stiffness);
+            _color.read(result.color);
+            _maxConnections.read(result.maxConnections);
+            _barrier.read(result.barrier);
+            _age.read(result.age);
+            _livingState.read(result.livingState);
+            _creatureId.read(result.creatureId);
+            _mutationId.read(result.mutationId);
+            _ancestorMutationId.read(result.ancestorMutationId);
+            _genomeComplexity.read(result.genomeComplexity);
+            _executionOrderNumber.read(result.executionOrderNumber);
+            _inputExecutionOrderNumber.readOptional(result.inputExecutionOrderNumber);
+            _outputBlocked.read(result.outputBlocked);
+            for (int i = 0; i < MAX_CHANNELS; ++i) {
+                _activityChannels.read(result.activity.channels[i]);
+            }
+            _activationTime.read(result.activationTime);
+            _detectedByCreatureId.read(result.detectedByCreatureId);
+            _cellFunctionUsed.read(result.cellFunctionUsed);
+
+            uint32_t nameSize = 0;
+            _nameSize.read(nameSize);
+            _name.readRange(result.metadata.name, nameSize);
+            uint32_t descriptionSize = 0;
+            _descriptionSize.read(descriptionSize);
+            _description.readRange(result.metadata.description, descriptionSize);
+
+            uint32_t numConnections = 0;
+            _numConnections.read(numConnections);
+            if (numConnections > _connectionCellId.getNumRemainingValues()) {
+                throw std::runtime_error("Inconsistent number of connections.");
+            }
+            result.connections.resize(numConnections);
+            for (auto& connection : result.connections) {
+                _connectionCellId.read(connection.cellId);
+                _connectionDistance.read(connection.distance);
+                _connectionAngleFromPrevious.read(connection.angleFromPrevious);
+            }
+
+            uint8_t cellFunctionType = CellFunction_None;
+            _cellFunction.read(cellFunctionType);
+            switch (cellFunctionType) {
+            case CellFunction_Neuron: {
+                NeuronDescription neuron;
+                for (int row = 0; row < MAX_CHANNELS; ++row) {
+                    for (int col = 0; col < MAX_CHANNELS; ++col) {
+                        _neuronWeights.read(neuron.weights[row][col]);
+                    }
+                }
+                for (int i = 0; i < MAX_CHANNELS; ++i) {
+                    _neuronBiases.read(neuron.biases[i]);
+                }
+                for (int i = 0; i < MAX_CHANNELS; ++i) {
+                    _neuronActivationFunctions.read(neuron.activationFunctions[i]);
+                }
+                result.cellFunction = neuron;
+            } break;
+            case CellFunction_Transmitter: {
+                TransmitterDescription transmitter;
+                _transmitterMode.read(transmitter.mode);
+                result.cellFunction = transmitter;
+            } break;
+            case CellFunction_Constructor: {
+                ConstructorDescription constructor;
+                _constructorActivationMode.read(constructor.activationMode);
+                _constructorConstructionActivationTime.read(constructor.constructionActivationTime);
+                readGenome(constructor.genome, _constructorGenomeHandle, _constructorGenomeSize, _constructorGenome);
+                _constructorNumInheritedGenomeNodes.read(constructor.numInheritedGenomeNodes);
+                _constructorGenomeGeneration.read(constructor.genomeGeneration);
+                _constructorConstructionAngle1.read(constructor.constructionAngle1);
+                _constructorConstructionAngle2.read(constructor.constructionAngle2);
+                _constructorLastConstructedCellId.read(constructor.lastConstructedCellId);
+                _constructorGenomeCurrentNodeIndex.read(constructor.genomeCurrentNodeIndex);
+                _constructorGenomeCurrentRepetition.read(constructor.genomeCurrentRepetition);
+                _constructorCurrentBranch.read(constructor.currentBranch);
+                _constructorOffspringCreatureId.read(constructor.offspringCreatureId);
+                _constructorOffspringMutationId.read(constructor.offspringMutationId);
+                result.cellFunction = constructor;
+            } break;
+            case CellFunction_Sensor: {
+                SensorDescription sensor;
+                _sensorFixedAngle.readOptional(sensor.fixedAngle);
+                _sensorMinDensity.read(sensor.minDensity);
+                _sensorMinRange.readOptional(sensor.minRange);
+                _sensorMaxRange.readOptional(sensor.maxRange);
+                _sensorRestrictToColor.readOptional(sensor.restrictToColor);
+                _sensorRestrictToMutants.read(sensor.restrictToMutants);
+                _sensorMemoryChannel1.read(sensor.memoryChannel1);
+                _sensorMemoryChannel2.read(sensor.memoryChannel2);
+                _sensorMemoryChannel3.read(sensor.memoryChannel3);
+                _sensorTargetX.read(sensor.targetX);
+                _sensorTargetY.read(sensor.targetY);
+                result.cellFunction = sensor;
+            } break;
+            case CellFunction_Nerve: {
+                NerveDescription nerve;
+                _nervePulseMode.read(nerve.pulseMode);
+                _nerveAlternationMode.read(nerve.alternationMode);
+                result.cellFunction = nerve;
+            } break;
+            case CellFunction_Attacker: {
+                AttackerDescription attacker;
+                _attackerMode.read(attacker.mode);
+                result.cellFunction = attacker;
+            } break;
+            case CellFunction_Injector: {
+                InjectorDescription injector;
+                _injectorMode.read(injector.mode);
+                _injectorCounter.read(injector.counter);
+                readGenome(injector.genome, _injectorGenomeHandle, _injectorGenomeSize, _injectorGenome);
+                _injectorGenomeGeneration.read(injector.genomeGeneration);
+                result.cellFunction = injector;
+            } break;
+            case CellFunction_Muscle: {
+                MuscleDescription muscle;
+                _muscleMode.read(muscle.mode);
+                _muscleLastBendingDirection.read(muscle.lastBendingDirection);
+                _muscleLastBendingSourceIndex.read(muscle.lastBendingSourceIndex);
+                _muscleConsecutiveBendingAngle.read(muscle.consecutiveBendingAngle);
+                result.cellFunction = muscle;
+            } break;
+            case CellFunction_Defender: {
+                DefenderDescription defender;
+                _defenderMode.read(defender.mode);
+                result.cellFunction = defender;
+            } break;
+            case CellFunction_Reconnector: {
+                ReconnectorDescription reconnector;
+                _reconnectorRestrictToColor.readOptional(reconnector.restrictToColor);
+                _reconnectorRestrictToMutants.read(reconnector.restrictToMutants);
+                result.cellFunction = reconnector;
+            } break;
+            case CellFunction_Detonator: {
+                DetonatorDescription detonator;
+                _detonatorState.read(detonator.state);
+                _detonatorCountdown.read(detonator.countdown);
+                result.cellFunction = detonator;
+            } break;
+            }
+            return result;
+        }
+
+    private:
+        void readGenome(
+            std::vector<uint8_t>& target,
+            ColumnReader<uint32_t>& handleColumn,
+            ColumnReader<uint32_t>& sizeColumn,
+            ColumnReader<uint8_t>& inlineColumn)
+        {
+            if (handleColumn.exists()) {
+                uint32_t handle = 0;
+                handleColumn.read(handle);
+                if (handle >= _genomes.size()) {
+                    throw std::runtime_error("Invalid genome handle.");
+                }
+                target = _genomes[handle];
+            } else {
+                uint32_t genomeSize = 0;
+                sizeColumn.read(genomeSize);
+                inlineColumn.readRange(target, genomeSize);
+            }
+        }
+
+        std::vector<std::vector<uint8_t>> _genomes;
+
+        ColumnReader<uint64_t> _id;
+        ColumnReader<float> _posX;
+        ColumnReader<float> _posY;
+        ColumnReader<float> _velX;
+        ColumnReader<float> _velY;
+        ColumnReader<float> _energy;
+        ColumnReader<float> _stiffness;
+        ColumnReader<int32_t> _color;
+        ColumnReader<int32_t> _maxConnections;
+        ColumnReader<uint8_t> _barrier;
+        ColumnReader<int32_t> _age;
+        ColumnReader<int32_t> _livingState;
+        ColumnReader<int32_t> _creatureId;
+        ColumnReader<int32_t> _mutationId;
+        ColumnReader<uint8_t> _ancestorMutationId;
+        ColumnReader<float> _genomeComplexity;
+        ColumnReader<int32_t> _executionOrderNumber;
+        ColumnReader<int32_t> _inputExecutionOrderNumber;
+        ColumnReader<uint8_t> _outputBlocked;
+        ColumnReader<uint8_t> _cellFunction;
+        ColumnReader<float> _activityChannels;
+        ColumnReader<int32_t> _activationTime;
+        ColumnReader<uint8_t> _detectedByCreatureId;
+        ColumnReader<uint8_t> _cellFunctionUsed;
+        ColumnReader<uint32_t> _nameSize;
+        ColumnReader<uint8_t> _name;
+        ColumnReader<uint32_t> _descriptionSize;
+        ColumnReader<uint8_t> _description;
+        ColumnReader<uint32_t> _numConnections;
+        ColumnReader<uint64_t> _connectionCellId;
+        ColumnReader<float> _connectionDistance;
+        ColumnReader<float> _connectionAngleFromPrevious;
+        ColumnReader<float> _neuronWeights;
+        ColumnReader<float> _neuronBiases;
+        ColumnReader<int32_t> _neuronActivationFunctions;
+        ColumnReader<int32_t> _transmitterMode;
+        ColumnReader<int32_t> _constructorActivationMode;
+        ColumnReader<int32_t> _constructorConstructionActivationTime;
+        ColumnReader<uint32_t> _constructorGenomeSize;
+        ColumnReader<uint8_t> _constructorGenome;
+        ColumnReader<uint32_t> _constructorGenomeHandle;
+        ColumnReader<int32_t> _constructorNumInheritedGenomeNodes;
+        ColumnReader<int32_t> _constructorGenomeGeneration;
+        ColumnReader<float> _constructorConstructionAngle1;
+        ColumnReader<float> _constructorConstructionAngle2;
+        ColumnReader<uint64_t> _constructorLastConstructedCellId;
+        ColumnReader<int32_t> _constructorGenomeCurrentNodeIndex;
+        ColumnReader<int32_t> _constructorGenomeCurrentRepetition;
+        ColumnReader<int32_t> _constructorCurrentBranch;
+        ColumnReader<int32_t> _constructorOffspringCreatureId;
+        ColumnReader<int32_t> _constructorOffspringMutationId;
+        ColumnReader<float> _sensorFixedAngle;
+        ColumnReader<float> _sensorMinDensity;
+        ColumnReader<int32_t> _sensorMinRange;
+        ColumnReader<int32_t> _sensorMaxRange;
+        ColumnReader<int32_t> _sensorRestrictToColor;
+        ColumnReader<int32_t> _sensorRestrictToMutants;
+        ColumnReader<float> _sensorMemoryChannel1;
+        ColumnReader<float> _sensorMemoryChannel2;
+        ColumnReader<float> _sensorMemoryChannel3;
+        ColumnReader<float> _sensorTargetX;
+        ColumnReader<float> _sensorTargetY;
+        ColumnReader<int32_t> _nervePulseMode;
+        ColumnReader<int32_t> _nerveAlternationMode;
+        ColumnReader<int32_t> _attackerMode;
+        ColumnReader<int32_t> _injectorMode;
+        ColumnReader<int32_t> _injectorCounter;
+        ColumnReader<uint32_t> _injectorGenomeSize;
+        ColumnReader<uint8_t> _injectorGenome;
+        ColumnReader<uint32_t> _injectorGenomeHandle;
+        ColumnReader<int32_t> _injectorGenomeGeneration;
+        ColumnReader<int32_t> _muscleMode;
+        ColumnReader<int32_t> _muscleLastBendingDirection;
+        ColumnReader<int32_t> _muscleLastBendingSourceIndex;
+        ColumnReader<float> _muscleConsecutiveBendingAngle;
+        ColumnReader<int32_t> _defenderMode;
+        ColumnReader<int32_t> _reconnectorRestrictToColor;
+        ColumnReader<int32_t> _reconnectorRestrictToMutants;
+        ColumnReader<int32_t> _detonatorState;
+        ColumnReader<int32_t> _detonatorCountdown;
+    };
+
+    class ParticleReader
+    {
+    public:
+        ParticleReader(Columns const& columns)
+            : _id(columns, Id_Particle_Id)
+            , _posX(columns, Id_Particle_PosX)
+            , _posY(columns, Id_Particle_PosY)
+            , _velX(columns, Id_Particle_VelX)
+            , _velY(columns, Id_Particle_VelY)
+            , _energy(columns, Id_Particle_Energy)
+            , _color(columns, Id_Particle_Color)
+        {}
+
+        ParticleDescription read()
+        {
+            ParticleDescription result;
+            _id.read(result.id);
+            _posX.read(result.pos.x);
+            _posY.read(result.pos.y);
+            _velX.read(result.vel.x);
+            _velY.read(result.vel.y);
+            _energy.read(result.energy);
+            _color.read(result.color);
+            return result;
+        }
+
+    private:
+        ColumnReader<uint64_t> _id;
+        ColumnReader<float> _posX;
+        ColumnReader<float> _posY;
+        ColumnReader<float> _velX;
+        ColumnReader<float> _velY;
+        ColumnReader<float> _energy;
+        ColumnReader<int32_t> _color;
+    };
+}
+
+bool ColumnarSerializerService::isColumnarFormat(std::istream& stream)
+{
+    return stream.peek() == Magic[0];
+}
+
+void ColumnarSerializerService::serialize(ClusteredDataDescription const& data, std::ostream& stream)
+{
+    std::vector<ClusterDescription const*> clusters;
+    clusters.reserve(data.clusters.size());
+    for (auto const& cluster : data.clusters) {
+        clusters.emplace_back(&cluster);
+    }
+    std::vector<ParticleDescription const*> particles;
+    particles.reserve(data.particles.size());
+    for (auto const& particle : data.particles) {
+        particles.emplace_back(&particle);
+    }
+    serialize(clusters, particles, stream);
+}
+
+void ColumnarSerializerService::serialize(
+    std::span<ClusterDescription const* const> clusters,
+    std::span<ParticleDescription const* const> particles,
+    std::ostream& stream)
+{
+    ColumnArray columns(NumColumnIds);
+    GenomePool genomePool;
+    uint64_t numCells = 0;
+    for (auto const& cluster : clusters) {
+        push<uint32_t>(columns, Id_Cluster_NumCells, static_cast<uint32_t>(cluster->cells.size()));
+        for (auto const& cell : cluster->cells) {
+            pushCell(columns, genomePool, cell);
+        }
+        numCells += cluster->cells.size();
+    }
+    pushGenomes(columns, genomePool);
+    for (auto const& particle : particles) {
+        pushParticle(columns, *particle);
+    }
+
+    //header
+    stream.write(Magic, sizeof(Magic));
+    write(stream, FormatVersion);
+    writeString(stream, Const::ProgramVersion);
+    write(stream, static_cast<uint64_t>(clusters.size()));
+    write(stream, numCells);
+    write(stream, static_cast<uint64_t>(particles.size()));
+
+    //schema
+    write(stream, static_cast<uint32_t>(std::ranges::count_if(columns, [](auto const& column) { return column.has_value(); })));
+    for (int id = 0; id < NumColumnIds; ++id) {
+        if (auto const& column = columns[id]) {
+            write(stream, static_cast<uint16_t>(id));
+            write(stream, static_cast<uint8_t>(column->type));
+            write(stream, static_cast<uint64_t>(column->data.size()));
+        }
+    }
+
+    //content
+    for (auto const& column : columns) {
+        if (column) {
+            stream.write(reinterpret_cast<char const*>(column->data.data()), column->data.size());
+        }
+    }
+}
+
+void ColumnarSerializerService::deserialize(ClusteredDataDescription& data, std::istream& stream)
+{
+    //header
+    char magic[sizeof(Magic)];
+    if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0) {
+        throw std::runtime_error("No columnar format detected.");
+    }
+    if (read<uint32_t>(stream) > FormatVersion) {
+        throw std::runtime_error("Format version not supported.");
+    }
+    auto version = readString(stream);
+    if (!VersionChecker::isVersionValid(version)) {
+        throw std::runtime_error("No version detected.");
+    }
+    if (VersionChecker::isVersionOutdated(version)) {
+        throw std::runtime_error("Version not supported.");
+    }
+    auto numClusters = read<uint64_t>(stream);
+    auto numCells = read<uint64_t>(stream);
+    auto numParticles = read<uint64_t>(stream);
+
+    //schema
+    struct SchemaEntry
+    {
+        int id;
+        ColumnType type;
+        uint64_t size;
+    };
+    auto constexpr SchemaEntrySize = sizeof(uint16_t) + sizeof(uint8_t) + sizeof(uint64_t);
+    auto numSchemaEntries = read<uint32_t>(stream);
+    auto remainingSize = getRemainingSize(stream);
+    if (remainingSize && numSchemaEntries * SchemaEntrySize > *remainingSize) {
+        throw std::runtime_error("Schema exceeds stream.");
+    }
+    std::vector<SchemaEntry> schema(numSchemaEntries);
+    uint64_t contentSize = 0;
+    for (auto& entry : schema) {
+        entry.id = read<uint16_t>(stream);
+        entry.type = static_cast<ColumnType>(read<uint8_t>(stream));
+        entry.size = read<uint64_t>(stream);
+        contentSize += std::min(entry.size, std::numeric_limits<uint64_t>::max() - contentSize);
+    }
+    if (remainingSize && contentSize > *remainingSize - numSchemaEntries * SchemaEntrySize) {
+        throw std::runtime_error("Columns exceed stream.");
+    }
+
+    //content
+    Columns columns;
+    for (auto const& entry : schema) {
+        auto& column = columns[entry.id];
+        column.type = entry.type;
+        readBytes(stream, column.data, entry.size);
+    }
+
+    //the counts are checked against the columns before memory is reserved
+    auto getNumValues = [&](int id, size_t valueSize) { return columns.contains(id) ? columns.at(id).data.size() / valueSize : 0; };
+    if (numClusters > getNumValues(Id_Cluster_NumCells, sizeof(uint32_t)) || numCells > getNumValues(Id_Cell_Id, sizeof(uint64_t))
+        || numParticles > getNumValues(Id_Particle_Id, sizeof(uint64_t))) {
+        throw std::runtime_error("Inconsistent number of entities.");
+    }
+
+    data.clear();
+    data.clusters.reserve(numClusters);
+    data.particles.reserve(numParticles);
+
+    ColumnReader<uint32_t> clusterNumCells(columns, Id_Cluster_NumCells);
+    CellReader cellReader(columns);
+    uint64_t cellCount = 0;
+    for (uint64_t i = 0; i < numClusters; ++i) {
+        uint32_t clusterSize = 0;
+        clusterNumCells.read(clusterSize);
+        cellCount += clusterSize;
+        if (cellCount > numCells) {
+            throw std::runtime_error("Inconsistent number of cells.");
+        }
+        ClusterDescription cluster;
+        cluster.cells.reserve(clusterSize);
+        for (uint32_t j = 0; j < clusterSize; ++j) {
+            cluster.cells.emplace_back(cellReader.read());
+        }
+        data.clusters.emplace_back(std::move(cluster));
+    }
+
+    ParticleReader particleReader(columns);
+    for (uint64_t i = 0; i < numParticles; ++i) {
+        data.particles.emplace_back(particleReader.read());
+    }
+}
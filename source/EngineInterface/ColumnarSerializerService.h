@@ -0,0 +1,26 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <span>
+
+#include "Definitions.h"
+#include "Descriptions.h"
+
+/**
+ * Binary format which stores a ClusteredDataDescription as typed columns (one column per field).
+ * The field ids are written once in a schema header. Columns which are missing in a file are loaded with default values and unknown
+ * columns are skipped, i.e. the schema can be extended without breaking older files.
+ * Byte-identical genomes are written only once in a genome table and referenced by the cells via handles.
+ */
+class ColumnarSerializerService
+{
+public:
+    //checks the first byte of the stream without consuming it
+    static bool isColumnarFormat(std::istream& stream);
+
+    static void serialize(ClusteredDataDescription const& data, std::ostream& stream);
+    static void
+    serialize(std::span<ClusterDescription const* const> clusters, std::span<ParticleDescription const* const> particles, std::ostream& stream);
+    static void deserialize(ClusteredDataDescription& data, std::istream& stream);
+};
@@ -0,0 +1,56 @@
+#include "CompressionService.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <zlib.h>
+#include <zstd.h>
+
+std::vector<char> CompressionService::compress(std::string_view data, CompressionSettings const& settings)
+{
+    std::vector<char> result;
+    if (settings.codec == CompressionCodec_Zstd) {
+        result.resize(ZSTD_compressBound(data.size()));
+        auto size = ZSTD_compress(result.data(), result.size(), data.data(), data.size(), std::clamp(settings.level, 1, ZSTD_maxCLevel()));
+        if (ZSTD_isError(size)) {
+            throw std::runtime_error("Zstd compression failed.");
+        }
+        result.resize(size);
+    } else if (settings.codec == CompressionCodec_Deflate) {
+        auto size = compressBound(static_cast<uLong>(data.size()));
+        result.resize(size);
+        auto status = compress2(
+            reinterpret_cast<Bytef*>(result.data()),
+            &size,
+            reinterpret_cast<Bytef const*>(data.data()),
+            static_cast<uLong>(data.size()),
+            std::clamp(settings.level, 1, 9));
+        if (status != Z_OK) {
+            throw std::runtime_error("Deflate compression failed.");
+        }
+        result.resize(size);
+    } else {
+        throw std::runtime_error("Unknown compression codec.");
+    }
+    return result;
+}
+
+std::vector<char> CompressionService::decompress(std::span<char const> data, size_t uncompressedSize, CompressionCodec codec)
+{
+    std::vector<char> result(uncompressedSize);
+    if (codec == CompressionCodec_Zstd) {
+        auto size = ZSTD_decompress(result.data(), result.size(), data.data(), data.size());
+        if (ZSTD_isError(size) || size != result.size()) {
+            throw std::runtime_error("Zstd decompression failed.");
+        }
+    } else if (codec == CompressionCodec_Deflate) {
+        auto size = static_cast<uLongf>(result.size());
+        auto status = uncompress(reinterpret_cast<Bytef*>(result.data()), &size, reinterpret_cast<Bytef const*>(data.data()), static_cast<uLong>(data.size()));
+        if (status != Z_OK || size != result.size()) {
+            throw std::runtime_error("Deflate decompression failed.");
+        }
+    } else {
+        throw std::runtime_error("Unknown compression codec.");
+    }
+    return result;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "CompressionSettings.h"
+
+class CompressionService
+{
+public:
+    static std::vector<char> compress(std::string_view data, CompressionSettings const& settings);
+
+    //uncompressedSize must be known from the container, the result is checked against it
+    static std::vector<char> decompress(std::span<char const> data, size_t uncompressedSize, CompressionCodec codec);
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+using CompressionCodec = int;
+enum CompressionCodec_
+{
+    CompressionCodec_Zstd,
+    CompressionCodec_Deflate
+};
+
+struct CompressionSettings
+{
+    CompressionCodec codec = CompressionCodec_Zstd;
+    int level = 3;  //zstd: 1-22, deflate: 1-9
+
+    bool operator==(CompressionSettings const&) const = default;
+};
@@ -0,0 +1,290 @@
+#include "DeltaSnapshotService.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Base/LoggingService.h"
+
+#include "ChunkedSerializerService.h"
+
+namespace
+{
+    char const Magic[] = {'A', 'L', 'I', 'E', 'N', 'D', 'L', 'T'};
+    uint32_t constexpr DeltaVersion = 1;
+
+    template <typename T>
+    void write(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T read(std::istream& stream)
+    {
+        T result;
+        if (!stream.read(reinterpret_cast<char*>(&result), sizeof(T))) {
+            throw std::runtime_error("Unexpected end of stream.");
+        }
+        return result;
+    }
+
+    void writeIds(std::ostream& stream, std::vector<uint64_t> const& ids)
+    {
+        write(stream, static_cast<uint64_t>(ids.size()));
+        stream.write(reinterpret_cast<char const*>(ids.data()), ids.size() * sizeof(uint64_t));
+    }
+
+    std::vector<uint64_t> readIds(std::istream& stream)
+    {
+        std::vector<uint64_t> result(read<uint64_t>(stream));
+        if (!stream.read(reinterpret_cast<char*>(result.data()), result.size() * sizeof(uint64_t))) {
+            throw std::runtime_error("Unexpected end of stream.");
+        }
+        return result;
+    }
+
+    template <typename Object>
+    void calcChanges(std::vector<Object> const& previous, std::vector<Object> const& current, std::vector<Object>& changed, std::vector<uint64_t>& removedIds)
+    {
+        std::unordered_map<uint64_t, Object const*> previousById;
+        previousById.reserve(previous.size());
+        for (auto const& object : previous) {
+            previousById.emplace(object.id, &object);
+        }
+        for (auto const& object : current) {
+            auto findResult = previousById.find(object.id);
+            if (findResult == previousById.end()) {
+                changed.emplace_back(object);
+            } else {
+                if (!(*findResult->second == object)) {
+                    changed.emplace_back(object);
+                }
+                previousById.erase(findResult);
+            }
+        }
+        for (auto const& object : previous) {
+            if (previousById.contains(object.id)) {
+                removedIds.emplace_back(object.id);
+            }
+        }
+    }
+
+    template <typename Object>
+    void applyChanges(std::vector<Object>& objects, std::vector<Object> const& changed, std::vector<uint64_t> const& removedIds)
+    {
+        std::unordered_set<uint64_t> removedIdSet(removedIds.begin(), removedIds.end());
+        std::erase_if(objects, [&](Object const& object) { return removedIdSet.contains(object.id); });
+
+        std::unordered_map<uint64_t, size_t> indexById;
+        indexById.reserve(objects.size());
+        for (size_t i = 0; i < objects.size(); ++i) {
+            indexById.emplace(objects[i].id, i);
+        }
+        for (auto const& object : changed) {
+            auto findResult = indexById.find(object.id);
+            if (findResult != indexById.end()) {
+                objects[findResult->second] = object;
+            } else {
+                objects.emplace_back(object);
+            }
+        }
+    }
+
+    size_t findRoot(std::vector<size_t>& parents, size_t index)
+    {
+        while (parents[index] != index) {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
+        }
+        return index;
+    }
+}
+
+DeltaSnapshot DeltaSnapshotService::calcDelta(DataDescription const& previous, DataDescription const& current)
+{
+    DeltaSnapshot result;
+    calcChanges(previous.cells, current.cells, result.changedCells, result.removedCellIds);
+    calcChanges(previous.particles, current.particles, result.changedParticles, result.removedParticleIds);
+    return result;
+}
+
+void DeltaSnapshotService::applyDelta(DataDescription& data, DeltaSnapshot const& delta)
+{
+    applyChanges(data.cells, delta.changedCells, delta.removedCellIds);
+    applyChanges(data.particles, delta.changedParticles, delta.removedParticleIds);
+}
+
+ClusteredDataDescription DeltaSnapshotService::createClusteredData(DataDescription const& data)
+{
+    std::unordered_map<uint64_t, size_t> indexById;
+    indexById.reserve(data.cells.size());
+    for (size_t i = 0; i < data.cells.size(); ++i) {
+        indexById.emplace(data.cells[i].id, i);
+    }
+
+    //union-find on the connections
+    std::vector<size_t> parents(data.cells.size());
+    std::iota(parents.begin(), parents.end(), 0);
+    for (size_t i = 0; i < data.cells.size(); ++i) {
+        for (auto const& connection : data.cells[i].connections) {
+            auto findResult = indexById.find(connection.cellId);
+            if (findResult != indexById.end()) {
+                auto root1 = findRoot(parents, i);
+                auto root2 = findRoot(parents, findResult->second);
+                if (root1 != root2) {
+                    parents[std::max(root1, root2)] = std::min(root1, root2);
+                }
+            }
+        }
+    }
+
+    ClusteredDataDescription result;
+    std::unordered_map<size_t, size_t> clusterIndexByRoot;
+    for (size_t i = 0; i < data.cells.size(); ++i) {
+        auto root = findRoot(parents, i);
+        auto [iter, inserted] = clusterIndexByRoot.emplace(root, result.clusters.size());
+        if (inserted) {
+            result.clusters.emplace_back();
+        }
+        result.clusters[iter->second].cells.emplace_back(data.cells[i]);
+    }
+    result.particles = data.particles;
+    return result;
+}
+
+bool DeltaSnapshotService::serializeDeltaToFile(std::string const& filename, DeltaSnapshot const& delta)
+{
+    try {
+        std::ofstream stream(filename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        stream.write(Magic, sizeof(Magic));
+        write(stream, DeltaVersion);
+        writeIds(stream, delta.removedCellIds);
+        writeIds(stream, delta.removedParticleIds);
+
+        //changed objects are stored as chunked container (one cluster per cell since they are not necessarily connected)
+        ClusteredDataDescription changedData;
+        changedData.clusters.reserve(delta.changedCells.size());
+        for (auto const& cell : delta.changedCells) {
+            changedData.addCluster(ClusterDescription().addCell(cell));
+        }
+        changedData.particles = delta.changedParticles;
+        ChunkedSerializerService::serialize(changedData, stream);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool DeltaSnapshotService::deserializeDeltaFromFile(DeltaSnapshot& delta, std::string const& filename)
+{
+    try {
+        std::ifstream stream(filename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        char magic[sizeof(Magic)];
+        if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0) {
+            return false;
+        }
+        if (read<uint32_t>(stream) > DeltaVersion) {
+            return false;
+        }
+        delta = DeltaSnapshot();
+        delta.removedCellIds = readIds(stream);
+        delta.removedParticleIds = readIds(stream);
+
+        ClusteredDataDescription changedData;
+        ChunkedSerializerService::deserialize(changedData, stream);
+        for (auto& cluster : changedData.clusters) {
+            std::move(cluster.cells.begin(), cluster.cells.end(), std::back_inserter(delta.changedCells));
+        }
+        delta.changedParticles = std::move(changedData.particles);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+std::string DeltaSnapshotService::getDeltaFilename(std::string const& baseFilename, int index)
+{
+    std::filesystem::path result(baseFilename);
+    result.replace_extension(std::filesystem::path(".checkpoint" + std::to_string(index) + ".delta"));
+    return result.string();
+}
+
+int DeltaSnapshotService::getNumDeltaFiles(std::string const& baseFilename)
+{
+    int result = 0;
+    while (std::filesystem::exists(getDeltaFilename(baseFilename, result + 1))) {
+        ++result;
+    }
+    return result;
+}
+
+bool DeltaSnapshotService::serializeCheckpointToFiles(std::string const& baseFilename, DeltaSnapshot const& delta, DeserializedSimulation const& auxiliaryData)
+{
+    auto filename = getDeltaFilename(baseFilename, getNumDeltaFiles(baseFilename) + 1);
+    log(Priority::Important, "save checkpoint to " + filename);
+    return serializeDeltaToFile(filename, delta) && SerializerService::serializeAuxiliaryDataToFiles(filename, auxiliaryData);
+}
+
+bool DeltaSnapshotService::restoreCheckpoint(DeserializedSimulation& data, std::string const& baseFilename, std::optional<int> const& numDeltas)
+{
+    if (!SerializerService::deserializeSimulationFromFiles(data, baseFilename)) {
+        return false;
+    }
+    auto numDeltasToApply = numDeltas.value_or(getNumDeltaFiles(baseFilename));
+    if (numDeltasToApply == 0) {
+        return true;
+    }
+
+    DataDescription flatData(data.mainData);
+    for (int i = 1; i <= numDeltasToApply; ++i) {
+        auto filename = getDeltaFilename(baseFilename, i);
+        DeltaSnapshot delta;
+        if (!deserializeDeltaFromFile(delta, filename)) {
+            return false;
+        }
+        applyDelta(flatData, delta);
+        if (i == numDeltasToApply && !SerializerService::deserializeAuxiliaryDataFromFiles(data, filename)) {
+            return false;
+        }
+    }
+    data.mainData = createClusteredData(flatData);
+    return true;
+}
+
+bool DeltaSnapshotService::compact(std::string const& baseFilename)
+{
+    if (getNumDeltaFiles(baseFilename) == 0) {
+        return true;
+    }
+    DeserializedSimulation data;
+    if (!restoreCheckpoint(data, baseFilename)) {
+        return false;
+    }
+    if (!SerializerService::serializeSimulationToFiles(baseFilename, data)) {
+        return false;
+    }
+    removeDeltaFiles(baseFilename);
+    return true;
+}
+
+void DeltaSnapshotService::removeDeltaFiles(std::string const& baseFilename)
+{
+    std::error_code error;
+    for (int i = 1; std::filesystem::exists(getDeltaFilename(baseFilename, i)); ++i) {
+        std::filesystem::path filename(getDeltaFilename(baseFilename, i));
+        std::filesystem::remove(filename, error);
+        std::filesystem::remove(std::filesystem::path(filename).replace_extension(".settings.json"), error);
+        std::filesystem::remove(std::filesystem::path(filename).replace_extension(".statistics.bin"), error);
+    }
+}
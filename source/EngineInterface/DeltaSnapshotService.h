@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Descriptions.h"
+#include "SerializerService.h"
+
+//changes of the simulation data relative to a previous state, objects are identified by their ids
+struct DeltaSnapshot
+{
+    std::vector<CellDescription> changedCells;  //added or modified cells
+    std::vector<uint64_t> removedCellIds;
+    std::vector<ParticleDescription> changedParticles;  //added or modified particles
+    std::vector<uint64_t> removedParticleIds;
+
+    bool isEmpty() const
+    {
+        return changedCells.empty() && removedCellIds.empty() && changedParticles.empty() && removedParticleIds.empty();
+    }
+};
+
+/**
+ * A checkpoint consists of a base simulation file followed by delta files "<base>.checkpoint<n>.delta" (n = 1, 2, ...), each of which
+ * contains the changes relative to the previous checkpoint and is accompanied by its own settings and statistics file.
+ */
+class DeltaSnapshotService
+{
+public:
+    static DeltaSnapshot calcDelta(DataDescription const& previous, DataDescription const& current);
+    static void applyDelta(DataDescription& data, DeltaSnapshot const& delta);
+
+    //groups the cells into clusters of connected cells
+    static ClusteredDataDescription createClusteredData(DataDescription const& data);
+
+    static bool serializeDeltaToFile(std::string const& filename, DeltaSnapshot const& delta);
+    static bool deserializeDeltaFromFile(DeltaSnapshot& delta, std::string const& filename);
+
+    static std::string getDeltaFilename(std::string const& baseFilename, int index);
+    static int getNumDeltaFiles(std::string const& baseFilename);
+
+    //appends a delta file (and its settings and statistics file) to the checkpoints of a base file
+    static bool serializeCheckpointToFiles(std::string const& baseFilename, DeltaSnapshot const& delta, DeserializedSimulation const& auxiliaryData);
+
+    //loads the base file and replays the deltas up to the given checkpoint (all if not specified)
+    static bool restoreCheckpoint(DeserializedSimulation& data, std::string const& baseFilename, std::optional<int> const& numDeltas = std::nullopt);
+
+    //folds all deltas into the base file
+    static bool compact(std::string const& baseFilename);
+    static void removeDeltaFiles(std::string const& baseFilename);
+};
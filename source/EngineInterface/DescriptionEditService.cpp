@@ -7,9 +7,13 @@
 #include "Base/NumberGenerator.h"
 #include "Base/Math.h"
 #include "GenomeDescriptions.h"
-#include "SpaceCalculator.h"
 #include "GenomeDescriptionService.h"
 
+namespace
+{
+    auto constexpr OverlappingDistance = 2.0f;
+}
+
 DataDescription DescriptionEditService::createRect(CreateRectParameters const& parameters)
 {
     DataDescription result;
@@ -200,40 +204,6 @@ void DescriptionEditService::duplicate(ClusteredDataDescription& data, IntVector
     data = result;
 }
 
-namespace
-{
-    std::vector<int> getCellIndicesWithinRadius(
-        DataDescription const& data,
-        std::unordered_map<int, std::unordered_map<int, std::vector<int>>> const& cellIndicesBySlot,
-        RealVector2D const& pos,
-        float radius)
-    {
-        std::vector<int> result;
-        IntVector2D upperLeftIntPos{toInt(pos.x - radius - 0.5f), toInt(pos.y - radius - 0.5f)};
-        IntVector2D lowerRightIntPos{toInt(pos.x + radius + 0.5f), toInt(pos.y + radius + 0.5f)};
-        for (int x = upperLeftIntPos.x; x <= lowerRightIntPos.x; ++x) {
-            for (int y = upperLeftIntPos.y; y <= lowerRightIntPos.y; ++y) {
-                if (cellIndicesBySlot.find(x) != cellIndicesBySlot.end()) {
-                    if (cellIndicesBySlot.at(x).find(y) != cellIndicesBySlot.at(x).end()) {
-                        for (auto const& cellIndex : cellIndicesBySlot.at(x).at(y)) {
-                            auto const& cell = data.cells.at(cellIndex);
-                            if (Math::length(cell.pos - pos) <= radius) {
-                                result.emplace_back(cellIndex);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        std::sort(result.begin(), result.end(), [&](int index1, int index2) {
-            auto const& cell1 = data.cells.at(index1);
-            auto const& cell2 = data.cells.at(index2);
-            return Math::length(cell1.pos - pos) < Math::length(cell2.pos - pos);
-        });
-        return result;
-    }
-}
-
 DataDescription DescriptionEditService::gridMultiply(DataDescription const& input, GridMultiplyParameters const& parameters)
 {
     DataDescription result;
@@ -271,30 +241,30 @@ DataDescription DescriptionEditService::randomMultiply(
     bool& overlappingCheckSuccessful)
 {
     overlappingCheckSuccessful = true;
-    SpaceCalculator spaceCalculator(worldSize);
-    std::unordered_map<IntVector2D, std::vector<RealVector2D>> cellPosBySlot;
 
-    //create map for overlapping check
+    //create grid for overlapping check
+    std::optional<SpatialGrid> cellGrid;
     if (parameters._overlappingCheck) {
-        int index = 0;
+        std::vector<RealVector2D> existentCellPositions;
+        existentCellPositions.reserve(existentData.cells.size());
         for (auto const& cell : existentData.cells) {
-            auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-            cellPosBySlot[intPos].emplace_back(cell.pos);
-            ++index;
+            existentCellPositions.emplace_back(cell.pos);
         }
+        cellGrid.emplace(existentCellPositions, OverlappingDistance, worldSize);
     }
 
     //do multiplication
     DataDescription result = input;
     generateNewIds(result);
+    auto inputWithoutMetadata = input;
+    removeMetadata(inputWithoutMetadata);
     auto& numberGen = NumberGenerator::getInstance();
     for (int i = 0; i < parameters._number; ++i) {
         bool overlapping = false;
         DataDescription copy;
         int attempts = 0;
         do {
-            copy = input;
-            removeMetadata(copy);
+            copy = inputWithoutMetadata;
             copy.shift({toFloat(numberGen.getRandomReal(0, toInt(worldSize.x))), toFloat(numberGen.getRandomReal(0, toInt(worldSize.y)))});
             copy.rotate(toInt(numberGen.getRandomReal(parameters._minAngle, parameters._maxAngle)));
             copy.accelerate(
@@ -303,15 +273,8 @@ DataDescription DescriptionEditService::randomMultiply(
                 toFloat(numberGen.getRandomReal(parameters._minAngularVel, parameters._maxAngularVel)));
 
             //overlapping check
-            overlapping = false;
-            if (parameters._overlappingCheck) {
-                for (auto const& cell : copy.cells) {
-                    auto pos = spaceCalculator.getCorrectedPosition(cell.pos);
-                    if (isCellPresent(cellPosBySlot, spaceCalculator, pos, 2.0f)) {
-                        overlapping = true;
-                    }
-                }
-            }
+            overlapping =
+                cellGrid && std::ranges::any_of(copy.cells, [&](CellDescription const& cell) { return cellGrid->isOccupied(cell.pos, OverlappingDistance); });
             ++attempts;
         } while (overlapping && attempts < 200 && overlappingCheckSuccessful);
         if (attempts == 200) {
@@ -320,56 +283,48 @@ DataDescription DescriptionEditService::randomMultiply(
 
         generateNewIds(copy);
         generateNewCreatureIds(copy);
-        result.add(copy);
 
-        //add copy to existentData for overlapping check
-        if (parameters._overlappingCheck) {
+        //add copy to grid for overlapping check
+        if (cellGrid) {
             for (auto const& cell : copy.cells) {
-                auto index = toInt(existentData.cells.size());
-                existentData.cells.emplace_back(cell);
-                auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-                cellPosBySlot[intPos].emplace_back(cell.pos);
+                cellGrid->insert(cell.pos);
             }
         }
+        result.add(copy);
     }
 
     return result;
 }
 
-void DescriptionEditService::addIfSpaceAvailable(
-    DataDescription& result,
-    Occupancy& cellOccupancy,
-    DataDescription const& toAdd,
-    float distance,
-    IntVector2D const& worldSize)
+void DescriptionEditService::addIfSpaceAvailable(DataDescription& result, SpatialGrid& cellGrid, DataDescription const& toAdd, float distance)
 {
-    SpaceCalculator space(worldSize);
-
     for (auto const& cell : toAdd.cells) {
-        if (!isCellPresent(cellOccupancy, space, cell.pos, distance)) {
+        if (!cellGrid.isOccupied(cell.pos, distance)) {
             result.addCell(cell);
-            cellOccupancy[toIntVector2D(cell.pos)].emplace_back(cell.pos);
+            cellGrid.insert(cell.pos);
         }
     }
 }
 
 void DescriptionEditService::reconnectCells(DataDescription& data, float maxDistance)
 {
-    std::unordered_map<int, std::unordered_map<int, std::vector<int>>> cellIndicesBySlot;
-
-    int index = 0;
+    std::vector<RealVector2D> cellPositions;
+    cellPositions.reserve(data.cells.size());
     for (auto& cell : data.cells) {
         cell.connections.clear();
-        cellIndicesBySlot[toInt(cell.pos.x)][toInt(cell.pos.y)].emplace_back(toInt(index));
-        ++index;
+        cellPositions.emplace_back(cell.pos);
     }
+    SpatialGrid cellGrid(cellPositions, maxDistance);
 
     std::unordered_map<uint64_t, int> cache;
     for (auto const& [index, cell] : data.cells | boost::adaptors::indexed(0)) {
         cache.emplace(cell.id, static_cast<int>(index));
     }
     for (auto& cell : data.cells) {
-        auto nearbyCellIndices = getCellIndicesWithinRadius(data, cellIndicesBySlot, cell.pos, maxDistance);
+        auto nearbyCellIndices = cellGrid.getIndicesWithinRadius(cell.pos, maxDistance);
+        std::sort(nearbyCellIndices.begin(), nearbyCellIndices.end(), [&](int index1, int index2) {
+            return Math::length(data.cells.at(index1).pos - cell.pos) < Math::length(data.cells.at(index2).pos - cell.pos);
+        });
         for (auto const& nearbyCellIndex : nearbyCellIndices) {
             auto const& nearbyCell = data.cells.at(nearbyCellIndex);
             if (cell.id != nearbyCell.id && cell.connections.size() < cell.maxConnections && nearbyCell.connections.size() < nearbyCell.maxConnections
@@ -614,39 +569,6 @@ void DescriptionEditService::removeMetadata(CellDescription& cell)
     cell.metadata.name.clear();
 }
 
-bool DescriptionEditService::isCellPresent(Occupancy const& cellPosBySlot, SpaceCalculator const& spaceCalculator, RealVector2D const& posToCheck, float distance)
-{
-    auto intPos = toIntVector2D(posToCheck);
-
-    auto getMatchingSlots = [&cellPosBySlot](IntVector2D const& intPos) {
-        auto findResult = cellPosBySlot.find(intPos);
-        if (findResult != cellPosBySlot.end()) {
-            return findResult->second;
-        }
-        return std::vector<RealVector2D>{};
-    };
-
-    auto isOccupied = [&](std::vector<RealVector2D> const& cellPositions) {
-        for (auto const& cellPos : cellPositions) {
-            auto otherPos = spaceCalculator.getCorrectedPosition(cellPos);
-            if (Math::length(posToCheck - otherPos) < distance) {
-                return true;
-            }
-        }
-        return false;
-    };
-
-    auto distanceInt = toInt(ceilf(distance));
-    for (int dx = -distanceInt; dx <= distanceInt; ++dx) {
-        for (int dy = -distanceInt; dy <= distanceInt; ++dy) {
-            if (isOccupied(getMatchingSlots({intPos.x + dx, intPos.y + dy}))) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 uint64_t DescriptionEditService::getId(CellOrParticleDescription const& entity)
 {
     if (std::holds_alternative<CellDescription>(entity)) {
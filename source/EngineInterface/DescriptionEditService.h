@@ -2,6 +2,7 @@
 
 #include "Base/Definitions.h"
 #include "Descriptions.h"
+#include "SpatialGrid.h"
 
 class DescriptionEditService
 {
@@ -92,9 +93,8 @@ public:
         DataDescription&& existentData,
         bool& overlappingCheckSuccessful);
 
-    using Occupancy = std::unordered_map<IntVector2D, std::vector<RealVector2D>>;
-    static void
-    addIfSpaceAvailable(DataDescription& result, Occupancy& cellOccupancy, DataDescription const& toAdd, float distance, IntVector2D const& worldSize);
+    //cellGrid contains the positions of the cells which have been added so far
+    static void addIfSpaceAvailable(DataDescription& result, SpatialGrid& cellGrid, DataDescription const& toAdd, float distance);
 
     static void reconnectCells(DataDescription& data, float maxDistance);
     static void removeStickiness(DataDescription& data);
@@ -120,9 +120,4 @@ public:
 
 private:
     static void removeMetadata(CellDescription& cell);
-    static bool isCellPresent(
-        Occupancy const& cellPosBySlot,
-        SpaceCalculator const& spaceCalculator,
-        RealVector2D const& posToCheck,
-        float distance);
 };
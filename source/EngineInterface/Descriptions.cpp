@@ -66,6 +66,25 @@ bool CellDescription::hasGenome() const
     return false;
 }
 
+uint64_t CellDescription::getAuxiliaryDataSize() const
+{
+    uint64_t result = metadata.name.size() + metadata.description.size();
+    switch (getCellFunctionType()) {
+    case CellFunction_Neuron:
+        result += MAX_CHANNELS * (MAX_CHANNELS + 1) * sizeof(float);
+        break;
+    case CellFunction_Constructor:
+        result += std::get<ConstructorDescription>(*cellFunction).genome.size();
+        break;
+    case CellFunction_Injector:
+        result += std::get<InjectorDescription>(*cellFunction).genome.size();
+        break;
+    default:
+        break;
+    }
+    return result;
+}
+
 std::vector<uint8_t>& CellDescription::getGenomeRef()
 {
     auto cellFunctionType = getCellFunctionType();
@@ -521,6 +521,9 @@ struct CellDescription
     bool hasGenome() const;
     std::vector<uint8_t>& getGenomeRef();
 
+    //number of bytes which the engine stores for the cell in its auxiliary data (metadata, genome, neuron weights and biases)
+    uint64_t getAuxiliaryDataSize() const;
+
     bool isConnectedTo(uint64_t id) const;
 };
 
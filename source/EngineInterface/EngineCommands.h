@@ -0,0 +1,66 @@
+#pragma once
+
+#include <variant>
+
+#include "Base/Definitions.h"
+
+#include "Descriptions.h"
+#include "GpuSettings.h"
+#include "ShallowUpdateSelectionData.h"
+
+/**
+ * Edits which are queued and executed by the engine thread between time steps without blocking the caller.
+ * Commands are executed in the order in which they were queued. Consecutive cell and particle changes are transferred together.
+ */
+struct ApplyForceCommand
+{
+    RealVector2D start;
+    RealVector2D end;
+    RealVector2D force;
+    float radius = 0;
+};
+
+struct SetGpuSettingsCommand
+{
+    GpuSettings gpuSettings;
+};
+
+struct ChangeCellCommand
+{
+    CellDescription cell;
+};
+
+struct ChangeParticleCommand
+{
+    ParticleDescription particle;
+};
+
+struct SetSelectionCommand
+{
+    RealVector2D startPos;
+    RealVector2D endPos;
+};
+
+struct RemoveSelectionCommand
+{};
+
+struct ShallowUpdateSelectedObjectsCommand
+{
+    ShallowUpdateSelectionData updateData;
+};
+
+struct ColorSelectedObjectsCommand
+{
+    unsigned char color = 0;
+    bool includeClusters = true;
+};
+
+using EngineCommand = std::variant<
+    ApplyForceCommand,
+    SetGpuSettingsCommand,
+    ChangeCellCommand,
+    ChangeParticleCommand,
+    SetSelectionCommand,
+    RemoveSelectionCommand,
+    ShallowUpdateSelectedObjectsCommand,
+    ColorSelectedObjectsCommand>;
@@ -0,0 +1,465 @@
+#include "GenomeAnalyticsService.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "Base/Definitions.h"
+#include "Base/ThreadPool.h"
+
+#include "EngineConstants.h"
+#include "GenomeConstants.h"
+#include "GenomeNavigator.h"
+#include "SerializerService.h"
+
+namespace
+{
+    auto constexpr GenomesPerJob = 1024;
+
+    std::array<std::string, CellFunction_Count> const CellFunctionNames = {
+        "neuron", "transmitter", "constructor", "sensor", "nerve", "attacker", "injector", "muscle", "defender", "reconnector", "detonator", "none"};
+
+    //finalizer of splitmix64
+    uint64_t mix(uint64_t value)
+    {
+        value += 0x9e3779b97f4a7c15ull;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    struct GenomeOccurrence
+    {
+        int genomeIndex = 0;
+        int mutationId = 0;
+        int ancestorMutationId = 0;
+    };
+
+    //deduplicates the genomes of the constructors and injectors over all batches
+    class GenomeCollector
+    {
+    public:
+        void add(ClusteredDataDescription const& data)
+        {
+            for (auto const& cluster : data.clusters) {
+                for (auto const& cell : cluster.cells) {
+                    if (auto genome = getGenome(cell); genome && !genome->empty()) {
+                        add(*genome, cell);
+                    }
+                }
+            }
+        }
+
+        std::vector<DistinctGenome>& getGenomes() { return _genomes; }
+        std::vector<GenomeOccurrence> const& getOccurrences() const { return _occurrences; }
+
+    private:
+        static std::vector<uint8_t> const* getGenome(CellDescription const& cell)
+        {
+            if (!cell.cellFunction) {
+                return nullptr;
+            }
+            if (auto constructor = std::get_if<ConstructorDescription>(&*cell.cellFunction)) {
+                return &constructor->genome;
+            }
+            if (auto injector = std::get_if<InjectorDescription>(&*cell.cellFunction)) {
+                return &injector->genome;
+            }
+            return nullptr;
+        }
+
+        void add(std::vector<uint8_t> const& genome, CellDescription const& cell)
+        {
+            auto genomeIndex = toInt(_genomes.size());
+            if (auto findResult = _genomeIndexByBytes.find(toStringView(genome)); findResult != _genomeIndexByBytes.end()) {
+                genomeIndex = findResult->second;
+            } else {
+                //the key refers to the stored copy whose buffer is kept when _genomes reallocates
+                _genomes.emplace_back(DistinctGenome{.genome = genome});
+                _genomeIndexByBytes.emplace(toStringView(_genomes.back().genome), genomeIndex);
+            }
+            ++_genomes.at(genomeIndex).numOccurrences;
+            _occurrences.emplace_back(
+                GenomeOccurrence{.genomeIndex = genomeIndex, .mutationId = cell.mutationId, .ancestorMutationId = cell.ancestorMutationId});
+        }
+
+        static std::string_view toStringView(std::vector<uint8_t> const& genome)
+        {
+            return std::string_view(reinterpret_cast<char const*>(genome.data()), genome.size());
+        }
+
+        std::vector<DistinctGenome> _genomes;
+        std::vector<GenomeOccurrence> _occurrences;
+        std::unordered_map<std::string_view, int> _genomeIndexByBytes;
+    };
+
+    class UnionFind
+    {
+    public:
+        UnionFind(int size)
+            : _parents(size)
+        {
+            for (int i = 0; i < size; ++i) {
+                _parents[i] = i;
+            }
+        }
+
+        int find(int element)
+        {
+            while (_parents[element] != element) {
+                _parents[element] = _parents[_parents[element]];
+                element = _parents[element];
+            }
+            return element;
+        }
+
+        void unite(int element1, int element2) { _parents[find(element1)] = find(element2); }
+
+    private:
+        std::vector<int> _parents;
+    };
+
+    int getSignatureLength(GenomeAnalyticsSettings const& settings)
+    {
+        return settings.numBands * settings.numRowsPerBand;
+    }
+
+    //node counts, composition and MinHash signature of a genome including its sub-genomes
+    void analyzeGenome(DistinctGenome& genome, std::span<uint64_t> signature, std::vector<uint64_t> const& seeds, GenomeAnalyticsSettings const& settings)
+    {
+        GenomeNavigator navigator(genome.genome);
+        genome.numNodes = navigator.getNumNodes();
+        genome.numNodesRecursively = navigator.getNumNodesRecursively(false);
+        genome.numSubGenomes = navigator.getNumGenomes() - 1;
+
+        std::ranges::fill(signature, std::numeric_limits<uint64_t>::max());
+        auto addShingle = [&](uint64_t shingle) {
+            for (size_t i = 0; i < signature.size(); ++i) {
+                signature[i] = std::min(signature[i], mix(shingle ^ seeds[i]));
+            }
+        };
+
+        std::vector<uint64_t> tokens;
+        for (int genomeIndex = 0; genomeIndex < navigator.getNumGenomes(); ++genomeIndex) {
+            auto genomeAddress = navigator.getGenomeAddress(genomeIndex);
+            auto numNodes = navigator.getNumNodes(genomeIndex);
+            auto genomeSize = navigator.getNodeAddress(numNodes, genomeIndex);
+
+            tokens.clear();
+            for (int nodeIndex = 0; nodeIndex < numNodes; ++nodeIndex) {
+                auto nodeAddress = navigator.getNodeAddress(nodeIndex, genomeIndex);
+                CellFunction cellFunction = genome.genome[genomeAddress + nodeAddress] % CellFunction_Count;
+                auto colorAddress = nodeAddress + Const::CellColorPos;
+                auto color = colorAddress < genomeSize ? genome.genome[genomeAddress + colorAddress] % MAX_COLORS : 0;
+                ++genome.composition[cellFunction];
+                tokens.emplace_back(static_cast<uint64_t>(cellFunction * MAX_COLORS + color + 1));
+            }
+
+            //shingles do not cross genome boundaries, genomes shorter than a shingle form a single shingle
+            auto shingleLength = std::min(toInt(tokens.size()), settings.shingleLength);
+            for (int i = 0; i + shingleLength <= toInt(tokens.size()) && shingleLength > 0; ++i) {
+                uint64_t shingle = 0;
+                for (int j = 0; j < shingleLength; ++j) {
+                    shingle = mix(shingle ^ tokens[i + j]);
+                }
+                addShingle(shingle);
+            }
+        }
+    }
+
+    double estimateSimilarity(std::span<uint64_t const> signature1, std::span<uint64_t const> signature2)
+    {
+        int numEqualValues = 0;
+        for (size_t i = 0; i < signature1.size(); ++i) {
+            if (signature1[i] == signature2[i]) {
+                ++numEqualValues;
+            }
+        }
+        return toDouble(numEqualValues) / toDouble(signature1.size());
+    }
+
+    //LSH: genomes whose signatures agree in all rows of a band are candidates and merged with the first genome of the bucket if they are similar enough
+    std::vector<int> calcClusterRoots(std::vector<uint64_t> const& signatures, int numGenomes, GenomeAnalyticsSettings const& settings)
+    {
+        auto signatureLength = getSignatureLength(settings);
+        auto getSignature = [&](int genomeIndex) {
+            return std::span<uint64_t const>(signatures.data() + static_cast<size_t>(genomeIndex) * signatureLength, signatureLength);
+        };
+
+        UnionFind unionFind(numGenomes);
+        std::unordered_map<uint64_t, int> firstGenomeByBucket;
+        firstGenomeByBucket.reserve(numGenomes);
+        for (int band = 0; band < settings.numBands; ++band) {
+            firstGenomeByBucket.clear();
+            for (int genomeIndex = 0; genomeIndex < numGenomes; ++genomeIndex) {
+                auto signature = getSignature(genomeIndex);
+                uint64_t bucket = band;
+                for (int row = 0; row < settings.numRowsPerBand; ++row) {
+                    bucket = mix(bucket ^ signature[band * settings.numRowsPerBand + row]);
+                }
+                auto [iter, inserted] = firstGenomeByBucket.try_emplace(bucket, genomeIndex);
+                if (!inserted && estimateSimilarity(getSignature(iter->second), signature) >= settings.similarityThreshold) {
+                    unionFind.unite(genomeIndex, iter->second);
+                }
+            }
+        }
+
+        std::vector<int> result(numGenomes);
+        for (int genomeIndex = 0; genomeIndex < numGenomes; ++genomeIndex) {
+            result[genomeIndex] = unionFind.find(genomeIndex);
+        }
+        return result;
+    }
+
+    std::vector<GenomeCluster> calcClusters(std::vector<DistinctGenome>& genomes, std::vector<int> const& clusterRoots)
+    {
+        std::vector<GenomeCluster> result;
+        std::unordered_map<int, int> clusterIndexByRoot;
+        for (int genomeIndex = 0; genomeIndex < toInt(genomes.size()); ++genomeIndex) {
+            auto const& genome = genomes.at(genomeIndex);
+            auto [iter, inserted] = clusterIndexByRoot.try_emplace(clusterRoots.at(genomeIndex), toInt(result.size()));
+            if (inserted) {
+                result.emplace_back(GenomeCluster{.representativeGenomeIndex = genomeIndex});
+            }
+            auto& cluster = result.at(iter->second);
+            if (genome.numOccurrences > genomes.at(cluster.representativeGenomeIndex).numOccurrences) {
+                cluster.representativeGenomeIndex = genomeIndex;
+            }
+            ++cluster.numDistinctGenomes;
+            cluster.numOccurrences += genome.numOccurrences;
+            cluster.meanNumNodesRecursively += toDouble(genome.numNodesRecursively) * genome.numOccurrences;
+        }
+
+        std::vector<int> order(result.size());
+        for (int i = 0; i < toInt(order.size()); ++i) {
+            order[i] = i;
+        }
+        std::ranges::stable_sort(order, [&](int index1, int index2) { return result.at(index1).numOccurrences > result.at(index2).numOccurrences; });
+        std::vector<int> sortedIndexByIndex(result.size());
+        std::vector<GenomeCluster> sortedResult;
+        sortedResult.reserve(result.size());
+        for (auto index : order) {
+            sortedIndexByIndex.at(index) = toInt(sortedResult.size());
+            auto& cluster = sortedResult.emplace_back(result.at(index));
+            cluster.meanNumNodesRecursively /= toDouble(cluster.numOccurrences);
+        }
+        for (int genomeIndex = 0; genomeIndex < toInt(genomes.size()); ++genomeIndex) {
+            genomes.at(genomeIndex).clusterIndex = sortedIndexByIndex.at(clusterIndexByRoot.at(clusterRoots.at(genomeIndex)));
+        }
+        return sortedResult;
+    }
+
+    std::vector<GenomeCompositionStatistics> calcCompositions(std::vector<DistinctGenome> const& genomes)
+    {
+        std::map<CellFunctionComposition, GenomeCompositionStatistics> statisticsByComposition;
+        for (auto const& genome : genomes) {
+            auto& statistics = statisticsByComposition[genome.composition];
+            statistics.composition = genome.composition;
+            ++statistics.numDistinctGenomes;
+            statistics.numOccurrences += genome.numOccurrences;
+        }
+        std::vector<GenomeCompositionStatistics> result;
+        result.reserve(statisticsByComposition.size());
+        for (auto const& statistics : statisticsByComposition | std::views::values) {
+            result.emplace_back(statistics);
+        }
+        std::ranges::stable_sort(
+            result, [](GenomeCompositionStatistics const& statistics1, GenomeCompositionStatistics const& statistics2) {
+                return statistics1.numOccurrences > statistics2.numOccurrences;
+            });
+        return result;
+    }
+
+    template <typename GetKey>
+    std::map<int, GenomeSizeStatistics>
+    calcSizeStatistics(std::vector<DistinctGenome> const& genomes, std::vector<GenomeOccurrence> occurrences, GetKey const& getKey)
+    {
+        std::ranges::sort(occurrences, [&](GenomeOccurrence const& occurrence1, GenomeOccurrence const& occurrence2) {
+            return std::make_pair(getKey(occurrence1), occurrence1.genomeIndex) < std::make_pair(getKey(occurrence2), occurrence2.genomeIndex);
+        });
+
+        std::map<int, GenomeSizeStatistics> result;
+        std::vector<int> sizes;
+        for (size_t begin = 0; begin < occurrences.size();) {
+            auto key = getKey(occurrences.at(begin));
+            auto& statistics = result[key];
+            sizes.clear();
+            auto end = begin;
+            for (; end < occurrences.size() && getKey(occurrences.at(end)) == key; ++end) {
+                if (end == begin || occurrences.at(end).genomeIndex != occurrences.at(end - 1).genomeIndex) {
+                    ++statistics.numDistinctGenomes;
+                }
+                sizes.emplace_back(genomes.at(occurrences.at(end).genomeIndex).numNodesRecursively);
+            }
+            std::ranges::sort(sizes);
+            statistics.numOccurrences = toInt(sizes.size());
+            statistics.minNumNodes = sizes.front();
+            statistics.maxNumNodes = sizes.back();
+            double sum = 0;
+            for (auto size : sizes) {
+                sum += toDouble(size);
+            }
+            statistics.meanNumNodes = sum / toDouble(sizes.size());
+            auto middle = sizes.size() / 2;
+            statistics.medianNumNodes = sizes.size() % 2 == 1 ? toDouble(sizes.at(middle)) : (toDouble(sizes.at(middle - 1)) + toDouble(sizes.at(middle))) / 2;
+            begin = end;
+        }
+        return result;
+    }
+
+    GenomeAnalyticsResult calcResult(GenomeCollector& collector, GenomeAnalyticsSettings const& settings)
+    {
+        GenomeAnalyticsResult result;
+        result.genomes = std::move(collector.getGenomes());
+        result.numOccurrences = toInt(collector.getOccurrences().size());
+        auto numGenomes = toInt(result.genomes.size());
+
+        auto signatureLength = getSignatureLength(settings);
+        std::vector<uint64_t> seeds(signatureLength);
+        for (int i = 0; i < signatureLength; ++i) {
+            seeds[i] = mix(i);
+        }
+        std::vector<uint64_t> signatures(static_cast<size_t>(numGenomes) * signatureLength);
+        auto numJobs = (numGenomes + GenomesPerJob - 1) / GenomesPerJob;
+        ThreadPool::getInstance().parallelFor(numJobs, [&](size_t jobIndex) {
+            auto begin = toInt(jobIndex) * GenomesPerJob;
+            auto end = std::min(begin + GenomesPerJob, numGenomes);
+            for (int genomeIndex = begin; genomeIndex < end; ++genomeIndex) {
+                std::span<uint64_t> signature(signatures.data() + static_cast<size_t>(genomeIndex) * signatureLength, signatureLength);
+                analyzeGenome(result.genomes.at(genomeIndex), signature, seeds, settings);
+            }
+        });
+
+        result.clusters = calcClusters(result.genomes, calcClusterRoots(signatures, numGenomes, settings));
+        result.compositions = calcCompositions(result.genomes);
+        result.sizesByMutationId =
+            calcSizeStatistics(result.genomes, collector.getOccurrences(), [](GenomeOccurrence const& occurrence) { return occurrence.mutationId; });
+        result.sizesByAncestorMutationId =
+            calcSizeStatistics(result.genomes, collector.getOccurrences(), [](GenomeOccurrence const& occurrence) { return occurrence.ancestorMutationId; });
+        return result;
+    }
+
+    boost::property_tree::ptree encodeComposition(CellFunctionComposition const& composition)
+    {
+        boost::property_tree::ptree result;
+        for (int cellFunction = 0; cellFunction < CellFunction_Count; ++cellFunction) {
+            if (composition[cellFunction] > 0) {
+                result.put(CellFunctionNames[cellFunction], composition[cellFunction]);
+            }
+        }
+        return result;
+    }
+
+    boost::property_tree::ptree encodeSizeStatistics(std::map<int, GenomeSizeStatistics> const& statisticsByKey, std::string const& keyName)
+    {
+        boost::property_tree::ptree result;
+        for (auto const& [key, statistics] : statisticsByKey) {
+            boost::property_tree::ptree statisticsTree;
+            statisticsTree.put(keyName, key);
+            statisticsTree.put("genomes", statistics.numOccurrences);
+            statisticsTree.put("distinct genomes", statistics.numDistinctGenomes);
+            statisticsTree.put("min nodes", statistics.minNumNodes);
+            statisticsTree.put("max nodes", statistics.maxNumNodes);
+            statisticsTree.put("mean nodes", statistics.meanNumNodes);
+            statisticsTree.put("median nodes", statistics.medianNumNodes);
+            result.push_back({"", statisticsTree});
+        }
+        return result;
+    }
+}
+
+GenomeAnalyticsResult GenomeAnalyticsService::analyze(ClusteredDataDescription const& data, GenomeAnalyticsSettings const& settings)
+{
+    GenomeCollector collector;
+    collector.add(data);
+    return calcResult(collector, settings);
+}
+
+GenomeAnalyticsResult GenomeAnalyticsService::analyzeFile(std::string const& filename, GenomeAnalyticsSettings const& settings)
+{
+    GenomeCollector collector;
+    auto success = SerializerService::deserializeMainDataFromFile(
+        filename, [](MainDataSummary const&) {}, [&](ClusteredDataDescription const& batch) { collector.add(batch); });
+    if (!success) {
+        throw std::runtime_error("Could not read " + filename + ".");
+    }
+    return calcResult(collector, settings);
+}
+
+bool GenomeAnalyticsService::saveToJson(std::string const& filename, GenomeAnalyticsResult const& result, GenomeAnalyticsSettings const& settings)
+{
+    boost::property_tree::ptree tree;
+    tree.put("summary.genomes", result.numOccurrences);
+    tree.put("summary.distinct genomes", result.genomes.size());
+    tree.put("summary.clusters", result.clusters.size());
+    tree.put("summary.compositions", result.compositions.size());
+    tree.put("summary.mutation ids", result.sizesByMutationId.size());
+
+    boost::property_tree::ptree clustersTree;
+    for (int i = 0; i < std::min(toInt(result.clusters.size()), settings.maxListedClusters); ++i) {
+        auto const& cluster = result.clusters.at(i);
+        auto const& representative = result.genomes.at(cluster.representativeGenomeIndex);
+        boost::property_tree::ptree clusterTree;
+        clusterTree.put("genomes", cluster.numOccurrences);
+        clusterTree.put("distinct genomes", cluster.numDistinctGenomes);
+        clusterTree.put("mean nodes", cluster.meanNumNodesRecursively);
+        clusterTree.put("representative genome index", cluster.representativeGenomeIndex);
+        clusterTree.put("representative nodes", representative.numNodesRecursively);
+        clusterTree.add_child("representative composition", encodeComposition(representative.composition));
+        clustersTree.push_back({"", clusterTree});
+    }
+    tree.add_child("clusters", clustersTree);
+
+    boost::property_tree::ptree compositionsTree;
+    for (int i = 0; i < std::min(toInt(result.compositions.size()), settings.maxListedCompositions); ++i) {
+        auto const& composition = result.compositions.at(i);
+        boost::property_tree::ptree compositionTree;
+        compositionTree.put("genomes", composition.numOccurrences);
+        compositionTree.put("distinct genomes", composition.numDistinctGenomes);
+        compositionTree.add_child("nodes", encodeComposition(composition.composition));
+        compositionsTree.push_back({"", compositionTree});
+    }
+    tree.add_child("compositions", compositionsTree);
+
+    tree.add_child("mutation ids", encodeSizeStatistics(result.sizesByMutationId, "mutation id"));
+    tree.add_child("ancestor mutation ids", encodeSizeStatistics(result.sizesByAncestorMutationId, "ancestor mutation id"));
+
+    try {
+        boost::property_tree::json_parser::write_json(filename, tree);
+    } catch (boost::property_tree::json_parser_error const&) {
+        return false;
+    }
+    return true;
+}
+
+bool GenomeAnalyticsService::saveGenomesToCsv(std::string const& filename, GenomeAnalyticsResult const& result)
+{
+    std::ofstream stream(filename, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    stream << "Genome index, Cluster, Occurrences, Bytes, Nodes, Nodes including sub-genomes, Sub-genomes";
+    for (auto const& cellFunctionName : CellFunctionNames) {
+        stream << ", Nodes (" << cellFunctionName << ")";
+    }
+    stream << std::endl;
+
+    for (int genomeIndex = 0; genomeIndex < toInt(result.genomes.size()); ++genomeIndex) {
+        auto const& genome = result.genomes.at(genomeIndex);
+        stream << genomeIndex << ", " << genome.clusterIndex << ", " << genome.numOccurrences << ", " << genome.genome.size() << ", " << genome.numNodes
+               << ", " << genome.numNodesRecursively << ", " << genome.numSubGenomes;
+        for (auto numNodes : genome.composition) {
+            stream << ", " << numNodes;
+        }
+        stream << "\n";
+    }
+    return static_cast<bool>(stream);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CellFunctionConstants.h"
+#include "Descriptions.h"
+
+struct GenomeAnalyticsSettings
+{
+    int shingleLength = 3;  //number of consecutive nodes of a genome which form a shingle for MinHash
+    int numBands = 8;  //LSH bands, the MinHash signature consists of numBands * numRowsPerBand values
+    int numRowsPerBand = 4;
+    double similarityThreshold = 0.5;  //minimum estimated Jaccard similarity of the shingle sets for merging genomes into a cluster
+    int maxListedClusters = 1000;  //only for the JSON output
+    int maxListedCompositions = 100;  //only for the JSON output
+};
+
+using CellFunctionComposition = std::array<int, CellFunction_Count>;  //number of nodes per cell function
+
+struct DistinctGenome
+{
+    std::vector<uint8_t> genome;
+    int numOccurrences = 0;  //number of constructors and injectors with this genome
+    int numNodes = 0;
+    int numNodesRecursively = 0;  //including sub-genomes, repetitions are not counted
+    int numSubGenomes = 0;
+    CellFunctionComposition composition = {};  //including sub-genomes
+    int clusterIndex = 0;
+};
+
+struct GenomeCluster
+{
+    int representativeGenomeIndex = 0;  //most frequent genome of the cluster
+    int numDistinctGenomes = 0;
+    int numOccurrences = 0;
+    double meanNumNodesRecursively = 0;
+};
+
+struct GenomeCompositionStatistics
+{
+    CellFunctionComposition composition = {};
+    int numDistinctGenomes = 0;
+    int numOccurrences = 0;
+};
+
+//sizes refer to the number of nodes including sub-genomes and are counted per occurrence
+struct GenomeSizeStatistics
+{
+    int numOccurrences = 0;
+    int numDistinctGenomes = 0;
+    int minNumNodes = 0;
+    int maxNumNodes = 0;
+    double meanNumNodes = 0;
+    double medianNumNodes = 0;
+};
+
+struct GenomeAnalyticsResult
+{
+    int numOccurrences = 0;
+    std::vector<DistinctGenome> genomes;
+    std::vector<GenomeCluster> clusters;  //sorted by the number of occurrences in descending order
+    std::vector<GenomeCompositionStatistics> compositions;  //sorted by the number of occurrences in descending order
+    std::map<int, GenomeSizeStatistics> sizesByMutationId;
+    std::map<int, GenomeSizeStatistics> sizesByAncestorMutationId;
+};
+
+/**
+ * Offline analysis of all constructor and injector genomes of a simulation. The genomes are deduplicated by their bytes and examined with
+ * GenomeNavigator without decoding them. Near-duplicates are grouped by MinHash over the shingles of the node sequences (cell function and color
+ * per node) and LSH banding: a genome is merged with the first genome of each band bucket it falls into if their estimated similarity reaches the
+ * threshold. The per-genome work is distributed on the thread pool.
+ */
+class GenomeAnalyticsService
+{
+public:
+    static GenomeAnalyticsResult analyze(ClusteredDataDescription const& data, GenomeAnalyticsSettings const& settings = GenomeAnalyticsSettings());
+
+    //main data of the simulation file is processed in batches, throws std::runtime_error if the file cannot be read
+    static GenomeAnalyticsResult analyzeFile(std::string const& filename, GenomeAnalyticsSettings const& settings = GenomeAnalyticsSettings());
+
+    //summary, clusters, compositions and size statistics per mutation id and ancestor mutation id
+    static bool
+    saveToJson(std::string const& filename, GenomeAnalyticsResult const& result, GenomeAnalyticsSettings const& settings = GenomeAnalyticsSettings());
+
+    //one row per distinct genome
+    static bool saveGenomesToCsv(std::string const& filename, GenomeAnalyticsResult const& result);
+};
@@ -0,0 +1,210 @@
+#include "GenomeNavigator.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Base/Definitions.h"
+
+#include "CellFunctionConstants.h"
+#include "GenomeConstants.h"
+
+namespace
+{
+    //self-copy flag and size of the sub-genome
+    auto constexpr SubGenomeInfoBytes = 3;
+
+    class ByteReader
+    {
+    public:
+        ByteReader(std::span<uint8_t const> data, int endAddress)
+            : _data(data)
+            , _endAddress(endAddress)
+        {}
+
+        //bytes after the end are read as zero like in the byte decoder
+        uint8_t readByte(int address) const { return address < _endAddress ? _data[address] : 0; }
+        bool readBool(int address) const { return static_cast<int8_t>(readByte(address)) > 0; }
+        int readWord(int address) const { return static_cast<int>(readByte(address)) | (static_cast<int>(readByte(address + 1)) << 8); }
+
+    private:
+        std::span<uint8_t const> _data;
+        int _endAddress = 0;
+    };
+
+    int getCellFunctionFixedBytes(CellFunction cellFunction)
+    {
+        switch (cellFunction) {
+        case CellFunction_Neuron:
+            return Const::NeuronBytes;
+        case CellFunction_Transmitter:
+            return Const::TransmitterBytes;
+        case CellFunction_Constructor:
+            return Const::ConstructorFixedBytes;
+        case CellFunction_Sensor:
+            return Const::SensorBytes;
+        case CellFunction_Nerve:
+            return Const::NerveBytes;
+        case CellFunction_Attacker:
+            return Const::AttackerBytes;
+        case CellFunction_Injector:
+            return Const::InjectorFixedBytes;
+        case CellFunction_Muscle:
+            return Const::MuscleBytes;
+        case CellFunction_Defender:
+            return Const::DefenderBytes;
+        case CellFunction_Reconnector:
+            return Const::ReconnectorBytes;
+        case CellFunction_Detonator:
+            return Const::DetonatorBytes;
+        default:
+            return 0;
+        }
+    }
+
+    int getHeaderSize(GenomeEncodingSpecification const& spec)
+    {
+        auto result = Const::GenomeHeaderSize;
+        for (auto const& isEncoded : {spec._numRepetitions, spec._concatenationAngle1, spec._concatenationAngle2}) {
+            if (!isEncoded) {
+                --result;
+            }
+        }
+        return result;
+    }
+}
+
+GenomeNavigator::GenomeNavigator(std::span<uint8_t const> data, GenomeEncodingSpecification const& spec)
+{
+    _genomes.emplace_back(GenomeEntry{.startAddress = 0, .endAddress = static_cast<int>(data.size())});
+
+    //sub-genomes found during the scan are appended and scanned afterwards
+    for (int genomeIndex = 0; genomeIndex < toInt(_genomes.size()); ++genomeIndex) {
+        scanGenome(data, genomeIndex, spec);
+    }
+    calcNumNodesRecursively();
+}
+
+int GenomeNavigator::getNumGenomes() const
+{
+    return toInt(_genomes.size());
+}
+
+int GenomeNavigator::getGenomeAddress(int genomeIndex) const
+{
+    return _genomes.at(genomeIndex).startAddress;
+}
+
+int GenomeNavigator::getNumNodes(int genomeIndex) const
+{
+    return _genomes.at(genomeIndex).numNodes;
+}
+
+int GenomeNavigator::getNodeAddress(int nodeIndex, int genomeIndex) const
+{
+    auto const& genome = _genomes.at(genomeIndex);
+    if (nodeIndex >= genome.numNodes) {
+        return genome.endAddress - genome.startAddress;
+    }
+    return _nodeAddresses[genome.firstNodeIndex + std::max(0, nodeIndex)] - genome.startAddress;
+}
+
+int GenomeNavigator::getNodeIndex(int nodeAddress, int genomeIndex) const
+{
+    auto const& genome = _genomes.at(genomeIndex);
+    auto nodesBegin = _nodeAddresses.begin() + genome.firstNodeIndex;
+    auto nodesEnd = nodesBegin + genome.numNodes;
+    return toInt(std::lower_bound(nodesBegin, nodesEnd, genome.startAddress + nodeAddress) - nodesBegin);
+}
+
+std::optional<int> GenomeNavigator::getSubGenomeIndex(int nodeIndex, int genomeIndex) const
+{
+    auto const& genome = _genomes.at(genomeIndex);
+    if (nodeIndex < 0 || nodeIndex >= genome.numNodes) {
+        return std::nullopt;
+    }
+    auto result = _subGenomeIndices[genome.firstNodeIndex + nodeIndex];
+    return result != -1 ? std::make_optional(result) : std::nullopt;
+}
+
+int GenomeNavigator::getNumRepetitions(int genomeIndex) const
+{
+    return _genomes.at(genomeIndex).numRepetitions;
+}
+
+int GenomeNavigator::getNumBranches(int genomeIndex) const
+{
+    return _genomes.at(genomeIndex).numBranches;
+}
+
+int GenomeNavigator::getNumNodesRecursively(bool includeRepetitions, int genomeIndex) const
+{
+    auto const& genome = _genomes.at(genomeIndex);
+    return includeRepetitions ? genome.numNodesRecursivelyWithRepetitions : genome.numNodesRecursively;
+}
+
+void GenomeNavigator::scanGenome(std::span<uint8_t const> data, int genomeIndex, GenomeEncodingSpecification const& spec)
+{
+    //_genomes may grow during the scan, hence no reference to the entry is held
+    auto startAddress = _genomes.at(genomeIndex).startAddress;
+    auto endAddress = _genomes.at(genomeIndex).endAddress;
+    ByteReader reader(data, endAddress);
+
+    auto separateConstruction = reader.readBool(startAddress + Const::GenomeHeaderSeparationPos);
+    auto numBranches = separateConstruction ? 1 : (reader.readByte(startAddress + Const::GenomeHeaderNumBranchesPos) + 5) % 6 + 1;
+    auto numRepetitions = 1;
+    if (spec._numRepetitions) {
+        auto numRepetitionsByte = reader.readByte(startAddress + Const::GenomeHeaderNumRepetitionsPos);
+        numRepetitions = numRepetitionsByte == 255 ? std::numeric_limits<int>::max() : numRepetitionsByte;
+    }
+
+    auto firstNodeIndex = toInt(_nodeAddresses.size());
+    for (auto nodeAddress = std::min(startAddress + getHeaderSize(spec), endAddress); nodeAddress < endAddress;) {
+        _nodeAddresses.emplace_back(nodeAddress);
+        _subGenomeIndices.emplace_back(-1);
+
+        CellFunction cellFunction = reader.readByte(nodeAddress) % CellFunction_Count;
+        auto nextNodeAddress = nodeAddress + Const::CellBasicBytes + getCellFunctionFixedBytes(cellFunction);
+        if (cellFunction == CellFunction_Constructor || cellFunction == CellFunction_Injector) {
+            auto makeSelfCopy = reader.readBool(nextNodeAddress);
+            if (makeSelfCopy) {
+                ++nextNodeAddress;
+            } else {
+                auto subGenomeSize = reader.readWord(nextNodeAddress + 1);
+                auto subGenomeStartAddress = std::min(nextNodeAddress + SubGenomeInfoBytes, endAddress);
+                auto subGenomeEndAddress = subGenomeStartAddress + std::min(subGenomeSize, endAddress - subGenomeStartAddress);
+                _subGenomeIndices.back() = toInt(_genomes.size());
+                _genomes.emplace_back(GenomeEntry{.startAddress = subGenomeStartAddress, .endAddress = subGenomeEndAddress});
+                nextNodeAddress = subGenomeEndAddress;
+            }
+        }
+        nodeAddress = std::min(nextNodeAddress, endAddress);
+    }
+
+    auto& genome = _genomes.at(genomeIndex);
+    genome.firstNodeIndex = firstNodeIndex;
+    genome.numNodes = toInt(_nodeAddresses.size()) - firstNodeIndex;
+    genome.numRepetitions = numRepetitions;
+    genome.numBranches = numBranches;
+}
+
+void GenomeNavigator::calcNumNodesRecursively()
+{
+    //sub-genomes have higher indices than their parents
+    for (int genomeIndex = toInt(_genomes.size()) - 1; genomeIndex >= 0; --genomeIndex) {
+        auto& genome = _genomes.at(genomeIndex);
+        int64_t numNodes = genome.numNodes;
+        int64_t numNodesWithRepetitions = genome.numNodes;
+        for (int nodeIndex = genome.firstNodeIndex; nodeIndex < genome.firstNodeIndex + genome.numNodes; ++nodeIndex) {
+            if (auto subGenomeIndex = _subGenomeIndices[nodeIndex]; subGenomeIndex != -1) {
+                numNodes += _genomes.at(subGenomeIndex).numNodesRecursively;
+                numNodesWithRepetitions += _genomes.at(subGenomeIndex).numNodesRecursivelyWithRepetitions;
+            }
+        }
+        auto numRepetitions = genome.numRepetitions == std::numeric_limits<int>::max() ? 1 : genome.numRepetitions;
+        numNodesWithRepetitions *= numRepetitions * genome.numBranches;
+
+        auto constexpr MaxValue = static_cast<int64_t>(std::numeric_limits<int>::max());
+        genome.numNodesRecursively = static_cast<int>(std::min(numNodes, MaxValue));
+        genome.numNodesRecursivelyWithRepetitions = static_cast<int>(std::min(numNodesWithRepetitions, MaxValue));
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "GenomeDescriptionService.h"
+
+/**
+ * Offset table of an encoded genome and all its nested sub-genomes which is built in one pass over the bytes without decoding them.
+ * Genome 0 is the given genome, sub-genomes follow in breadth-first order. Node addresses are relative to the start of their genome
+ * such that they agree with GenomeDescriptionService applied to the sub-genome bytes.
+ * Truncated data is handled like the byte decoder does, i.e. missing bytes are read as zero.
+ */
+class GenomeNavigator
+{
+public:
+    GenomeNavigator(std::span<uint8_t const> data, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+
+    int getNumGenomes() const;
+
+    //absolute address of the genome header in the given data
+    int getGenomeAddress(int genomeIndex) const;
+
+    int getNumNodes(int genomeIndex = 0) const;
+
+    //O(1), returns the end address of the genome for nodeIndex >= number of nodes
+    int getNodeAddress(int nodeIndex, int genomeIndex = 0) const;
+
+    //O(log n), number of nodes which start before the given address
+    int getNodeIndex(int nodeAddress, int genomeIndex = 0) const;
+
+    //sub-genome encoded in the node (constructor or injector without self-copy)
+    std::optional<int> getSubGenomeIndex(int nodeIndex, int genomeIndex = 0) const;
+
+    //255 in the genome header stands for infinitely many repetitions and is returned as std::numeric_limits<int>::max()
+    int getNumRepetitions(int genomeIndex = 0) const;
+    int getNumBranches(int genomeIndex = 0) const;
+
+    //O(1), includes all nested sub-genomes (infinite repetitions are counted once)
+    int getNumNodesRecursively(bool includeRepetitions, int genomeIndex = 0) const;
+
+private:
+    struct GenomeEntry
+    {
+        int startAddress = 0;  //absolute address of the header
+        int endAddress = 0;
+        int firstNodeIndex = 0;  //index in _nodeAddresses
+        int numNodes = 0;
+        int numRepetitions = 1;
+        int numBranches = 1;
+        int numNodesRecursively = 0;
+        int numNodesRecursivelyWithRepetitions = 0;
+    };
+
+    void scanGenome(std::span<uint8_t const> data, int genomeIndex, GenomeEncodingSpecification const& spec);
+    void calcNumNodesRecursively();
+
+    std::vector<GenomeEntry> _genomes;
+    std::vector<int> _nodeAddresses;  //absolute addresses of the nodes of all genomes, nodes of a genome are stored contiguously
+    std::vector<int> _subGenomeIndices;  //per node, -1 if the node does not contain a sub-genome
+};
@@ -0,0 +1,40 @@
+#include "GenomePool.h"
+
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+    size_t calcHash(std::vector<uint8_t> const& genome)
+    {
+        return std::hash<std::string_view>()(std::string_view(reinterpret_cast<char const*>(genome.data()), genome.size()));
+    }
+}
+
+uint32_t GenomePool::add(std::vector<uint8_t> const& genome)
+{
+    auto hash = calcHash(genome);
+    auto [begin, end] = _handlesByHash.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+        if (_genomes.at(it->second) == genome) {
+            return it->second;
+        }
+    }
+    auto result = static_cast<uint32_t>(_genomes.size());
+    _genomes.emplace_back(genome);
+    _handlesByHash.emplace(hash, result);
+    return result;
+}
+
+std::vector<uint8_t> const& GenomePool::get(uint32_t handle) const
+{
+    if (handle >= _genomes.size()) {
+        throw std::runtime_error("Invalid genome handle.");
+    }
+    return _genomes[handle];
+}
+
+size_t GenomePool::getNumGenomes() const
+{
+    return _genomes.size();
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Content-addressed table of genomes. Byte-identical genomes are stored once and referenced by their index (handle) in the table.
+ */
+class GenomePool
+{
+public:
+    //returns the handle of an identical genome if it is already in the pool, otherwise the genome is appended
+    uint32_t add(std::vector<uint8_t> const& genome);
+
+    std::vector<uint8_t> const& get(uint32_t handle) const;
+    size_t getNumGenomes() const;
+
+private:
+    std::unordered_multimap<size_t, uint32_t> _handlesByHash;
+    std::vector<std::vector<uint8_t>> _genomes;
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+//number of objects in the main data of a simulation file, known before the objects themselves are read
+struct MainDataSummary
+{
+    uint64_t numClusters = 0;
+    uint64_t numCells = 0;
+    uint64_t numParticles = 0;
+    uint64_t auxiliaryDataSize = 0;  //see CellDescription::getAuxiliaryDataSize, 0 for older files which do not contain it
+};
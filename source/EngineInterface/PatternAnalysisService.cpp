@@ -0,0 +1,350 @@
+#include "PatternAnalysisService.h"
+
+#include <algorithm>
+#include <span>
+#include <unordered_map>
+
+#include "Base/Definitions.h"
+#include "Base/ThreadPool.h"
+
+namespace
+{
+    auto constexpr ClustersPerJob = 256;
+    auto constexpr MaxRefinementIterations = 64;
+
+    //clusters with the same canonical hash are regarded as isomorphic if the search does not finish within this number of steps
+    auto constexpr MaxSearchSteps = 1000000;
+
+    //finalizer of splitmix64
+    uint64_t mix(uint64_t value)
+    {
+        value += 0x9e3779b97f4a7c15ull;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    uint64_t combine(uint64_t hash, uint64_t value)
+    {
+        return mix(hash ^ mix(value));
+    }
+
+    //cells and their connections in compressed adjacency format
+    struct CellNetwork
+    {
+        std::vector<int> adjacencyOffsets;  //neighbors of cell i are stored in adjacency[adjacencyOffsets[i]], ..., adjacency[adjacencyOffsets[i + 1] - 1]
+        std::vector<int> adjacency;  //sorted per cell
+        std::vector<uint64_t> labels;  //refined labels
+        uint64_t hash = 0;
+
+        int getNumCells() const { return toInt(labels.size()); }
+
+        std::span<int const> getNeighbors(int cellIndex) const
+        {
+            return std::span<int const>(adjacency.data() + adjacencyOffsets[cellIndex], adjacencyOffsets[cellIndex + 1] - adjacencyOffsets[cellIndex]);
+        }
+
+        bool isConnected(int cellIndex, int otherCellIndex) const { return std::ranges::binary_search(getNeighbors(cellIndex), otherCellIndex); }
+    };
+
+    uint64_t calcAttributeHash(CellDescription const& cell)
+    {
+        auto inputExecutionOrderNumber = cell.inputExecutionOrderNumber ? *cell.inputExecutionOrderNumber + 1 : 0;
+        uint64_t result = 0;
+        for (auto value :
+             {cell.maxConnections,
+              toInt(cell.connections.size()),
+              cell.livingState,
+              inputExecutionOrderNumber,
+              cell.outputBlocked ? 1 : 0,
+              cell.executionOrderNumber,
+              cell.color,
+              cell.getCellFunctionType()}) {
+            result = combine(result, static_cast<uint64_t>(value));
+        }
+        return result;
+    }
+
+    int countDistinctLabels(std::vector<uint64_t> labels)
+    {
+        std::ranges::sort(labels);
+        return toInt(std::unique(labels.begin(), labels.end()) - labels.begin());
+    }
+
+    //Weisfeiler-Lehman refinement: the label of a cell is combined with the sorted labels of its neighbors until the partition of the cells is stable
+    void refineLabels(CellNetwork& network)
+    {
+        auto numCells = network.getNumCells();
+        auto numDistinctLabels = countDistinctLabels(network.labels);
+        std::vector<uint64_t> refinedLabels(numCells);
+        std::vector<uint64_t> neighborLabels;
+        auto numIterations = 0;
+        while (numIterations < MaxRefinementIterations) {
+            for (int cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+                neighborLabels.clear();
+                for (auto neighbor : network.getNeighbors(cellIndex)) {
+                    neighborLabels.emplace_back(network.labels[neighbor]);
+                }
+                std::ranges::sort(neighborLabels);
+
+                auto label = combine(network.labels[cellIndex], neighborLabels.size());
+                for (auto neighborLabel : neighborLabels) {
+                    label = combine(label, neighborLabel);
+                }
+                refinedLabels[cellIndex] = label;
+            }
+            network.labels.swap(refinedLabels);
+            ++numIterations;
+
+            auto numRefinedDistinctLabels = countDistinctLabels(network.labels);
+            if (numRefinedDistinctLabels == numDistinctLabels) {
+                break;
+            }
+            numDistinctLabels = numRefinedDistinctLabels;
+        }
+
+        auto sortedLabels = network.labels;
+        std::ranges::sort(sortedLabels);
+        network.hash = combine(combine(0, numCells), numIterations);
+        for (auto label : sortedLabels) {
+            network.hash = combine(network.hash, label);
+        }
+    }
+
+    CellNetwork createCellNetwork(ClusterDescription const& cluster)
+    {
+        auto numCells = toInt(cluster.cells.size());
+        std::unordered_map<uint64_t, int> cellIndexById;
+        cellIndexById.reserve(numCells);
+        for (int cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+            cellIndexById.emplace(cluster.cells[cellIndex].id, cellIndex);
+        }
+
+        CellNetwork result;
+        result.labels.resize(numCells);
+        result.adjacencyOffsets.reserve(numCells + 1);
+        result.adjacencyOffsets.emplace_back(0);
+        for (int cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+            auto const& cell = cluster.cells[cellIndex];
+            result.labels[cellIndex] = calcAttributeHash(cell);
+
+            //connections to cells outside the cluster are ignored
+            auto neighborsBegin = result.adjacency.size();
+            for (auto const& connection : cell.connections) {
+                if (auto findResult = cellIndexById.find(connection.cellId); findResult != cellIndexById.end()) {
+                    result.adjacency.emplace_back(findResult->second);
+                }
+            }
+            std::sort(result.adjacency.begin() + neighborsBegin, result.adjacency.end());
+            result.adjacency.erase(std::unique(result.adjacency.begin() + neighborsBegin, result.adjacency.end()), result.adjacency.end());
+            result.adjacencyOffsets.emplace_back(toInt(result.adjacency.size()));
+        }
+        refineLabels(result);
+        return result;
+    }
+
+    //backtracking search along a breadth-first order of network1 in which cells can only be mapped to cells with the same refined label
+    bool findIsomorphism(CellNetwork const& network1, CellNetwork const& network2)
+    {
+        auto numCells = network1.getNumCells();
+        if (network1.hash != network2.hash || numCells != network2.getNumCells() || network1.adjacency.size() != network2.adjacency.size()) {
+            return false;
+        }
+        if (numCells == 0) {
+            return true;
+        }
+
+        std::unordered_map<uint64_t, std::vector<int>> cellsByLabel2;
+        for (int cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+            cellsByLabel2[network2.labels[cellIndex]].emplace_back(cellIndex);
+        }
+        std::vector<int> labelFrequencies1(numCells);
+        for (int cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+            auto findResult = cellsByLabel2.find(network1.labels[cellIndex]);
+            if (findResult == cellsByLabel2.end()) {
+                return false;
+            }
+            labelFrequencies1[cellIndex] = toInt(findResult->second.size());
+        }
+
+        //each connected component is traversed starting from a cell with a rare label in order to have few candidates for its root
+        std::vector<int> roots(numCells);
+        for (int cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+            roots[cellIndex] = cellIndex;
+        }
+        std::ranges::stable_sort(roots, [&](int cellIndex1, int cellIndex2) { return labelFrequencies1[cellIndex1] < labelFrequencies1[cellIndex2]; });
+
+        std::vector<int> order;
+        std::vector<int> parents;  //per position in order, -1 for roots
+        order.reserve(numCells);
+        parents.reserve(numCells);
+        std::vector<bool> visited(numCells, false);
+        for (auto root : roots) {
+            if (visited[root]) {
+                continue;
+            }
+            visited[root] = true;
+            order.emplace_back(root);
+            parents.emplace_back(-1);
+            for (auto position = order.size() - 1; position < order.size(); ++position) {
+                auto cellIndex = order[position];
+                for (auto neighbor : network1.getNeighbors(cellIndex)) {
+                    if (!visited[neighbor]) {
+                        visited[neighbor] = true;
+                        order.emplace_back(neighbor);
+                        parents.emplace_back(cellIndex);
+                    }
+                }
+            }
+        }
+
+        std::vector<int> mapping(numCells, -1);  //cell of network1 => cell of network2
+        std::vector<bool> isMapped2(numCells, false);
+        auto isConsistent = [&](int cellIndex1, int cellIndex2) {
+            if (isMapped2[cellIndex2] || network1.labels[cellIndex1] != network2.labels[cellIndex2]) {
+                return false;
+            }
+            auto numMappedNeighbors1 = 0;
+            for (auto neighbor1 : network1.getNeighbors(cellIndex1)) {
+                if (mapping[neighbor1] != -1) {
+                    if (!network2.isConnected(cellIndex2, mapping[neighbor1])) {
+                        return false;
+                    }
+                    ++numMappedNeighbors1;
+                }
+            }
+            auto numMappedNeighbors2 = 0;
+            for (auto neighbor2 : network2.getNeighbors(cellIndex2)) {
+                if (isMapped2[neighbor2]) {
+                    ++numMappedNeighbors2;
+                }
+            }
+            return numMappedNeighbors1 == numMappedNeighbors2;
+        };
+
+        struct SearchState
+        {
+            std::vector<int> candidates;
+            size_t nextCandidate = 0;
+        };
+        std::vector<SearchState> states(numCells);
+        auto initState = [&](int position) {
+            auto& state = states[position];
+            state.nextCandidate = 0;
+            if (parents[position] != -1) {
+                auto neighbors2 = network2.getNeighbors(mapping[parents[position]]);
+                state.candidates.assign(neighbors2.begin(), neighbors2.end());
+            } else {
+                state.candidates = cellsByLabel2.at(network1.labels[order[position]]);
+            }
+        };
+
+        auto numSteps = 0;
+        auto position = 0;
+        initState(position);
+        while (position >= 0) {
+            auto& state = states[position];
+            auto cellIndex1 = order[position];
+            if (mapping[cellIndex1] != -1) {
+                isMapped2[mapping[cellIndex1]] = false;
+                mapping[cellIndex1] = -1;
+            }
+            while (state.nextCandidate < state.candidates.size() && mapping[cellIndex1] == -1) {
+                auto cellIndex2 = state.candidates[state.nextCandidate++];
+                if (++numSteps > MaxSearchSteps) {
+                    return true;
+                }
+                if (isConsistent(cellIndex1, cellIndex2)) {
+                    mapping[cellIndex1] = cellIndex2;
+                    isMapped2[cellIndex2] = true;
+                }
+            }
+            if (mapping[cellIndex1] == -1) {
+                --position;
+                continue;
+            }
+            if (position + 1 == numCells) {
+                return true;
+            }
+            initState(++position);
+        }
+        return false;
+    }
+
+    struct ClassEntry
+    {
+        int representantIndex = 0;
+        int numberOfElements = 0;
+    };
+}
+
+std::vector<PatternClass> PatternAnalysisService::calcPatternClasses(ClusteredDataDescription const& data)
+{
+    auto numClusters = toInt(data.clusters.size());
+    std::vector<CellNetwork> networks(numClusters);
+    ThreadPool::getInstance().parallelFor((numClusters + ClustersPerJob - 1) / ClustersPerJob, [&](size_t jobIndex) {
+        auto begin = toInt(jobIndex) * ClustersPerJob;
+        auto end = std::min(begin + ClustersPerJob, numClusters);
+        for (int clusterIndex = begin; clusterIndex < end; ++clusterIndex) {
+            networks[clusterIndex] = createCellNetwork(data.clusters[clusterIndex]);
+        }
+    });
+
+    std::vector<std::vector<int>> buckets;  //cluster indices with the same hash
+    std::unordered_map<uint64_t, int> bucketIndexByHash;
+    for (int clusterIndex = 0; clusterIndex < numClusters; ++clusterIndex) {
+        auto [iter, inserted] = bucketIndexByHash.try_emplace(networks[clusterIndex].hash, toInt(buckets.size()));
+        if (inserted) {
+            buckets.emplace_back();
+        }
+        buckets[iter->second].emplace_back(clusterIndex);
+    }
+
+    //a bucket contains several classes in case of hash collisions or clusters which are not distinguished by the refinement
+    auto numBuckets = toInt(buckets.size());
+    std::vector<std::vector<ClassEntry>> classesByBucket(numBuckets);
+    ThreadPool::getInstance().parallelFor((numBuckets + ClustersPerJob - 1) / ClustersPerJob, [&](size_t jobIndex) {
+        auto begin = toInt(jobIndex) * ClustersPerJob;
+        auto end = std::min(begin + ClustersPerJob, numBuckets);
+        for (int bucketIndex = begin; bucketIndex < end; ++bucketIndex) {
+            auto& classes = classesByBucket[bucketIndex];
+            for (auto clusterIndex : buckets[bucketIndex]) {
+                auto findResult = std::ranges::find_if(
+                    classes, [&](ClassEntry const& entry) { return findIsomorphism(networks[entry.representantIndex], networks[clusterIndex]); });
+                if (findResult != classes.end()) {
+                    ++findResult->numberOfElements;
+                } else {
+                    classes.emplace_back(ClassEntry{.representantIndex = clusterIndex, .numberOfElements = 1});
+                }
+            }
+        }
+    });
+
+    std::vector<ClassEntry> classes;
+    for (auto const& bucketClasses : classesByBucket) {
+        classes.insert(classes.end(), bucketClasses.begin(), bucketClasses.end());
+    }
+    std::ranges::sort(classes, [](ClassEntry const& entry1, ClassEntry const& entry2) {
+        if (entry1.numberOfElements != entry2.numberOfElements) {
+            return entry1.numberOfElements > entry2.numberOfElements;
+        }
+        return entry1.representantIndex < entry2.representantIndex;
+    });
+
+    std::vector<PatternClass> result;
+    result.reserve(classes.size());
+    for (auto const& entry : classes) {
+        result.emplace_back(PatternClass{.numberOfElements = entry.numberOfElements, .representant = data.clusters[entry.representantIndex]});
+    }
+    return result;
+}
+
+uint64_t PatternAnalysisService::calcCanonicalHash(ClusterDescription const& cluster)
+{
+    return createCellNetwork(cluster).hash;
+}
+
+bool PatternAnalysisService::isIsomorphic(ClusterDescription const& cluster1, ClusterDescription const& cluster2)
+{
+    return findIsomorphism(createCellNetwork(cluster1), createCellNetwork(cluster2));
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Descriptions.h"
+
+struct PatternClass
+{
+    int numberOfElements = 0;
+    ClusterDescription representant;  //first cluster of the class in the input data
+};
+
+/**
+ * Groups clusters into classes of isomorphic cell networks. Two clusters belong to the same class if there is a bijection between their cells which
+ * preserves the connections and the analyzed cell attributes (max connections, number of connections, living state, execution order numbers, output
+ * blocking, color and cell function).
+ * Each cluster is first assigned a canonical hash by Weisfeiler-Lehman refinement of the cell attributes along the connections. Clusters are bucketed
+ * by the hash and the buckets are verified by a backtracking search for an isomorphism guided by the refined labels. Both steps run in parallel.
+ * The search is limited to a fixed number of steps per pair of clusters. If the limit is exceeded, clusters with the same canonical hash are put into
+ * the same class without verification, i.e. in rare cases a class may contain non-isomorphic cell networks.
+ */
+class PatternAnalysisService
+{
+public:
+    //classes are sorted by the number of elements in descending order
+    static std::vector<PatternClass> calcPatternClasses(ClusteredDataDescription const& data);
+
+    //invariant under renumbering and reordering of the cells
+    static uint64_t calcCanonicalHash(ClusterDescription const& cluster);
+
+    //returns true without verification if the search exceeds its step limit and both clusters have the same canonical hash
+    static bool isIsomorphic(ClusterDescription const& cluster1, ClusterDescription const& cluster2);
+};
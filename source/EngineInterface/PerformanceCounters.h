@@ -0,0 +1,24 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "ArraySizes.h"
+
+struct ArrayResizeEvent
+{
+    uint64_t timestep = 0;
+    ArraySizes arraySizes;  //sizes after resizing
+    std::chrono::microseconds duration = {};
+};
+
+/**
+ * Accumulated durations of the engine since the creation of the simulation. The difference of two snapshots yields the durations of an interval.
+ */
+struct PerformanceCounters
+{
+    std::chrono::microseconds timestepDuration = {};  //simulation kernels of the time steps
+    std::chrono::microseconds statisticsDuration = {};
+    std::chrono::microseconds dataTransferDuration = {};  //access kernels and copies between host and device
+    std::vector<ArrayResizeEvent> resizeEvents;
+};
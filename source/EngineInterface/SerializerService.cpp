@@ -25,9 +25,12 @@
 #include "Descriptions.h"
 #include "SimulationParameters.h"
 #include "AuxiliaryDataParserService.h"
+#include "ChunkedSerializerService.h"
+#include "ColumnarSerializerService.h"
 #include "GenomeConstants.h"
 #include "GenomeDescriptions.h"
 #include "GenomeDescriptionService.h"
+#include "StatisticsSerializerService.h"
 
 #define SPLIT_SERIALIZATION(Classname) \
     template <class Archive> \
@@ -834,22 +837,47 @@ namespace cereal
     }
 }
 
-bool SerializerService::serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data)
+bool SerializerService::serializeSimulationToFiles(
+    std::string const& filename,
+    DeserializedSimulation const& data,
+    CompressionSettings const& compressionSettings)
 {
     try {
         log(Priority::Important, "save simulation to " + filename);
-        std::filesystem::path settingsFilename(filename);
-        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
-        std::filesystem::path statisticsFilename(filename);
-        statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
-
         {
-            zstr::ofstream stream(filename, std::ios::binary);
+            std::ofstream stream(filename, std::ios::binary);
             if (!stream) {
                 return false;
             }
-            serializeDataDescription(data.mainData, stream);
+            ChunkedSerializerService::serialize(data.mainData, stream, compressionSettings);
+        }
+        return serializeAuxiliaryDataToFiles(filename, data);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::deserializeSimulationFromFiles(DeserializedSimulation& data, std::string const& filename)
+{
+    try {
+        log(Priority::Important, "load simulation from " + filename);
+        if (!deserializeDataDescription(data.mainData, filename)) {
+            return false;
         }
+        return deserializeAuxiliaryDataFromFiles(data, filename);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::serializeAuxiliaryDataToFiles(std::string const& filename, DeserializedSimulation const& data)
+{
+    try {
+        std::filesystem::path settingsFilename(filename);
+        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+        std::filesystem::path statisticsFilename(filename);
+        statisticsFilename.replace_extension(std::filesystem::path(".statistics.bin"));
+
         {
             std::ofstream stream(settingsFilename.string(), std::ios::binary);
             if (!stream) {
@@ -862,7 +890,7 @@ bool SerializerService::serializeSimulationToFiles(std::string const& filename,
             if (!stream) {
                 return false;
             }
-            serializeStatistics(data.statistics, stream);
+            StatisticsSerializerService::serialize(data.statistics, stream);
         }
         return true;
     } catch (...) {
@@ -870,18 +898,18 @@ bool SerializerService::serializeSimulationToFiles(std::string const& filename,
     }
 }
 
-bool SerializerService::deserializeSimulationFromFiles(DeserializedSimulation& data, std::string const& filename)
+bool SerializerService::deserializeAuxiliaryDataFromFiles(DeserializedSimulation& data, std::string const& filename)
 {
     try {
-        log(Priority::Important, "load simulation from " + filename);
         std::filesystem::path settingsFilename(filename);
         settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+        //statistics of older files are stored as CSV
         std::filesystem::path statisticsFilename(filename);
-        statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
-
-        if (!deserializeDataDescription(data.mainData, filename)) {
-            return false;
+        statisticsFilename.replace_extension(std::filesystem::path(".statistics.bin"));
+        if (!std::filesystem::exists(statisticsFilename)) {
+            statisticsFilename.replace_extension(std::filesystem::path(".csv"));
         }
+
         {
             std::ifstream stream(settingsFilename.string(), std::ios::binary);
             if (!stream) {
@@ -902,18 +930,85 @@ bool SerializerService::deserializeSimulationFromFiles(DeserializedSimulation& d
     }
 }
 
-bool SerializerService::serializeSimulationToStrings(SerializedSimulation& output, DeserializedSimulation const& input)
+bool SerializerService::deserializeMainDataFromFile(
+    std::string const& filename,
+    std::function<void(MainDataSummary const&)> const& summaryCallback,
+    std::function<void(ClusteredDataDescription const& batch)> const& batchCallback)
 {
     try {
-        {
-            std::stringstream stdStream;
-            zstr::ostream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
+        log(Priority::Important, "load simulation from " + filename);
+        std::ifstream stream(filename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        if (ChunkedSerializerService::isChunkedFormat(stream)) {
+            summaryCallback(ChunkedSerializerService::readSummary(stream));
+            ChunkedSerializerService::deserializeInBatches(stream, batchCallback);
+        } else {
+            ClusteredDataDescription data;
+            deserializeMainData(data, stream);
+
+            MainDataSummary summary{.numClusters = data.clusters.size(), .numParticles = data.particles.size()};
+            for (auto const& cluster : data.clusters) {
+                summary.numCells += cluster.cells.size();
+                for (auto const& cell : cluster.cells) {
+                    summary.auxiliaryDataSize += cell.getAuxiliaryDataSize();
+                }
+            }
+            summaryCallback(summary);
+            batchCallback(data);
+        }
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::deserializeRegionFromFile(ClusteredDataDescription& data, std::string const& filename, RealRect const& rect)
+{
+    try {
+        log(Priority::Important, "load region from " + filename);
+        std::ifstream stream(filename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        if (ChunkedSerializerService::isChunkedFormat(stream)) {
+            ChunkedSerializerService::deserializeRegion(data, stream, rect);
+        } else {
+            ClusteredDataDescription allData;
+            deserializeMainData(allData, stream);
+
+            auto isInside = [&rect](RealVector2D const& pos) {
+                return pos.x >= rect.topLeft.x && pos.y >= rect.topLeft.y && pos.x < rect.bottomRight.x && pos.y < rect.bottomRight.y;
+            };
+            data.clear();
+            for (auto& cluster : allData.clusters) {
+                if (isInside(cluster.getClusterPosFromCells())) {
+                    data.clusters.emplace_back(std::move(cluster));
+                }
+            }
+            for (auto& particle : allData.particles) {
+                if (isInside(particle.pos)) {
+                    data.particles.emplace_back(std::move(particle));
+                }
             }
-            serializeDataDescription(input.mainData, stream);
-            stream.flush();
-            output.mainData = stdStream.str();
+        }
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::serializeSimulationToStrings(
+    SerializedSimulation& output,
+    DeserializedSimulation const& input,
+    CompressionSettings const& compressionSettings)
+{
+    try {
+        {
+            std::stringstream stream;
+            ChunkedSerializerService::serialize(input.mainData, stream, compressionSettings);
+            output.mainData = stream.str();
         }
         {
             std::stringstream stream;
@@ -922,7 +1017,7 @@ bool SerializerService::serializeSimulationToStrings(SerializedSimulation& outpu
         }
         {
             std::stringstream stream;
-            serializeStatistics(input.statistics, stream);
+            StatisticsSerializerService::serialize(input.statistics, stream);
             output.statistics = stream.str();
         }
         return true;
@@ -935,12 +1030,8 @@ bool SerializerService::deserializeSimulationFromStrings(DeserializedSimulation&
 {
     try {
         {
-            std::stringstream stdStream(input.mainData);
-            zstr::istream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
-            deserializeDataDescription(output.mainData, stream);
+            std::stringstream stream(input.mainData);
+            deserializeMainData(output.mainData, stream);
         }
         {
             std::stringstream stream(input.auxiliaryData);
@@ -1087,6 +1178,25 @@ bool SerializerService::serializeStatisticsToFile(std::string const& filename, S
     }
 }
 
+bool SerializerService::appendStatisticsToFile(std::string const& filename, StatisticsHistoryData const& statistics)
+{
+    try {
+        auto writeHeader = !std::filesystem::exists(filename) || std::filesystem::file_size(filename) == 0;
+        std::ofstream stream(filename, std::ios::binary | std::ios::app);
+        if (!stream) {
+            return false;
+        }
+        if (writeHeader) {
+            serializeStatisticsHeader(stream);
+        }
+        serializeStatisticsRows(statistics, stream);
+        stream.flush();
+        return static_cast<bool>(stream);
+    } catch (...) {
+        return false;
+    }
+}
+
 bool SerializerService::serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content)
 {
     try {
@@ -1116,23 +1226,26 @@ bool SerializerService::deserializeContentFromFile(ClusteredDataDescription& con
 
 void SerializerService::serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream)
 {
-    cereal::PortableBinaryOutputArchive archive(stream);
-    archive(Const::ProgramVersion);
-    archive(data);
+    ColumnarSerializerService::serialize(data, stream);
 }
 
 bool SerializerService::deserializeDataDescription(ClusteredDataDescription& data, std::string const& filename)
 {
-    zstr::ifstream stream(filename, std::ios::binary);
+    std::ifstream stream(filename, std::ios::binary);
     if (!stream) {
         return false;
     }
-    deserializeDataDescription(data, stream);
+    deserializeMainData(data, stream);
     return true;
 }
 
 void SerializerService::deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream)
 {
+    if (ColumnarSerializerService::isColumnarFormat(stream)) {
+        ColumnarSerializerService::deserialize(data, stream);
+        return;
+    }
+
     cereal::PortableBinaryInputArchive archive(stream);
     std::string version;
     archive(version);
@@ -1146,6 +1259,16 @@ void SerializerService::deserializeDataDescription(ClusteredDataDescription& dat
     archive(data);
 }
 
+void SerializerService::deserializeMainData(ClusteredDataDescription& data, std::istream& rawStream)
+{
+    if (ChunkedSerializerService::isChunkedFormat(rawStream)) {
+        ChunkedSerializerService::deserialize(data, rawStream);
+    } else {
+        zstr::istream stream(rawStream);
+        deserializeDataDescription(data, stream);
+    }
+}
+
 void SerializerService::serializeAuxiliaryData(AuxiliaryData const& auxiliaryData, std::ostream& stream)
 {
     boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::encodeAuxiliaryData(auxiliaryData));
@@ -1241,7 +1364,12 @@ namespace
 
 void SerializerService::serializeStatistics(StatisticsHistoryData const& statistics, std::ostream& stream)
 {
-    //header row
+    serializeStatisticsHeader(stream);
+    serializeStatisticsRows(statistics, stream);
+}
+
+void SerializerService::serializeStatisticsHeader(std::ostream& stream)
+{
     stream << "Time step";
     auto writeLabelAllColors = [&stream](auto const& name) {
         for (int i = 0; i < MAX_COLORS; ++i) {
@@ -1273,8 +1401,10 @@ void SerializerService::serializeStatistics(StatisticsHistoryData const& statist
     writeLabelAllColors("Colonies");
     writeLabelAllColors("Average genome complexity");
     stream << std::endl;
+}
 
-    //content
+void SerializerService::serializeStatisticsRows(StatisticsHistoryData const& statistics, std::ostream& stream)
+{
     for (auto dataPoints : statistics) {
         std::vector<std::string> entries;
         loadSave(SerializationTask::Save, entries, dataPoints);
@@ -1284,6 +1414,11 @@ void SerializerService::serializeStatistics(StatisticsHistoryData const& statist
 
 void SerializerService::deserializeStatistics(StatisticsHistoryData& statistics, std::istream& stream)
 {
+    if (StatisticsSerializerService::isBinaryFormat(stream)) {
+        StatisticsSerializerService::deserialize(statistics, stream);
+        return;
+    }
+
     statistics.clear();
 
     std::vector<std::vector<std::string>> data;
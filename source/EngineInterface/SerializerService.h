@@ -1,10 +1,14 @@
 #pragma once
 
+#include <functional>
+
 #include "Base/Definitions.h"
 
 #include "Definitions.h"
 #include "AuxiliaryData.h"
+#include "CompressionSettings.h"
 #include "Descriptions.h"
+#include "MainDataSummary.h"
 #include "StatisticsHistory.h"
 
 struct DeserializedSimulation
@@ -24,10 +28,29 @@ struct SerializedSimulation
 class SerializerService
 {
 public:
-    static bool serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data);
+    static bool serializeSimulationToFiles(
+        std::string const& filename,
+        DeserializedSimulation const& data,
+        CompressionSettings const& compressionSettings = CompressionSettings());
     static bool deserializeSimulationFromFiles(DeserializedSimulation& data, std::string const& filename);
 
-    static bool serializeSimulationToStrings(SerializedSimulation& output, DeserializedSimulation const& input);
+    //only settings and statistics files (e.g. for main data stored as raw image)
+    static bool serializeAuxiliaryDataToFiles(std::string const& filename, DeserializedSimulation const& data);
+    static bool deserializeAuxiliaryDataFromFiles(DeserializedSimulation& data, std::string const& filename);
+
+    //main data is passed in batches to the callback such that the whole simulation is never held in memory (older formats yield a single batch)
+    static bool deserializeMainDataFromFile(
+        std::string const& filename,
+        std::function<void(MainDataSummary const&)> const& summaryCallback,
+        std::function<void(ClusteredDataDescription const& batch)> const& batchCallback);
+
+    //only clusters whose centers and particles whose positions lie in the rectangle are loaded (for older formats the whole file is decoded)
+    static bool deserializeRegionFromFile(ClusteredDataDescription& data, std::string const& filename, RealRect const& rect);
+
+    static bool serializeSimulationToStrings(
+        SerializedSimulation& output,
+        DeserializedSimulation const& input,
+        CompressionSettings const& compressionSettings = CompressionSettings());
     static bool deserializeSimulationFromStrings(DeserializedSimulation& output, SerializedSimulation const& input);
 
     static bool serializeGenomeToFile(std::string const& filename, std::vector<uint8_t> const& genome);
@@ -41,6 +64,9 @@ public:
 
     static bool serializeStatisticsToFile(std::string const& filename, StatisticsHistoryData const& statistics);
 
+    //appends rows in the CSV format of serializeStatisticsToFile, the header row is written for empty or new files
+    static bool appendStatisticsToFile(std::string const& filename, StatisticsHistoryData const& statistics);
+
     static bool serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content);
     static bool deserializeContentFromFile(ClusteredDataDescription& content, std::string const& filename);
 
@@ -49,6 +75,9 @@ private:
     static bool deserializeDataDescription(ClusteredDataDescription& data, std::string const& filename);
     static void deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream);
 
+    //detects chunked container and legacy gzip stream
+    static void deserializeMainData(ClusteredDataDescription& data, std::istream& rawStream);
+
     static void serializeAuxiliaryData(AuxiliaryData const& auxiliaryData, std::ostream& stream);
     static void deserializeAuxiliaryData(AuxiliaryData& auxiliaryData, std::istream& stream);
 
@@ -56,6 +85,8 @@ private:
     static void deserializeSimulationParameters(SimulationParameters& parameters, std::istream& stream);
 
     static void serializeStatistics(StatisticsHistoryData const& statistics, std::ostream& stream);
+    static void serializeStatisticsHeader(std::ostream& stream);
+    static void serializeStatisticsRows(StatisticsHistoryData const& statistics, std::ostream& stream);
     static void deserializeStatistics(StatisticsHistoryData& statistics, std::istream& stream);
 
     static bool wrapGenome(ClusteredDataDescription& output, std::vector<uint8_t> const& input);
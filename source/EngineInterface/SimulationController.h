@@ -1,13 +1,20 @@
 #pragma once
+
+#include <future>
+
 #include "Definitions.h"
 #include "OverlayDescriptions.h"
 #include "SelectionShallowData.h"
 #include "Settings.h"
 #include "ShallowUpdateSelectionData.h"
 #include "SimulationController.h"
+#include "SimulationSnapshot.h"
 #include "MutationType.h"
 #include "DataPointCollection.h"
+#include "EngineCommands.h"
 #include "StatisticsHistory.h"
+#include "PerformanceCounters.h"
+#include "TimestepGovernorSettings.h"
 
 class _SimulationController
 {
@@ -41,6 +48,19 @@ public:
     virtual void addAndSelectSimulationData(DataDescription const& dataToAdd) = 0;
     virtual void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) = 0;
     virtual void setSimulationData(DataDescription const& dataToUpdate) = 0;
+
+    //for loading large simulations in batches: reserve capacities once, then add the batches one after the other
+    virtual void reserveSimulationData(uint64_t numCells, uint64_t numParticles, uint64_t auxiliaryDataSize) = 0;
+    virtual void addClusteredSimulationData(ClusteredDataDescription const& dataToAdd) = 0;
+
+    //raw images of the simulation data can be memory-mapped on loading but are only readable by the same program version
+    virtual void saveSimulationDataImage(std::string const& filename) = 0;
+    virtual void loadSimulationDataImage(std::string const& filename) = 0;
+
+    //column-wise copy of the whole simulation without building descriptions
+    virtual SimulationSnapshot getSnapshot() = 0;
+    virtual void setSnapshot(SimulationSnapshot const& snapshot) = 0;
+
     virtual void removeSelectedObjects(bool includeClusters) = 0;
     virtual void relaxSelectedObjects(bool includeClusters) = 0;
     virtual void uniformVelocitiesForSelectedObjects(bool includeClusters) = 0;
@@ -79,6 +99,9 @@ public:
 
     virtual void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius) = 0;
 
+    //edits such as changeCell are also queued and do not block, the future becomes ready when all given commands are executed
+    virtual std::future<void> executeCommands_async(std::vector<EngineCommand> const& commands) = 0;
+
     virtual void switchSelection(RealVector2D const& pos, float radius) = 0;
     virtual void swapSelection(RealVector2D const& pos, float radius) = 0;
     virtual SelectionShallowData getSelectionShallowData(RealVector2D const& refPos = RealVector2D()) = 0;
@@ -96,6 +119,14 @@ public:
     virtual std::optional<int> getTpsRestriction() const = 0;
     virtual void setTpsRestriction(std::optional<int> const& value) = 0;
 
+    //includes the TPS restriction
+    virtual TimestepGovernorSettings getTimestepGovernorSettings() const = 0;
+    virtual void setTimestepGovernorSettings(TimestepGovernorSettings const& settings) = 0;
+    virtual TimestepGovernorMetrics getTimestepGovernorMetrics() const = 0;
+
+    //durations of the engine operations and array resizes since the simulation has been created
+    virtual PerformanceCounters getPerformanceCounters() const = 0;
+
     virtual float getTps() const = 0;
 
     //for tests
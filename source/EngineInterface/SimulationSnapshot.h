@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "CellFunctionConstants.h"
+#include "EngineConstants.h"
+
+//range in SimulationSnapshot::auxiliaryData
+struct SnapshotDataRange
+{
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+//cell function specific values in the binary layout of the engine, they are only interpreted by the engine
+struct SnapshotCellFunctionData
+{
+    alignas(8) uint8_t bytes[64];
+};
+
+/**
+ * Host-side copy of the simulation data as structure of arrays with one contiguous column per field. In contrast to the descriptions,
+ * reading or writing a whole world only needs a handful of allocations.
+ * Connections are stored in CSR form: the connections of cell i are the entries connectionOffsets[i], ..., connectionOffsets[i + 1] - 1.
+ * Genomes, neuron weights and metadata strings are located in the auxiliaryData blob.
+ */
+struct SimulationSnapshot
+{
+    //cells
+    std::vector<uint64_t> cellIds;
+    std::vector<RealVector2D> cellPositions;
+    std::vector<RealVector2D> cellVelocities;
+    std::vector<float> cellEnergies;
+    std::vector<float> cellStiffnesses;
+    std::vector<uint8_t> cellColors;
+    std::vector<uint8_t> cellMaxConnections;
+    std::vector<uint8_t> cellBarriers;
+    std::vector<uint32_t> cellAges;
+    std::vector<LivingState> cellLivingStates;
+    std::vector<uint32_t> cellCreatureIds;
+    std::vector<uint32_t> cellMutationIds;
+    std::vector<uint8_t> cellAncestorMutationIds;
+    std::vector<float> cellGenomeComplexities;
+    std::vector<uint8_t> cellExecutionOrderNumbers;
+    std::vector<int8_t> cellInputExecutionOrderNumbers;
+    std::vector<uint8_t> cellOutputBlocked;
+    std::vector<CellFunction> cellFunctions;
+    std::vector<SnapshotCellFunctionData> cellFunctionData;
+    std::vector<std::array<float, MAX_CHANNELS>> cellActivities;
+    std::vector<uint32_t> cellActivationTimes;
+    std::vector<uint8_t> cellDetectedByCreatureIds;
+    std::vector<CellFunctionUsed> cellFunctionUsed;
+    std::vector<uint8_t> cellSelected;
+    std::vector<SnapshotDataRange> cellGenomes;  //size is 0 for cells without constructor or injector
+    std::vector<SnapshotDataRange> cellNames;
+    std::vector<SnapshotDataRange> cellDescriptions;
+
+    //connections
+    std::vector<uint64_t> connectionOffsets;
+    std::vector<int> connectionCellIndices;
+    std::vector<float> connectionDistances;
+    std::vector<float> connectionAnglesFromPrevious;
+
+    //particles
+    std::vector<uint64_t> particleIds;
+    std::vector<RealVector2D> particlePositions;
+    std::vector<RealVector2D> particleVelocities;
+    std::vector<float> particleEnergies;
+    std::vector<uint8_t> particleColors;
+    std::vector<uint8_t> particleSelected;
+
+    std::vector<uint8_t> auxiliaryData;
+
+    size_t getNumCells() const { return cellIds.size(); }
+    size_t getNumParticles() const { return particleIds.size(); }
+    size_t getNumConnections(size_t cellIndex) const { return connectionOffsets[cellIndex + 1] - connectionOffsets[cellIndex]; }
+
+    std::span<uint8_t const> getGenome(size_t cellIndex) const { return getAuxiliaryData(cellGenomes[cellIndex]); }
+    std::string_view getName(size_t cellIndex) const { return getString(cellNames[cellIndex]); }
+    std::string_view getDescription(size_t cellIndex) const { return getString(cellDescriptions[cellIndex]); }
+
+private:
+    std::span<uint8_t const> getAuxiliaryData(SnapshotDataRange const& range) const
+    {
+        return std::span<uint8_t const>(auxiliaryData.data() + range.offset, range.size);
+    }
+    std::string_view getString(SnapshotDataRange const& range) const
+    {
+        return std::string_view(reinterpret_cast<char const*>(auxiliaryData.data() + range.offset), range.size);
+    }
+};
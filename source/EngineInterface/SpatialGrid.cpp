@@ -0,0 +1,161 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Definitions.h"
+#include "Base/Math.h"
+
+namespace
+{
+    //bounds the memory of the bucket arrays for large worlds, the buckets are enlarged instead
+    auto constexpr MaxNumBuckets = 1 << 20;
+
+    int calcNumBuckets(float extent, float bucketSize)
+    {
+        return std::max(1, toInt(std::floor(extent / bucketSize)));
+    }
+}
+
+SpatialGrid::SpatialGrid(std::vector<RealVector2D> const& positions, float bucketSize, std::optional<IntVector2D> const& worldSize)
+{
+    bucketSize = std::max(bucketSize, NEAR_ZERO);
+    RealVector2D extent;
+    if (worldSize) {
+        _spaceCalculator.emplace(*worldSize);
+        extent = {toFloat(worldSize->x), toFloat(worldSize->y)};
+    } else if (!positions.empty()) {
+        _origin = positions.front();
+        auto upperBound = positions.front();
+        for (auto const& pos : positions) {
+            _origin = {std::min(_origin.x, pos.x), std::min(_origin.y, pos.y)};
+            upperBound = {std::max(upperBound.x, pos.x), std::max(upperBound.y, pos.y)};
+        }
+        //the upper bound must lie inside of the last bucket
+        extent = upperBound - _origin + RealVector2D{bucketSize, bucketSize};
+    }
+    while (static_cast<int64_t>(calcNumBuckets(extent.x, bucketSize)) * calcNumBuckets(extent.y, bucketSize) > MaxNumBuckets) {
+        bucketSize *= 2;
+    }
+
+    //the buckets of a world cover it exactly such that the buckets at opposite borders are neighbors on the torus
+    _numBuckets = {calcNumBuckets(extent.x, bucketSize), calcNumBuckets(extent.y, bucketSize)};
+    _bucketSize = worldSize ? RealVector2D{extent.x / toFloat(_numBuckets.x), extent.y / toFloat(_numBuckets.y)} : RealVector2D{bucketSize, bucketSize};
+
+    auto numBuckets = _numBuckets.x * _numBuckets.y;
+    _positions.reserve(positions.size());
+    std::vector<int> bucketIndices;
+    bucketIndices.reserve(positions.size());
+    _bucketOffsets.assign(numBuckets + 1, 0);
+    for (auto const& pos : positions) {
+        auto const& correctedPos = _positions.emplace_back(getCorrectedPosition(pos));
+        auto bucketIndex = bucketIndices.emplace_back(getBucketIndex(correctedPos));
+        ++_bucketOffsets[bucketIndex + 1];
+    }
+    for (int bucketIndex = 0; bucketIndex < numBuckets; ++bucketIndex) {
+        _bucketOffsets[bucketIndex + 1] += _bucketOffsets[bucketIndex];
+    }
+
+    //counting sort by bucket
+    _sortedEntries.resize(positions.size());
+    auto nextSortedEntries = _bucketOffsets;
+    for (int index = 0; index < toInt(positions.size()); ++index) {
+        _sortedEntries[nextSortedEntries[bucketIndices[index]]++] = Entry{_positions[index], index};
+    }
+
+    _firstInsertedEntries.assign(numBuckets, -1);
+}
+
+int SpatialGrid::insert(RealVector2D const& pos)
+{
+    auto index = toInt(_positions.size());
+    auto const& correctedPos = _positions.emplace_back(getCorrectedPosition(pos));
+    auto bucketIndex = getBucketIndex(correctedPos);
+    _insertedEntries.emplace_back(Entry{correctedPos, index});
+    _nextInsertedEntries.emplace_back(_firstInsertedEntries[bucketIndex]);
+    _firstInsertedEntries[bucketIndex] = toInt(_insertedEntries.size()) - 1;
+    return index;
+}
+
+int SpatialGrid::getNumEntries() const
+{
+    return toInt(_positions.size());
+}
+
+RealVector2D const& SpatialGrid::getPosition(int index) const
+{
+    return _positions.at(index);
+}
+
+template <typename Func>
+bool SpatialGrid::findInBuckets(RealVector2D const& pos, float radius, Func const& func) const
+{
+    //bucket range per axis, on the torus it is wrapped around unless it covers all buckets anyway
+    auto getBucketRange = [&](float coordinate, float origin, float bucketSize, int numBuckets) {
+        auto first = toInt(std::floor((coordinate - radius - origin) / bucketSize));
+        auto last = toInt(std::floor((coordinate + radius - origin) / bucketSize));
+        if (!_spaceCalculator) {
+            return std::make_pair(std::clamp(first, 0, numBuckets - 1), std::clamp(last, 0, numBuckets - 1));
+        }
+        if (last - first + 1 >= numBuckets) {
+            return std::make_pair(0, numBuckets - 1);
+        }
+        return std::make_pair(first, last);
+    };
+    auto wrap = [](int value, int numBuckets) { return (value % numBuckets + numBuckets) % numBuckets; };
+
+    auto [firstX, lastX] = getBucketRange(pos.x, _origin.x, _bucketSize.x, _numBuckets.x);
+    auto [firstY, lastY] = getBucketRange(pos.y, _origin.y, _bucketSize.y, _numBuckets.y);
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int x = firstX; x <= lastX; ++x) {
+            auto bucketIndex = wrap(y, _numBuckets.y) * _numBuckets.x + wrap(x, _numBuckets.x);
+            for (int i = _bucketOffsets[bucketIndex]; i < _bucketOffsets[bucketIndex + 1]; ++i) {
+                if (func(_sortedEntries[i])) {
+                    return true;
+                }
+            }
+            for (int i = _firstInsertedEntries[bucketIndex]; i != -1; i = _nextInsertedEntries[i]) {
+                if (func(_insertedEntries[i])) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+std::vector<int> SpatialGrid::getIndicesWithinRadius(RealVector2D const& pos, float radius) const
+{
+    std::vector<int> result;
+    auto correctedPos = getCorrectedPosition(pos);
+    findInBuckets(correctedPos, radius, [&](Entry const& entry) {
+        if (calcDistance(correctedPos, entry.pos) <= radius) {
+            result.emplace_back(entry.index);
+        }
+        return false;
+    });
+    return result;
+}
+
+bool SpatialGrid::isOccupied(RealVector2D const& pos, float radius) const
+{
+    auto correctedPos = getCorrectedPosition(pos);
+    return findInBuckets(correctedPos, radius, [&](Entry const& entry) { return calcDistance(correctedPos, entry.pos) < radius; });
+}
+
+RealVector2D SpatialGrid::getCorrectedPosition(RealVector2D const& pos) const
+{
+    return _spaceCalculator ? _spaceCalculator->getCorrectedPosition(pos) : pos;
+}
+
+float SpatialGrid::calcDistance(RealVector2D const& pos1, RealVector2D const& pos2) const
+{
+    return _spaceCalculator ? _spaceCalculator->distance(pos1, pos2) : Math::length(pos1 - pos2);
+}
+
+int SpatialGrid::getBucketIndex(RealVector2D const& pos) const
+{
+    auto x = std::clamp(toInt(std::floor((pos.x - _origin.x) / _bucketSize.x)), 0, _numBuckets.x - 1);
+    auto y = std::clamp(toInt(std::floor((pos.y - _origin.y) / _bucketSize.y)), 0, _numBuckets.y - 1);
+    return y * _numBuckets.x + x;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "Base/Vector2D.h"
+
+#include "SpaceCalculator.h"
+
+/**
+ * Uniform grid for radius queries on positions which is stored in flat arrays: the positions passed to the constructor are sorted by bucket
+ * (CSR layout) and further positions can be inserted incrementally into per-bucket lists.
+ * If a world size is given, positions are wrapped around the world and distances are measured on the torus via SpaceCalculator. Otherwise the grid
+ * covers the bounding box of the initial positions and positions outside of it are assigned to the border buckets.
+ */
+class SpatialGrid
+{
+public:
+    //the bucket size is a lower bound and should be in the order of the query radius, it is enlarged if the grid would become too large
+    SpatialGrid(std::vector<RealVector2D> const& positions, float bucketSize, std::optional<IntVector2D> const& worldSize = std::nullopt);
+
+    //returns the index of the new entry, the positions passed to the constructor have the indices 0, ..., n - 1
+    int insert(RealVector2D const& pos);
+
+    int getNumEntries() const;
+
+    //positions are wrapped around the world if a world size is given
+    RealVector2D const& getPosition(int index) const;
+
+    //indices of the entries whose distance to pos is at most radius in unspecified order
+    std::vector<int> getIndicesWithinRadius(RealVector2D const& pos, float radius) const;
+
+    //true if there is an entry whose distance to pos is less than radius
+    bool isOccupied(RealVector2D const& pos, float radius) const;
+
+private:
+    struct Entry
+    {
+        RealVector2D pos;
+        int index = 0;
+    };
+
+    RealVector2D getCorrectedPosition(RealVector2D const& pos) const;
+    float calcDistance(RealVector2D const& pos1, RealVector2D const& pos2) const;
+    int getBucketIndex(RealVector2D const& pos) const;
+
+    //func is called with the entries of all buckets intersecting the square around pos until it returns true
+    template <typename Func>
+    bool findInBuckets(RealVector2D const& pos, float radius, Func const& func) const;
+
+    std::optional<SpaceCalculator> _spaceCalculator;
+    RealVector2D _origin;
+    RealVector2D _bucketSize;
+    IntVector2D _numBuckets;
+
+    std::vector<RealVector2D> _positions;  //by index
+
+    //initial entries sorted by bucket, the entries of bucket i are stored in _sortedEntries[_bucketOffsets[i]], ..., _sortedEntries[_bucketOffsets[i + 1] - 1]
+    std::vector<int> _bucketOffsets;
+    std::vector<Entry> _sortedEntries;
+
+    //incrementally inserted entries as linked lists per bucket (-1 marks the end)
+    std::vector<int> _firstInsertedEntries;
+    std::vector<int> _nextInsertedEntries;
+    std::vector<Entry> _insertedEntries;
+};
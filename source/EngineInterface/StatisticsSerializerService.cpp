@@ -0,0 +1,203 @@
+#include "StatisticsSerializerService.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+#include "CompressionService.h"
+
+//columns are written in host byte order
+static_assert(std::endian::native == std::endian::little, "Statistics format requires a little-endian platform.");
+
+namespace
+{
+    char const Magic[] = {'A', 'L', 'I', 'E', 'N', 'S', 'T', 'A'};
+    uint32_t constexpr FormatVersion = 1;
+
+    using ValueEncoding = int;
+    enum ValueEncoding_
+    {
+        ValueEncoding_Raw,
+        ValueEncoding_Xor
+    };
+
+    //same order as in the CSV export
+    DataPoint DataPointCollection::*const DataPointFields[] = {
+        &DataPointCollection::numCells,
+        &DataPointCollection::numSelfReplicators,
+        &DataPointCollection::numViruses,
+        &DataPointCollection::numConnections,
+        &DataPointCollection::numParticles,
+        &DataPointCollection::averageGenomeCells,
+        &DataPointCollection::totalEnergy,
+        &DataPointCollection::numCreatedCells,
+        &DataPointCollection::numAttacks,
+        &DataPointCollection::numMuscleActivities,
+        &DataPointCollection::numDefenderActivities,
+        &DataPointCollection::numTransmitterActivities,
+        &DataPointCollection::numInjectionActivities,
+        &DataPointCollection::numCompletedInjections,
+        &DataPointCollection::numNervePulses,
+        &DataPointCollection::numNeuronActivities,
+        &DataPointCollection::numSensorActivities,
+        &DataPointCollection::numSensorMatches,
+        &DataPointCollection::numReconnectorCreated,
+        &DataPointCollection::numReconnectorRemoved,
+        &DataPointCollection::numDetonations,
+        &DataPointCollection::numColonies,
+        &DataPointCollection::averageGenomeComplexity,
+    };
+    auto constexpr NumValuesPerDataPoint = MAX_COLORS + 1;
+    auto constexpr NumColumns = 1 + std::size(DataPointFields) * NumValuesPerDataPoint;
+    auto constexpr SamplesPerTile = size_t(256);
+
+    //column 0: time, column 1 + i * 8 + j: value j of data point i (j == 7: summed value)
+    template <typename DataPoints>
+    auto& getValueRef(DataPoints& dataPoints, size_t columnId)
+    {
+        if (columnId == 0) {
+            return dataPoints.time;
+        }
+        auto& dataPoint = dataPoints.*DataPointFields[(columnId - 1) / NumValuesPerDataPoint];
+        auto valueIndex = (columnId - 1) % NumValuesPerDataPoint;
+        return valueIndex < MAX_COLORS ? dataPoint.values[valueIndex] : dataPoint.summedValues;
+    }
+
+    template <typename T>
+    void write(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T read(std::istream& stream)
+    {
+        T result;
+        if (!stream.read(reinterpret_cast<char*>(&result), sizeof(T))) {
+            throw std::runtime_error("Unexpected end of stream.");
+        }
+        return result;
+    }
+
+    //sizes read from the stream are not trusted and are checked against the remaining size of seekable streams before memory is allocated
+    std::optional<uint64_t> getRemainingSize(std::istream& stream)
+    {
+        auto pos = stream.tellg();
+        if (pos == std::streampos(-1)) {
+            return std::nullopt;
+        }
+        stream.seekg(0, std::ios::end);
+        auto endPos = stream.tellg();
+        stream.clear();
+        stream.seekg(pos);
+        if (endPos == std::streampos(-1) || endPos < pos) {
+            return std::nullopt;
+        }
+        return static_cast<uint64_t>(endPos - pos);
+    }
+}
+
+bool StatisticsSerializerService::isBinaryFormat(std::istream& stream)
+{
+    return stream.peek() == Magic[0];
+}
+
+void StatisticsSerializerService::serialize(StatisticsHistoryData const& statistics, std::ostream& stream, CompressionSettings const& settings)
+{
+    auto numSamples = statistics.size();
+    std::string columns(NumColumns * numSamples * sizeof(uint64_t), '\0');
+    auto target = columns.data();
+    for (size_t columnId = 0; columnId < NumColumns; ++columnId) {
+        uint64_t prevBits = 0;
+        for (auto const& dataPoints : statistics) {
+            auto bits = std::bit_cast<uint64_t>(getValueRef(dataPoints, columnId));
+            auto encodedBits = bits ^ prevBits;
+            std::memcpy(target, &encodedBits, sizeof(uint64_t));
+            target += sizeof(uint64_t);
+            prevBits = bits;
+        }
+    }
+    auto compressedColumns = CompressionService::compress(columns, settings);
+
+    stream.write(Magic, sizeof(Magic));
+    write(stream, FormatVersion);
+    write(stream, static_cast<uint64_t>(numSamples));
+    write(stream, static_cast<uint32_t>(NumColumns));
+    for (size_t columnId = 0; columnId < NumColumns; ++columnId) {
+        write(stream, static_cast<uint16_t>(columnId));
+    }
+    write(stream, static_cast<uint8_t>(ValueEncoding_Xor));
+    write(stream, static_cast<uint8_t>(settings.codec));
+    write(stream, static_cast<uint64_t>(columns.size()));
+    write(stream, static_cast<uint64_t>(compressedColumns.size()));
+    stream.write(compressedColumns.data(), compressedColumns.size());
+    if (!stream) {
+        throw std::runtime_error("Could not write stream.");
+    }
+}
+
+void StatisticsSerializerService::deserialize(StatisticsHistoryData& statistics, std::istream& stream)
+{
+    char magic[sizeof(Magic)];
+    if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0) {
+        throw std::runtime_error("No binary statistics format detected.");
+    }
+    if (read<uint32_t>(stream) > FormatVersion) {
+        throw std::runtime_error("Format version not supported.");
+    }
+    auto numSamples = read<uint64_t>(stream);
+    auto numColumns = read<uint32_t>(stream);
+    auto remainingSize = getRemainingSize(stream);
+    if (numColumns == 0 || (remainingSize && numColumns > *remainingSize / sizeof(uint16_t))) {
+        throw std::runtime_error("Invalid number of statistics columns.");
+    }
+    std::vector<uint16_t> columnIds(numColumns);
+    for (auto& columnId : columnIds) {
+        columnId = read<uint16_t>(stream);
+    }
+    auto encoding = read<uint8_t>(stream);
+    auto codec = read<uint8_t>(stream);
+    auto uncompressedSize = read<uint64_t>(stream);
+    auto compressedSize = read<uint64_t>(stream);
+    remainingSize = getRemainingSize(stream);
+    if (remainingSize && compressedSize > *remainingSize) {
+        throw std::runtime_error("Unexpected end of stream.");
+    }
+    if (numSamples > std::numeric_limits<uint64_t>::max() / sizeof(uint64_t) / numColumns
+        || uncompressedSize != numColumns * numSamples * sizeof(uint64_t)) {
+        throw std::runtime_error("Inconsistent statistics size.");
+    }
+    std::vector<char> compressedColumns(compressedSize);
+    if (!stream.read(compressedColumns.data(), compressedColumns.size())) {
+        throw std::runtime_error("Unexpected end of stream.");
+    }
+    auto columns = CompressionService::decompress(compressedColumns, uncompressedSize, codec);
+
+    //samples are processed in tiles such that the written DataPointCollections stay in cache while all columns are decoded
+    //unknown columns are skipped
+    statistics.assign(numSamples, DataPointCollection());
+    std::vector<uint64_t> prevBits(columnIds.size(), 0);
+    for (size_t tileBegin = 0; tileBegin < numSamples; tileBegin += SamplesPerTile) {
+        auto tileEnd = std::min(tileBegin + SamplesPerTile, numSamples);
+        for (size_t i = 0; i < columnIds.size(); ++i) {
+            auto columnId = columnIds[i];
+            if (columnId >= NumColumns) {
+                continue;
+            }
+            auto source = columns.data() + (i * numSamples + tileBegin) * sizeof(uint64_t);
+            for (auto sample = tileBegin; sample < tileEnd; ++sample) {
+                uint64_t bits;
+                std::memcpy(&bits, source, sizeof(uint64_t));
+                source += sizeof(uint64_t);
+                if (encoding == ValueEncoding_Xor) {
+                    bits ^= prevBits[i];
+                }
+                getValueRef(statistics[sample], columnId) = std::bit_cast<double>(bits);
+                prevBits[i] = bits;
+            }
+        }
+    }
+}
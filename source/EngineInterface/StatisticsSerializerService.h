@@ -0,0 +1,22 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+
+#include "CompressionSettings.h"
+#include "StatisticsHistory.h"
+
+/**
+ * Binary format for the statistics history: each value of a DataPointCollection is stored as a column over all samples. Successive values
+ * of a column are XOR-encoded such that slowly changing values result in long runs of zero bytes, the columns are compressed as a whole.
+ * The column ids coincide with the column indices of the CSV export.
+ */
+class StatisticsSerializerService
+{
+public:
+    //checks the first byte of the stream without consuming it
+    static bool isBinaryFormat(std::istream& stream);
+
+    static void serialize(StatisticsHistoryData const& statistics, std::ostream& stream, CompressionSettings const& settings = CompressionSettings());
+    static void deserialize(StatisticsHistoryData& statistics, std::istream& stream);
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+//simulation parameter values in the notation of the *.settings.json files, e.g. {"simulation parameters.friction", "0.001"}
+using ParameterAssignments = std::vector<std::pair<std::string, std::string>>;
+
+//batch of simulation runs derived from one input file
+struct SweepDescription
+{
+    std::string inputFilename;
+    std::string outputDirectory;
+    uint64_t timesteps = 0;
+    std::optional<uint64_t> checkpointInterval;
+    std::optional<uint64_t> statisticsInterval;
+
+    //each variant is run once per seed, the variants are the combinations of the patches with the grid points
+    //seeds are positive because srand treats the seeds 0 and 1 the same in glibc
+    std::vector<uint32_t> seeds = {1};
+    std::vector<std::pair<std::string, std::vector<std::string>>> grid;
+    std::vector<ParameterAssignments> patches;
+};
+
+struct SweepRun
+{
+    int index = 0;
+    std::string name;
+    int variant = 0;
+    uint32_t seed = 0;
+    ParameterAssignments assignments;
+};
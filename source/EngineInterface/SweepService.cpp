@@ -0,0 +1,219 @@
+#include "SweepService.h"
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "AuxiliaryDataParserService.h"
+#include "SimulationParameters.h"
+
+namespace
+{
+    template <typename T>
+    T getValue(boost::property_tree::ptree const& tree, std::string const& key)
+    {
+        auto result = tree.get_optional<T>(key);
+        if (!result) {
+            throw std::runtime_error("Invalid or missing entry \"" + key + "\" in sweep description.");
+        }
+        return *result;
+    }
+
+    template <typename T>
+    std::optional<T> getOptionalValue(boost::property_tree::ptree const& tree, std::string const& key)
+    {
+        if (tree.find(key) == tree.not_found()) {
+            return std::nullopt;
+        }
+        return getValue<T>(tree, key);
+    }
+
+    //JSON arrays are represented by children with empty keys
+    std::vector<std::string> getArrayValues(boost::property_tree::ptree const& tree, std::string const& key)
+    {
+        std::vector<std::string> result;
+        for (auto const& [childKey, child] : tree) {
+            if (!childKey.empty() || !child.empty()) {
+                throw std::runtime_error("Entry \"" + key + "\" in sweep description must be an array of values.");
+            }
+            result.emplace_back(child.data());
+        }
+        return result;
+    }
+
+    void flattenAssignments(ParameterAssignments& result, boost::property_tree::ptree const& tree, std::string const& prefix)
+    {
+        for (auto const& [key, child] : tree) {
+            auto path = prefix.empty() ? key : prefix + "." + key;
+            if (child.empty()) {
+                result.emplace_back(path, child.data());
+            } else {
+                flattenAssignments(result, child, path);
+            }
+        }
+    }
+
+    bool isEqualValue(std::string const& value, std::string const& otherValue)
+    {
+        if (value == otherValue) {
+            return true;
+        }
+        auto toBoolString = [](std::string const& s) { return s == "1" ? std::string("true") : s == "0" ? std::string("false") : s; };
+        if (toBoolString(value) == toBoolString(otherValue)) {
+            return true;
+        }
+        try {
+            size_t pos, otherPos;
+            auto number = std::stod(value, &pos);
+            auto otherNumber = std::stod(otherValue, &otherPos);
+            return pos == value.size() && otherPos == otherValue.size()
+                && std::abs(number - otherNumber) <= 1e-6 * std::max(1.0, std::max(std::abs(number), std::abs(otherNumber)));
+        } catch (std::exception const&) {
+            return false;
+        }
+    }
+
+    boost::property_tree::ptree* findNode(boost::property_tree::ptree& tree, std::string const& path)
+    {
+        std::vector<std::string> segments;
+        boost::split(segments, path, boost::is_any_of("."));
+        auto node = &tree;
+        for (auto const& segment : segments) {
+            auto it = node->find(segment);
+            if (it == node->not_found()) {
+                return nullptr;
+            }
+            node = &it->second;
+        }
+        return node;
+    }
+}
+
+SweepDescription SweepService::decodeSweepDescription(boost::property_tree::ptree const& tree)
+{
+    SweepDescription result;
+    result.inputFilename = getValue<std::string>(tree, "input");
+    result.outputDirectory = getValue<std::string>(tree, "output directory");
+    result.timesteps = getValue<uint64_t>(tree, "time steps");
+    result.checkpointInterval = getOptionalValue<uint64_t>(tree, "checkpoint interval");
+    result.statisticsInterval = getOptionalValue<uint64_t>(tree, "statistics interval");
+    if (result.checkpointInterval == 0 || result.statisticsInterval == 0) {
+        throw std::runtime_error("Intervals in sweep description must be positive.");
+    }
+
+    if (auto seedsIt = tree.find("seeds"); seedsIt != tree.not_found()) {
+        result.seeds.clear();
+        for (auto const& value : getArrayValues(seedsIt->second, "seeds")) {
+            auto seed = std::stoull(value);
+            if (seed == 0 || seed > std::numeric_limits<uint32_t>::max()) {
+                throw std::runtime_error("Seeds in sweep description must be positive 32 bit numbers.");
+            }
+            result.seeds.emplace_back(static_cast<uint32_t>(seed));
+        }
+    } else if (auto replicates = getOptionalValue<int>(tree, "replicates")) {
+        result.seeds.clear();
+        for (int i = 1; i <= *replicates; ++i) {
+            result.seeds.emplace_back(static_cast<uint32_t>(i));
+        }
+    }
+    if (result.seeds.empty()) {
+        throw std::runtime_error("Sweep description contains no seeds.");
+    }
+
+    if (auto gridIt = tree.find("grid"); gridIt != tree.not_found()) {
+        for (auto const& [key, values] : gridIt->second) {
+            result.grid.emplace_back(key, getArrayValues(values, key));
+            if (result.grid.back().second.empty()) {
+                throw std::runtime_error("Grid entry \"" + key + "\" in sweep description contains no values.");
+            }
+        }
+    }
+    if (auto patchesIt = tree.find("patches"); patchesIt != tree.not_found()) {
+        for (auto const& [key, patch] : patchesIt->second) {
+            ParameterAssignments assignments;
+            flattenAssignments(assignments, patch, "");
+            result.patches.emplace_back(assignments);
+        }
+    }
+    return result;
+}
+
+SweepDescription SweepService::loadSweepDescription(std::string const& filename)
+{
+    std::ifstream stream(filename);
+    if (!stream) {
+        throw std::runtime_error("Could not open sweep description " + filename + ".");
+    }
+    boost::property_tree::ptree tree;
+    try {
+        boost::property_tree::read_json(stream, tree);
+    } catch (boost::property_tree::json_parser_error const& e) {
+        throw std::runtime_error("Could not parse sweep description: " + std::string(e.what()));
+    }
+    return decodeSweepDescription(tree);
+}
+
+std::vector<SweepRun> SweepService::createRuns(SweepDescription const& description)
+{
+    //cartesian product of the grid values, the last grid entry varies fastest
+    std::vector<ParameterAssignments> gridPoints = {{}};
+    for (auto const& [key, values] : description.grid) {
+        std::vector<ParameterAssignments> newGridPoints;
+        for (auto const& gridPoint : gridPoints) {
+            for (auto const& value : values) {
+                newGridPoints.emplace_back(gridPoint);
+                newGridPoints.back().emplace_back(key, value);
+            }
+        }
+        gridPoints = std::move(newGridPoints);
+    }
+
+    auto patches = description.patches.empty() ? std::vector<ParameterAssignments>{{}} : description.patches;
+
+    std::vector<SweepRun> result;
+    int variant = 0;
+    for (auto const& patch : patches) {
+        for (auto const& gridPoint : gridPoints) {
+            for (auto const& seed : description.seeds) {
+                SweepRun run;
+                run.index = toInt(result.size());
+                auto number = std::to_string(run.index);
+                run.name = "run-" + std::string(std::max(0, 4 - toInt(number.size())), '0') + number;
+                run.variant = variant;
+                run.seed = seed;
+                run.assignments = patch;
+                run.assignments.insert(run.assignments.end(), gridPoint.begin(), gridPoint.end());
+                result.emplace_back(run);
+            }
+            ++variant;
+        }
+    }
+    return result;
+}
+
+SimulationParameters SweepService::applyAssignments(SimulationParameters const& parameters, ParameterAssignments const& assignments)
+{
+    auto tree = AuxiliaryDataParserService::encodeSimulationParameters(parameters);
+    for (auto const& [key, value] : assignments) {
+        auto node = findNode(tree, key);
+        if (!node || !node->empty()) {
+            throw std::runtime_error("Unknown simulation parameter \"" + key + "\".");
+        }
+        node->data() = value;
+    }
+    auto result = AuxiliaryDataParserService::decodeSimulationParameters(tree);
+
+    //values which cannot be parsed are replaced by defaults during decoding
+    auto resultTree = AuxiliaryDataParserService::encodeSimulationParameters(result);
+    for (auto const& [key, value] : assignments) {
+        auto node = findNode(resultTree, key);
+        if (!node || !isEqualValue(value, node->data())) {
+            throw std::runtime_error("Invalid value \"" + value + "\" for simulation parameter \"" + key + "\".");
+        }
+    }
+    return result;
+}
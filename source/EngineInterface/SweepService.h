@@ -0,0 +1,31 @@
+#pragma once
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "Definitions.h"
+#include "SweepDescription.h"
+
+/**
+ * Sweep description format (JSON):
+ * {
+ *   "input": "seed.sim",
+ *   "output directory": "results",
+ *   "time steps": 100000,
+ *   "checkpoint interval": 10000,                                  (optional)
+ *   "statistics interval": 1000,                                   (optional)
+ *   "seeds": [1, 2, 3]  or  "replicates": 3,                       (optional, replicates n uses the seeds 1, ..., n)
+ *   "grid": {"simulation parameters.friction": [0.001, 0.002]},    (optional)
+ *   "patches": [{"simulation parameters.rigidity": 0.1}, ...]      (optional, nested objects are also accepted)
+ * }
+ * Invalid descriptions and unknown parameters throw std::runtime_error.
+ */
+class SweepService
+{
+public:
+    static SweepDescription decodeSweepDescription(boost::property_tree::ptree const& tree);
+    static SweepDescription loadSweepDescription(std::string const& filename);
+
+    static std::vector<SweepRun> createRuns(SweepDescription const& description);
+
+    static SimulationParameters applyAssignments(SimulationParameters const& parameters, ParameterAssignments const& assignments);
+};
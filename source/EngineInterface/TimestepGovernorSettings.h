@@ -0,0 +1,33 @@
+#pragma once
+
+#include <optional>
+
+//constraints for the time step rate, all given constraints are met
+struct TimestepGovernorSettings
+{
+    std::optional<int> maxTps;
+    std::optional<float> maxCoreUsage;  //fraction of a CPU core for the simulation thread in (0, 1], only for free running simulations
+    std::optional<int> targetFps;       //only for sync with rendering: the time steps per frame are adapted to keep this frame rate
+
+    bool operator==(TimestepGovernorSettings const&) const = default;
+};
+
+using GovernorLimit = int;
+enum GovernorLimit_
+{
+    GovernorLimit_None,
+    GovernorLimit_Tps,
+    GovernorLimit_CoreUsage,
+    GovernorLimit_FrameBudget
+};
+
+struct TimestepGovernorMetrics
+{
+    float tps = 0;
+    float timestepDuration = 0;  //smoothed duration of a time step in ms
+    float coreUsage = 0;         //smoothed fraction of the wall-clock time spent on time steps
+    float pauseDuration = 0;     //last pause between time steps in ms
+    float frameDuration = 0;     //smoothed frame duration without time steps in ms (sync with rendering)
+    int timestepsPerFrame = 0;   //last number of time steps per frame (sync with rendering)
+    GovernorLimit limit = GovernorLimit_None;  //constraint which determined the last decision
+};
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "EngineImpl/AccessDataTOCache.h"
+
+class AccessDataTOCacheTests : public ::testing::Test
+{
+protected:
+    _AccessDataTOCache _dataTOCache;
+};
+
+TEST_F(AccessDataTOCacheTests, reuseBuffer)
+{
+    auto dataTO = _dataTOCache.getDataTO({100, 10, 1000});
+    *dataTO.numCells = 10;
+    *dataTO.numParticles = 1;
+    *dataTO.numAuxiliaryData = 100;
+
+    //capacities and not the filled sizes decide whether the arrays can be reused
+    auto otherDataTO = _dataTOCache.getDataTO({100, 10, 1000});
+    EXPECT_EQ(dataTO.cells, otherDataTO.cells);
+    EXPECT_EQ(dataTO.particles, otherDataTO.particles);
+    EXPECT_EQ(dataTO.auxiliaryData, otherDataTO.auxiliaryData);
+    EXPECT_EQ(0, *otherDataTO.numCells);
+    EXPECT_EQ(0, *otherDataTO.numParticles);
+    EXPECT_EQ(0, *otherDataTO.numAuxiliaryData);
+
+    _dataTOCache.getDataTO({50, 5, 500});
+    auto capacities = _dataTOCache.getCapacities(0);
+    EXPECT_EQ(100, capacities.cellArraySize);
+    EXPECT_EQ(10, capacities.particleArraySize);
+    EXPECT_EQ(1000, capacities.auxiliaryDataSize);
+}
+
+TEST_F(AccessDataTOCacheTests, geometricGrowth)
+{
+    _dataTOCache.getDataTO({100, 10, 1000});
+    _dataTOCache.getDataTO({101, 10, 1001});
+
+    auto capacities = _dataTOCache.getCapacities(0);
+    EXPECT_EQ(150, capacities.cellArraySize);
+    EXPECT_EQ(10, capacities.particleArraySize);
+    EXPECT_EQ(1500, capacities.auxiliaryDataSize);
+
+    _dataTOCache.getDataTO({1000, 10, 1000});
+    EXPECT_EQ(1000, _dataTOCache.getCapacities(0).cellArraySize);
+}
+
+TEST_F(AccessDataTOCacheTests, multipleBuffers)
+{
+    ASSERT_EQ(2, _dataTOCache.getNumBuffers());
+
+    auto dataTO0 = _dataTOCache.getDataTO({10, 10, 10}, 0);
+    auto dataTO1 = _dataTOCache.getDataTO({10, 10, 10}, 1);
+    EXPECT_NE(dataTO0.cells, dataTO1.cells);
+    EXPECT_NE(dataTO0.numCells, dataTO1.numCells);
+
+    *dataTO1.numCells = 5;
+    dataTO1.cells[4].id = 42;
+    _dataTOCache.getDataTO({20, 20, 20}, 0);
+
+    auto filledDataTO = _dataTOCache.getFilledDataTO(1);
+    EXPECT_EQ(5, *filledDataTO.numCells);
+    EXPECT_EQ(42, filledDataTO.cells[4].id);
+    EXPECT_FALSE(_dataTOCache.isPinned(1));
+}
+
+TEST_F(AccessDataTOCacheTests, emptyDataTO)
+{
+    auto dataTO = _dataTOCache.getDataTO({0, 0, 0});
+    EXPECT_NE(nullptr, dataTO.cells);
+    EXPECT_NE(nullptr, dataTO.particles);
+    EXPECT_NE(nullptr, dataTO.auxiliaryData);
+}
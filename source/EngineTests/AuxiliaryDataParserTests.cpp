@@ -0,0 +1,152 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <gtest/gtest.h>
+
+#include "Base/JsonParser.h"
+#include "EngineInterface/AuxiliaryDataParserService.h"
+
+class AuxiliaryDataParserTests : public ::testing::Test
+{
+protected:
+    SimulationParameters createParameters() const
+    {
+        SimulationParameters result;
+        result.numSpots = 2;
+        result.numRadiationSources = 1;
+        result.baseValues.friction = 0.25f;
+        result.baseValues.radiationCellAgeStrength[2] = 0.0123f;
+        result.baseValues.cellFunctionAttackerFoodChainColorMatrix[3][4] = 0.75f;
+        result.spots[1].values.friction = 0.5f;
+        result.spots[1].activatedValues.friction = true;
+        result.cellMaxAgeBalancerInterval = 12345;
+        return result;
+    }
+
+    std::string toJson(boost::property_tree::ptree const& tree) const
+    {
+        std::stringstream stream;
+        boost::property_tree::json_parser::write_json(stream, tree);
+        return stream.str();
+    }
+
+    boost::property_tree::ptree fromJson(std::string const& json) const
+    {
+        std::stringstream stream(json);
+        boost::property_tree::ptree result;
+        boost::property_tree::json_parser::read_json(stream, result);
+        return result;
+    }
+
+    void collectLeafPaths(std::vector<std::string>& result, boost::property_tree::ptree const& tree, std::string const& prefix) const
+    {
+        for (auto const& [key, child] : tree) {
+            auto path = prefix.empty() ? key : prefix + "." + key;
+            if (child.empty()) {
+                result.emplace_back(path);
+            } else {
+                collectLeafPaths(result, child, path);
+            }
+        }
+    }
+};
+
+TEST_F(AuxiliaryDataParserTests, roundTrip)
+{
+    auto parameters = createParameters();
+    auto json = toJson(AuxiliaryDataParserService::encodeSimulationParameters(parameters));
+    auto loadedParameters = AuxiliaryDataParserService::decodeSimulationParameters(fromJson(json));
+    EXPECT_TRUE(parameters == loadedParameters);
+}
+
+//the values must be formatted and looked up exactly as with boost's path based put/get such that existing settings files stay byte-identical
+TEST_F(AuxiliaryDataParserTests, compatibilityWithPropertyPaths)
+{
+    auto parameters = createParameters();
+    auto tree = AuxiliaryDataParserService::encodeSimulationParameters(parameters);
+    EXPECT_EQ(to_string_with_precision(parameters.baseValues.friction, 8), tree.get<std::string>("simulation parameters.friction"));
+    EXPECT_EQ(
+        to_string_with_precision(parameters.baseValues.radiationCellAgeStrength[2], 8), tree.get<std::string>("simulation parameters.radiation.factor[2]"));
+    EXPECT_EQ(
+        to_string_with_precision(parameters.baseValues.cellFunctionAttackerFoodChainColorMatrix[3][4], 8),
+        tree.get<std::string>("simulation parameters.cell.function.attacker.food chain color matrix[3, 4]"));
+    EXPECT_EQ(std::string("12345"), tree.get<std::string>("simulation parameters.cell.max age.balance.interval"));
+
+    boost::property_tree::ptree legacyTree;
+    legacyTree.put("simulation parameters.friction", " 0.3 ");
+    legacyTree.put("simulation parameters.cell.max age.balance.enabled", "1");
+    legacyTree.put("simulation parameters.cell.max age.balance.interval", "5.5");
+    auto legacyParameters = AuxiliaryDataParserService::decodeSimulationParameters(legacyTree);
+    EXPECT_EQ(0.3f, legacyParameters.baseValues.friction);
+    EXPECT_TRUE(legacyParameters.cellMaxAgeBalancer);
+    EXPECT_EQ(SimulationParameters().cellMaxAgeBalancerInterval, legacyParameters.cellMaxAgeBalancerInterval);
+}
+
+//microbenchmark: per-field access via JsonParser in comparison to boost's path based put/get with stream formatting used before
+//disabled by default, run with --gtest_also_run_disabled_tests
+TEST_F(AuxiliaryDataParserTests, DISABLED_benchmark)
+{
+    auto constexpr NumRepetitions = 10;
+
+    auto parameters = createParameters();
+    parameters.numSpots = MAX_SPOTS;
+    auto json = toJson(AuxiliaryDataParserService::encodeSimulationParameters(parameters));
+    auto tree = fromJson(json);
+    std::vector<std::string> paths;
+    collectLeafPaths(paths, tree, "");
+    std::vector<float> values;
+    for (auto const& path : paths) {
+        values.emplace_back(tree.get<float>(path, 0.0f));
+    }
+
+    auto measure = [&](auto const& function) {
+        auto startTime = std::chrono::steady_clock::now();
+        for (int i = 0; i < NumRepetitions; ++i) {
+            function();
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count() / NumRepetitions;
+    };
+
+    boost::property_tree::ptree propertyPathTree;
+    auto propertyPathEncodeTime = measure([&] {
+        propertyPathTree = boost::property_tree::ptree();
+        for (size_t i = 0; i < paths.size(); ++i) {
+            propertyPathTree.put(paths[i], to_string_with_precision(values[i], 8));
+        }
+    });
+    boost::property_tree::ptree jsonParserTree;
+    auto jsonParserEncodeTime = measure([&] {
+        jsonParserTree = boost::property_tree::ptree();
+        for (size_t i = 0; i < paths.size(); ++i) {
+            JsonParser::encodeDecode(jsonParserTree, values[i], 0.0f, paths[i], ParserTask::Encode);
+        }
+    });
+    EXPECT_EQ(toJson(propertyPathTree), toJson(jsonParserTree));
+
+    double propertyPathSum = 0;
+    auto propertyPathDecodeTime = measure([&] {
+        for (auto const& path : paths) {
+            propertyPathSum += propertyPathTree.get<float>(path, 0.0f);
+        }
+    });
+    double jsonParserSum = 0;
+    auto jsonParserDecodeTime = measure([&] {
+        for (auto const& path : paths) {
+            float value;
+            JsonParser::encodeDecode(jsonParserTree, value, 0.0f, path, ParserTask::Decode);
+            jsonParserSum += value;
+        }
+    });
+    EXPECT_EQ(propertyPathSum, jsonParserSum);
+
+    auto encodeTime = measure([&] { toJson(AuxiliaryDataParserService::encodeSimulationParameters(parameters)); });
+    auto decodeTime = measure([&] { AuxiliaryDataParserService::decodeSimulationParameters(fromJson(json)); });
+
+    std::cout << "[ BENCHMARK] " << paths.size() << " fields, encode: " << propertyPathEncodeTime << " us (property paths) vs. " << jsonParserEncodeTime
+              << " us (JsonParser), decode: " << propertyPathDecodeTime << " us (property paths) vs. " << jsonParserDecodeTime << " us (JsonParser)"
+              << std::endl;
+    std::cout << "[ BENCHMARK] settings json with " << json.size() << " bytes, encode: " << encodeTime << " us, decode: " << decodeTime << " us"
+              << std::endl;
+}
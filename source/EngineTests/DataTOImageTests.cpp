@@ -0,0 +1,97 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "EngineImpl/AccessDataTOCache.h"
+#include "EngineImpl/DataTOImage.h"
+#include "EngineInterface/GenomeConstants.h"
+
+class DataTOImageTests : public ::testing::Test
+{
+protected:
+    DataTOImageTests()
+    {
+        _dataTO = _dataTOCache.getDataTO({2, 1, 100});
+        *_dataTO.numCells = 2;
+        *_dataTO.numParticles = 1;
+        *_dataTO.numAuxiliaryData = 10;
+        for (int i = 0; i < 2; ++i) {
+            std::memset(&_dataTO.cells[i], 0, sizeof(CellTO));
+            _dataTO.cells[i].id = i + 1;
+            _dataTO.cells[i].cellFunction = CellFunction_None;
+            _dataTO.cells[i].numConnections = 1;
+            _dataTO.cells[i].connections[0].cellIndex = 1 - i;
+        }
+        _dataTO.cells[0].metadata.nameSize = 10;
+        std::memset(&_dataTO.particles[0], 0, sizeof(ParticleTO));
+        std::memset(_dataTO.auxiliaryData, 'a', 10);
+    }
+
+    ~DataTOImageTests() { std::filesystem::remove(_filename); }
+
+    //overwrites bytes of the image file at the given position
+    template <typename T>
+    void corruptImage(uint64_t pos, T const& value)
+    {
+        std::fstream stream(_filename, std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(pos);
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    std::string _filename = (std::filesystem::temp_directory_path() / "alien_data_to_image_test.img").string();
+    _AccessDataTOCache _dataTOCache;
+    DataTO _dataTO;
+};
+
+TEST_F(DataTOImageTests, roundTrip)
+{
+    DataTOImageService::writeImage(_filename, _dataTO);
+    ASSERT_TRUE(DataTOImageService::isDataTOImage(_filename));
+
+    MappedDataTOImage image(_filename);
+    auto const& dataTO = image.getDataTO();
+    ASSERT_EQ(2, *dataTO.numCells);
+    EXPECT_EQ(1, *dataTO.numParticles);
+    EXPECT_EQ(10, *dataTO.numAuxiliaryData);
+    EXPECT_EQ(2, dataTO.cells[1].id);
+    EXPECT_EQ(0, dataTO.cells[1].connections[0].cellIndex);
+    EXPECT_EQ('a', dataTO.auxiliaryData[9]);
+}
+
+//the number of cells is chosen such that the section end overflows to a small number
+TEST_F(DataTOImageTests, overflowingSectionSize)
+{
+    DataTOImageService::writeImage(_filename, _dataTO);
+
+    auto numCellsPos = 8 + 4 * sizeof(uint32_t) + 32;
+    corruptImage(numCellsPos, std::numeric_limits<uint64_t>::max() / sizeof(CellTO) + 1);
+    EXPECT_THROW(MappedDataTOImage image(_filename), std::runtime_error);
+}
+
+TEST_F(DataTOImageTests, invalidReferences)
+{
+    _dataTO.cells[0].connections[0].cellIndex = 2;
+    DataTOImageService::writeImage(_filename, _dataTO);
+    EXPECT_THROW(MappedDataTOImage image(_filename), std::runtime_error);
+
+    _dataTO.cells[0].connections[0].cellIndex = 1;
+    _dataTO.cells[1].metadata.descriptionDataIndex = 5;
+    _dataTO.cells[1].metadata.descriptionSize = 6;
+    DataTOImageService::writeImage(_filename, _dataTO);
+    EXPECT_THROW(MappedDataTOImage image(_filename), std::runtime_error);
+}
+
+TEST_F(DataTOImageTests, genomeSmallerThanHeader)
+{
+    _dataTO.cells[1].cellFunction = CellFunction_Constructor;
+    _dataTO.cells[1].cellFunctionData.constructor.genomeDataIndex = 0;
+    _dataTO.cells[1].cellFunctionData.constructor.genomeSize = Const::GenomeHeaderSize - 1;
+    DataTOImageService::writeImage(_filename, _dataTO);
+    EXPECT_THROW(MappedDataTOImage image(_filename), std::runtime_error);
+
+    _dataTO.cells[1].cellFunctionData.constructor.genomeSize = Const::GenomeHeaderSize;
+    DataTOImageService::writeImage(_filename, _dataTO);
+    EXPECT_NO_THROW(MappedDataTOImage image(_filename));
+}
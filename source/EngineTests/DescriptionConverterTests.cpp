@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineImpl/AccessDataTOCache.h"
+#include "EngineImpl/DescriptionConverter.h"
+
+class DescriptionConverterTests : public ::testing::Test
+{
+protected:
+    //clusters of chains with 1 to maxClusterSize cells, the cells of all clusters are shuffled
+    DataDescription createData(int numCells, int maxClusterSize) const
+    {
+        std::mt19937 randomEngine(0);
+        std::vector<CellDescription> cells;
+        uint64_t id = 1;
+        while (toInt(cells.size()) < numCells) {
+            auto clusterSize = std::min(std::uniform_int_distribution<int>(1, maxClusterSize)(randomEngine), numCells - toInt(cells.size()));
+            for (int i = 0; i < clusterSize; ++i) {
+                std::vector<ConnectionDescription> connections;
+                if (i > 0) {
+                    connections.emplace_back(ConnectionDescription().setCellId(id + i - 1).setDistance(1.0f).setAngleFromPrevious(360.0f));
+                }
+                if (i < clusterSize - 1) {
+                    connections.emplace_back(ConnectionDescription().setCellId(id + i + 1).setDistance(1.0f).setAngleFromPrevious(360.0f));
+                }
+                cells.emplace_back(CellDescription().setId(id + i).setPos({toFloat(i), toFloat(id % 1000)}).setConnectingCells(connections));
+            }
+            id += clusterSize;
+        }
+        std::shuffle(cells.begin(), cells.end(), randomEngine);
+        return DataDescription().addCells(cells);
+    }
+
+    ClusteredDataDescription convert(DataDescription const& data) const
+    {
+        DescriptionConverter converter(_parameters);
+        auto dataTO = _dataTOCache.getDataTO(converter.getArraySizes(data));
+        converter.convertDescriptionToTO(dataTO, data);
+        return converter.convertTOtoClusteredDataDescription(dataTO);
+    }
+
+    //cluster ids sorted by the smallest cell id
+    std::vector<std::vector<uint64_t>> getClusterIds(ClusteredDataDescription const& data) const
+    {
+        std::vector<std::vector<uint64_t>> result;
+        for (auto const& cluster : data.clusters) {
+            std::vector<uint64_t> ids;
+            for (auto const& cell : cluster.cells) {
+                ids.emplace_back(cell.id);
+            }
+            std::sort(ids.begin(), ids.end());
+            result.emplace_back(ids);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    //expected clusters for data created by createData
+    std::vector<std::vector<uint64_t>> getClusterIds(DataDescription const& data) const
+    {
+        std::vector<uint64_t> ids;
+        for (auto const& cell : data.cells) {
+            ids.emplace_back(cell.id);
+        }
+        std::sort(ids.begin(), ids.end());
+
+        std::unordered_map<uint64_t, CellDescription const*> cellById;
+        for (auto const& cell : data.cells) {
+            cellById.emplace(cell.id, &cell);
+        }
+        std::vector<std::vector<uint64_t>> result;
+        for (auto const& id : ids) {
+            auto const& cell = *cellById.at(id);
+            if (cell.connections.empty() || cell.connections.front().cellId > id) {
+                result.emplace_back();
+            }
+            result.back().emplace_back(id);
+        }
+        return result;
+    }
+
+    SimulationParameters _parameters;
+    mutable _AccessDataTOCache _dataTOCache;
+};
+
+TEST_F(DescriptionConverterTests, clusterExtraction)
+{
+    auto data = createData(50000, 100);
+
+    auto clusteredData = convert(data);
+    EXPECT_EQ(getClusterIds(data), getClusterIds(clusteredData));
+
+    for (auto const& cluster : clusteredData.clusters) {
+        for (auto const& cell : cluster.cells) {
+            for (auto const& connection : cell.connections) {
+                EXPECT_TRUE(connection.cellId + 1 == cell.id || connection.cellId == cell.id + 1);
+            }
+        }
+    }
+}
+
+TEST_F(DescriptionConverterTests, clusterExtraction_singleCells)
+{
+    auto data = createData(10000, 1);
+
+    auto clusteredData = convert(data);
+    EXPECT_EQ(10000, clusteredData.clusters.size());
+    EXPECT_EQ(getClusterIds(data), getClusterIds(clusteredData));
+}
+
+TEST_F(DescriptionConverterTests, dataRoundTrip)
+{
+    auto genome1 = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+    auto genome2 = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription(), CellGenomeDescription()}));
+    NeuronDescription neuron;
+    neuron.weights[1][2] = 0.5f;
+    neuron.biases[3] = -1.0f;
+
+    auto data = DataDescription().addCells({
+        CellDescription().setId(1).setPos({1.0f, 1.0f}).setCellFunction(ConstructorDescription().setGenome(genome1)),
+        CellDescription().setId(2).setPos({2.0f, 1.0f}).setCellFunction(neuron).setMetadata(CellMetadataDescription().setName("neuron")),
+        CellDescription().setId(3).setPos({3.0f, 1.0f}).setCellFunction(InjectorDescription().setGenome(genome2)),
+        CellDescription().setId(4).setPos({4.0f, 1.0f}).setCellFunction(ConstructorDescription().setGenome(genome1)).setMetadata(CellMetadataDescription().setDescription("text")),
+    });
+    data.addParticle(ParticleDescription().setId(5).setPos({10.0f, 10.0f}).setEnergy(1.0f));
+
+    DescriptionConverter converter(_parameters);
+    auto dataTO = _dataTOCache.getDataTO(converter.getArraySizes(data));
+    converter.convertDescriptionToTO(dataTO, data);
+    EXPECT_EQ(dataTO.cells[0].cellFunctionData.constructor.genomeDataIndex, dataTO.cells[3].cellFunctionData.constructor.genomeDataIndex);
+    EXPECT_EQ(genome1.size() + genome2.size() + sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1) + 6 + 4, *dataTO.numAuxiliaryData);
+
+    auto loadedData = converter.convertTOtoDataDescription(dataTO);
+    EXPECT_TRUE(data == loadedData);
+}
+
+TEST_F(DescriptionConverterTests, snapshotRoundTrip)
+{
+    auto genome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+    auto data = DataDescription().addCells({
+        CellDescription().setId(1).setPos({1.0f, 1.0f}).setMaxConnections(2).setCellFunction(ConstructorDescription().setGenome(genome)),
+        CellDescription()
+            .setId(2)
+            .setPos({2.0f, 1.0f})
+            .setMaxConnections(2)
+            .setCellFunction(NeuronDescription())
+            .setMetadata(CellMetadataDescription().setName("neuron")),
+        CellDescription().setId(3).setPos({3.0f, 1.0f}).setMaxConnections(2).setCellFunction(InjectorDescription().setGenome(genome)),
+    });
+    data.addConnection(1, 2);
+    data.addConnection(2, 3);
+    data.addParticle(ParticleDescription().setId(4).setPos({10.0f, 10.0f}).setEnergy(1.0f));
+
+    DescriptionConverter converter(_parameters);
+    auto arraySizes = converter.getArraySizes(data);
+    auto dataTO = _dataTOCache.getDataTO(arraySizes);
+    converter.convertDescriptionToTO(dataTO, data);
+
+    auto snapshot = converter.convertTOtoSnapshot(dataTO);
+    ASSERT_EQ(3, snapshot.getNumCells());
+    EXPECT_EQ(1, snapshot.getNumParticles());
+    EXPECT_EQ(1, snapshot.getNumConnections(0));
+    EXPECT_EQ(2, snapshot.getNumConnections(1));
+    EXPECT_EQ(1, snapshot.getNumConnections(2));
+    EXPECT_EQ(4, snapshot.connectionOffsets.back());
+    EXPECT_TRUE(std::ranges::equal(genome, snapshot.getGenome(0)));
+    EXPECT_TRUE(std::ranges::equal(genome, snapshot.getGenome(2)));
+    EXPECT_TRUE(snapshot.getGenome(1).empty());
+    EXPECT_EQ("neuron", snapshot.getName(1));
+
+    auto otherDataTO = _dataTOCache.getDataTO(arraySizes);
+    converter.convertSnapshotToTO(otherDataTO, snapshot);
+    auto loadedData = converter.convertTOtoDataDescription(otherDataTO);
+    EXPECT_TRUE(data == loadedData);
+}
+
+TEST_F(DescriptionConverterTests, snapshotWithInvalidConnections)
+{
+    auto data = DataDescription().addCells({
+        CellDescription().setId(1).setPos({1.0f, 1.0f}).setMaxConnections(2),
+        CellDescription().setId(2).setPos({2.0f, 1.0f}).setMaxConnections(2),
+    });
+    data.addConnection(1, 2);
+
+    DescriptionConverter converter(_parameters);
+    auto arraySizes = converter.getArraySizes(data);
+    auto dataTO = _dataTOCache.getDataTO(arraySizes);
+    converter.convertDescriptionToTO(dataTO, data);
+    auto snapshot = converter.convertTOtoSnapshot(dataTO);
+
+    auto tooManyConnections = snapshot;
+    for (int i = 0; i < MAX_CELL_BONDS; ++i) {
+        tooManyConnections.connectionCellIndices.emplace_back(0);
+        tooManyConnections.connectionDistances.emplace_back(1.0f);
+        tooManyConnections.connectionAnglesFromPrevious.emplace_back(0.0f);
+        ++tooManyConnections.connectionOffsets.back();
+    }
+    EXPECT_THROW(converter.convertSnapshotToTO(dataTO, tooManyConnections), std::runtime_error);
+
+    auto invalidCellIndex = snapshot;
+    invalidCellIndex.connectionCellIndices.front() = 2;
+    EXPECT_THROW(converter.convertSnapshotToTO(dataTO, invalidCellIndex), std::runtime_error);
+}
+
+TEST_F(DescriptionConverterTests, snapshotWithInvalidAuxiliaryData)
+{
+    auto genome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+    auto data = DataDescription().addCells({
+        CellDescription()
+            .setId(1)
+            .setPos({1.0f, 1.0f})
+            .setMetadata(CellMetadataDescription().setName("cell"))
+            .setCellFunction(ConstructorDescription().setGenome(genome)),
+    });
+
+    DescriptionConverter converter(_parameters);
+    auto arraySizes = converter.getArraySizes(data);
+    auto dataTO = _dataTOCache.getDataTO(arraySizes);
+    converter.convertDescriptionToTO(dataTO, data);
+    auto snapshot = converter.convertTOtoSnapshot(dataTO);
+    EXPECT_NO_THROW(converter.convertSnapshotToTO(dataTO, snapshot));
+
+    auto invalidOffset = snapshot;
+    invalidOffset.cellNames.front().offset = invalidOffset.auxiliaryData.size();
+    EXPECT_THROW(converter.convertSnapshotToTO(dataTO, invalidOffset), std::runtime_error);
+
+    auto overflowingOffset = snapshot;
+    overflowingOffset.cellGenomes.front().offset = std::numeric_limits<uint64_t>::max();
+    EXPECT_THROW(converter.convertSnapshotToTO(dataTO, overflowingOffset), std::runtime_error);
+
+    //a genome exceeding the 16 bit size of the transfer object would be truncated
+    auto oversizedGenome = snapshot;
+    oversizedGenome.cellGenomes.front().size = std::numeric_limits<uint16_t>::max() + 1;
+    oversizedGenome.auxiliaryData.resize(oversizedGenome.cellGenomes.front().offset + oversizedGenome.cellGenomes.front().size);
+    EXPECT_THROW(converter.convertSnapshotToTO(dataTO, oversizedGenome), std::runtime_error);
+}
+
+//microbenchmark for the conversion of a DataTO to clusters
+//disabled by default, run with --gtest_also_run_disabled_tests
+TEST_F(DescriptionConverterTests, DISABLED_benchmark_clusterExtraction)
+{
+    auto constexpr NumCells = 1000000;
+    auto data = createData(NumCells, 1000);
+
+    DescriptionConverter converter(_parameters);
+    auto dataTO = _dataTOCache.getDataTO(converter.getArraySizes(data));
+    converter.convertDescriptionToTO(dataTO, data);
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto clusteredData = converter.convertTOtoClusteredDataDescription(dataTO);
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::cout << "[ BENCHMARK] " << NumCells << " cells in " << clusteredData.clusters.size() << " clusters converted in " << duration << " ms"
+              << std::endl;
+}
+
+//microbenchmark for the conversion in both directions
+//disabled by default, run with --gtest_also_run_disabled_tests
+TEST_F(DescriptionConverterTests, DISABLED_benchmark_dataConversion)
+{
+    auto constexpr NumCells = 1000000;
+    auto data = createData(NumCells, 100);
+
+    DescriptionConverter converter(_parameters);
+    auto dataTO = _dataTOCache.getDataTO(converter.getArraySizes(data));
+
+    auto startTime = std::chrono::steady_clock::now();
+    converter.convertDescriptionToTO(dataTO, data);
+    auto midTime = std::chrono::steady_clock::now();
+    auto loadedData = converter.convertTOtoDataDescription(dataTO);
+    auto endTime = std::chrono::steady_clock::now();
+    EXPECT_EQ(NumCells, loadedData.cells.size());
+
+    std::cout << "[ BENCHMARK] " << NumCells << " cells converted to DataTO in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(midTime - startTime).count() << " ms and back in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(endTime - midTime).count() << " ms" << std::endl;
+}
+
+//microbenchmark for the snapshot conversion in comparison to the description conversion
+//disabled by default, run with --gtest_also_run_disabled_tests
+TEST_F(DescriptionConverterTests, DISABLED_benchmark_snapshotConversion)
+{
+    auto constexpr NumCells = 1000000;
+    auto data = createData(NumCells, 100);
+
+    DescriptionConverter converter(_parameters);
+    auto dataTO = _dataTOCache.getDataTO(converter.getArraySizes(data));
+    converter.convertDescriptionToTO(dataTO, data);
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto snapshot = converter.convertTOtoSnapshot(dataTO);
+    auto midTime = std::chrono::steady_clock::now();
+    auto loadedData = converter.convertTOtoDataDescription(dataTO);
+    auto endTime = std::chrono::steady_clock::now();
+    EXPECT_EQ(NumCells, snapshot.getNumCells());
+
+    std::cout << "[ BENCHMARK] " << NumCells << " cells converted to snapshot in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(midTime - startTime).count() << " ms and to descriptions in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(endTime - midTime).count() << " ms" << std::endl;
+}
@@ -0,0 +1,194 @@
+#include <chrono>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationController.h"
+
+#include "IntegrationTestFramework.h"
+
+namespace
+{
+    //cpu time of all threads of the process
+    std::chrono::microseconds getProcessCpuTime()
+    {
+#if defined(_WIN32)
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+        auto toMicroseconds = [](FILETIME const& time) {
+            return std::chrono::microseconds(((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10);
+        };
+        return toMicroseconds(kernelTime) + toMicroseconds(userTime);
+#else
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        auto toMicroseconds = [](timeval const& time) { return std::chrono::microseconds(time.tv_sec * 1000000 + time.tv_usec); };
+        return toMicroseconds(usage.ru_utime) + toMicroseconds(usage.ru_stime);
+#endif
+    }
+}
+
+class EngineWorkerTests : public IntegrationTestFramework
+{
+public:
+    EngineWorkerTests()
+        : IntegrationTestFramework()
+    {}
+
+    ~EngineWorkerTests() = default;
+
+protected:
+    //fraction of a core used by the process during the given duration
+    double measureCpuUsage(std::chrono::milliseconds const& duration) const
+    {
+        auto startCpuTime = getProcessCpuTime();
+        auto startTimepoint = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(duration);
+        auto cpuTime = getProcessCpuTime() - startCpuTime;
+        auto wallTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
+        return static_cast<double>(cpuTime.count()) / static_cast<double>(wallTime.count());
+    }
+};
+
+TEST_F(EngineWorkerTests, idleCpuUsage)
+{
+    _simController->setSimulationData(DataDescription().addCell(CellDescription().setId(1)));
+
+    auto cpuUsage = measureCpuUsage(std::chrono::milliseconds(1000));
+    EXPECT_GT(0.05, cpuUsage);
+}
+
+TEST_F(EngineWorkerTests, idleCpuUsageAfterPause)
+{
+    _simController->runSimulation();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    _simController->pauseSimulation();
+
+    auto cpuUsage = measureCpuUsage(std::chrono::milliseconds(1000));
+    EXPECT_GT(0.05, cpuUsage);
+}
+
+TEST_F(EngineWorkerTests, runAndPause)
+{
+    _simController->runSimulation();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    _simController->pauseSimulation();
+
+    auto timestep = _simController->getCurrentTimestep();
+    EXPECT_LT(0, timestep);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(timestep, _simController->getCurrentTimestep());
+}
+
+TEST_F(EngineWorkerTests, accessLatencyWhenIdle)
+{
+    auto maxDuration = std::chrono::microseconds(0);
+    for (int i = 0; i < 100; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        auto startTimepoint = std::chrono::steady_clock::now();
+        _simController->setCurrentTimestep(i);
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
+        maxDuration = std::max(maxDuration, duration);
+    }
+    EXPECT_GT(std::chrono::milliseconds(50), maxDuration);
+}
+
+TEST_F(EngineWorkerTests, changeCellsAsync)
+{
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({10.0f, 10.0f}).setEnergy(100.0f),
+        CellDescription().setId(2).setPos({20.0f, 10.0f}).setEnergy(100.0f),
+        CellDescription().setId(3).setPos({30.0f, 10.0f}).setEnergy(100.0f),
+    });
+    _simController->setSimulationData(data);
+
+    auto cellById = getCellById(_simController->getSimulationData());
+    std::vector<EngineCommand> commands;
+    commands.emplace_back(ChangeCellCommand{cellById.at(1).setEnergy(150.0f)});
+    commands.emplace_back(ChangeCellCommand{cellById.at(2).setEnergy(200.0f)});
+    commands.emplace_back(ChangeCellCommand{cellById.at(1).setEnergy(250.0f)});
+    _simController->executeCommands_async(commands).get();
+
+    auto actualCellById = getCellById(_simController->getSimulationData());
+    EXPECT_TRUE(approxCompare(250.0f, actualCellById.at(1).energy));
+    EXPECT_TRUE(approxCompare(200.0f, actualCellById.at(2).energy));
+    EXPECT_TRUE(approxCompare(100.0f, actualCellById.at(3).energy));
+}
+
+TEST_F(EngineWorkerTests, changeCellIsOrderedWithReads)
+{
+    _simController->setSimulationData(DataDescription().addCell(CellDescription().setId(1).setEnergy(100.0f)));
+
+    auto cell = getCell(_simController->getSimulationData(), 1);
+    _simController->changeCell(cell.setEnergy(200.0f));
+
+    //reading the simulation data waits for the queued change
+    EXPECT_TRUE(approxCompare(200.0f, getCell(_simController->getSimulationData(), 1).energy));
+}
+
+//queued changes and subsequent accesses must not wait for the pause between two time steps
+TEST_F(EngineWorkerTests, accessLatencyWithLowTps)
+{
+    _simController->setSimulationData(DataDescription().addCell(CellDescription().setId(1).setEnergy(100.0f)));
+    auto cell = getCell(_simController->getSimulationData(), 1);
+    _simController->setTpsRestriction(2);
+    _simController->runSimulation();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto maxDuration = std::chrono::microseconds(0);
+    for (int i = 0; i < 10; ++i) {
+        auto startTimepoint = std::chrono::steady_clock::now();
+        _simController->changeCell(cell.setEnergy(100.0f + toFloat(i)));
+        _simController->setCurrentTimestep(i);
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
+        maxDuration = std::max(maxDuration, duration);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    _simController->pauseSimulation();
+    _simController->setTpsRestriction(std::nullopt);
+
+    EXPECT_GT(std::chrono::milliseconds(100), maxDuration);
+}
+
+//transfer buffers must stay valid although closing a simulation resets the device
+TEST_F(EngineWorkerTests, uploadDataAfterReopeningSimulation)
+{
+    auto generalSettings = _simController->getGeneralSettings();
+    for (int i = 0; i < 2; ++i) {
+        _simController->closeSimulation();
+        _simController->newSimulation(0, generalSettings, _parameters);
+
+        DataDescription data;
+        for (int j = 0; j < 100; ++j) {
+            data.addCell(CellDescription().setId(j + 1).setPos({toFloat(j) * 2.0f, 10.0f}).setEnergy(100.0f));
+        }
+        _simController->setSimulationData(data);
+        EXPECT_EQ(100, _simController->getSimulationData().cells.size());
+    }
+}
+
+TEST_F(EngineWorkerTests, performanceCounters)
+{
+    auto countersBefore = _simController->getPerformanceCounters();
+    _simController->setSimulationData(DataDescription().addCell(CellDescription().setId(1)));
+    _simController->calcTimesteps(100);
+    _simController->getSimulationData();
+    auto counters = _simController->getPerformanceCounters();
+
+    EXPECT_LT(countersBefore.timestepDuration, counters.timestepDuration);
+    EXPECT_LT(countersBefore.statisticsDuration, counters.statisticsDuration);
+    EXPECT_LT(countersBefore.dataTransferDuration, counters.dataTransferDuration);
+
+    //the arrays are allocated when the simulation is created
+    ASSERT_FALSE(counters.resizeEvents.empty());
+    EXPECT_LT(0, counters.resizeEvents.front().arraySizes.cellArraySize);
+}
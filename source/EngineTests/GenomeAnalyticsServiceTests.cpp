@@ -0,0 +1,187 @@
+#include <filesystem>
+#include <fstream>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeAnalyticsService.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+
+class GenomeAnalyticsServiceTests : public ::testing::Test
+{
+protected:
+    std::vector<uint8_t> createGenome(std::vector<CellGenomeDescription> const& cells) const
+    {
+        return GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells(cells));
+    }
+
+    //genome whose nodes vary in cell function and color such that its shingles are mostly distinct
+    std::vector<CellGenomeDescription> createVariedCells(int numCells) const
+    {
+        std::vector<CellGenomeDescription> result;
+        for (int i = 0; i < numCells; ++i) {
+            auto cell = CellGenomeDescription().setColor(i % 3);
+            switch (i % 4) {
+            case 0:
+                cell.setCellFunction(NeuronGenomeDescription());
+                break;
+            case 1:
+                cell.setCellFunction(TransmitterGenomeDescription());
+                break;
+            case 2:
+                cell.setCellFunction(MuscleGenomeDescription());
+                break;
+            default:
+                break;
+            }
+            result.emplace_back(cell);
+        }
+        return result;
+    }
+
+    CellDescription createConstructorCell(std::vector<uint8_t> const& genome, int mutationId = 0) const
+    {
+        return CellDescription().setCellFunction(ConstructorDescription().setGenome(genome)).setMutationId(mutationId);
+    }
+
+    CellDescription createInjectorCell(std::vector<uint8_t> const& genome, int mutationId = 0) const
+    {
+        return CellDescription().setCellFunction(InjectorDescription().setGenome(genome)).setMutationId(mutationId);
+    }
+};
+
+TEST_F(GenomeAnalyticsServiceTests, deduplication)
+{
+    auto genome1 = createGenome({CellGenomeDescription(), CellGenomeDescription()});
+    auto genome2 = createGenome({CellGenomeDescription().setCellFunction(NeuronGenomeDescription())});
+
+    auto data = ClusteredDataDescription().addClusters({
+        ClusterDescription().addCells({createConstructorCell(genome1), createInjectorCell(genome1), CellDescription()}),
+        ClusterDescription().addCells({createConstructorCell(genome2), createConstructorCell(genome1), createConstructorCell({})}),
+    });
+    auto result = GenomeAnalyticsService::analyze(data);
+
+    EXPECT_EQ(4, result.numOccurrences);
+    ASSERT_EQ(2, result.genomes.size());
+    EXPECT_EQ(genome1, result.genomes.at(0).genome);
+    EXPECT_EQ(3, result.genomes.at(0).numOccurrences);
+    EXPECT_EQ(genome2, result.genomes.at(1).genome);
+    EXPECT_EQ(1, result.genomes.at(1).numOccurrences);
+}
+
+TEST_F(GenomeAnalyticsServiceTests, nodeCountsAndComposition)
+{
+    auto subGenome = createGenome({CellGenomeDescription(), CellGenomeDescription().setCellFunction(InjectorGenomeDescription().setMakeSelfCopy())});
+    auto genome = createGenome({
+        CellGenomeDescription().setCellFunction(NeuronGenomeDescription()),
+        CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(subGenome)),
+        CellGenomeDescription().setCellFunction(NeuronGenomeDescription()),
+    });
+
+    auto result = GenomeAnalyticsService::analyze(ClusteredDataDescription().addClusters({ClusterDescription().addCells({createConstructorCell(genome)})}));
+
+    ASSERT_EQ(1, result.genomes.size());
+    auto const& distinctGenome = result.genomes.front();
+    EXPECT_EQ(3, distinctGenome.numNodes);
+    EXPECT_EQ(5, distinctGenome.numNodesRecursively);
+    EXPECT_EQ(1, distinctGenome.numSubGenomes);
+    EXPECT_EQ(2, distinctGenome.composition[CellFunction_Neuron]);
+    EXPECT_EQ(1, distinctGenome.composition[CellFunction_Constructor]);
+    EXPECT_EQ(1, distinctGenome.composition[CellFunction_Injector]);
+    EXPECT_EQ(1, distinctGenome.composition[CellFunction_None]);
+
+    ASSERT_EQ(1, result.compositions.size());
+    EXPECT_EQ(distinctGenome.composition, result.compositions.front().composition);
+}
+
+TEST_F(GenomeAnalyticsServiceTests, nearDuplicatesAreClustered)
+{
+    auto cells = createVariedCells(40);
+    auto genome = createGenome(cells);
+
+    auto variantCells = cells;
+    variantCells.at(20).setCellFunction(DetonatorGenomeDescription());
+    auto variant = createGenome(variantCells);
+
+    std::vector<CellGenomeDescription> otherCells(40, CellGenomeDescription().setCellFunction(SensorGenomeDescription()).setColor(5));
+    auto other = createGenome(otherCells);
+
+    auto data = ClusteredDataDescription().addClusters({ClusterDescription().addCells({
+        createConstructorCell(genome),
+        createConstructorCell(genome),
+        createConstructorCell(variant),
+        createConstructorCell(other),
+    })});
+    auto result = GenomeAnalyticsService::analyze(data);
+
+    ASSERT_EQ(3, result.genomes.size());
+    ASSERT_EQ(2, result.clusters.size());
+    EXPECT_EQ(result.genomes.at(0).clusterIndex, result.genomes.at(1).clusterIndex);
+    EXPECT_NE(result.genomes.at(0).clusterIndex, result.genomes.at(2).clusterIndex);
+
+    auto const& largestCluster = result.clusters.front();
+    EXPECT_EQ(0, largestCluster.representativeGenomeIndex);
+    EXPECT_EQ(2, largestCluster.numDistinctGenomes);
+    EXPECT_EQ(3, largestCluster.numOccurrences);
+}
+
+TEST_F(GenomeAnalyticsServiceTests, sizeStatisticsPerMutationId)
+{
+    auto smallGenome = createGenome({CellGenomeDescription()});
+    auto largeGenome = createGenome({CellGenomeDescription(), CellGenomeDescription(), CellGenomeDescription(), CellGenomeDescription()});
+
+    auto cell = createConstructorCell(largeGenome, 2);
+    cell.ancestorMutationId = 7;
+    auto data = ClusteredDataDescription().addClusters({ClusterDescription().addCells({
+        createConstructorCell(smallGenome, 1),
+        createConstructorCell(smallGenome, 2),
+        createConstructorCell(smallGenome, 2),
+        cell,
+    })});
+    auto result = GenomeAnalyticsService::analyze(data);
+
+    ASSERT_EQ(2, result.sizesByMutationId.size());
+    auto const& statistics = result.sizesByMutationId.at(2);
+    EXPECT_EQ(3, statistics.numOccurrences);
+    EXPECT_EQ(2, statistics.numDistinctGenomes);
+    EXPECT_EQ(1, statistics.minNumNodes);
+    EXPECT_EQ(4, statistics.maxNumNodes);
+    EXPECT_DOUBLE_EQ(2.0, statistics.meanNumNodes);
+    EXPECT_DOUBLE_EQ(1.0, statistics.medianNumNodes);
+
+    ASSERT_EQ(2, result.sizesByAncestorMutationId.size());
+    EXPECT_EQ(3, result.sizesByAncestorMutationId.at(0).numOccurrences);
+    EXPECT_EQ(1, result.sizesByAncestorMutationId.at(7).numOccurrences);
+    EXPECT_EQ(4, result.sizesByAncestorMutationId.at(7).minNumNodes);
+}
+
+TEST_F(GenomeAnalyticsServiceTests, saveToJsonAndCsv)
+{
+    auto genome = createGenome(createVariedCells(10));
+    auto result = GenomeAnalyticsService::analyze(ClusteredDataDescription().addClusters({ClusterDescription().addCells({createInjectorCell(genome)})}));
+
+    auto directory = std::filesystem::temp_directory_path();
+    auto jsonFilename = (directory / "genome analytics test.json").string();
+    auto csvFilename = (directory / "genome analytics test.csv").string();
+    ASSERT_TRUE(GenomeAnalyticsService::saveToJson(jsonFilename, result));
+    ASSERT_TRUE(GenomeAnalyticsService::saveGenomesToCsv(csvFilename, result));
+
+    boost::property_tree::ptree tree;
+    boost::property_tree::json_parser::read_json(jsonFilename, tree);
+    EXPECT_EQ(1, tree.get<int>("summary.genomes"));
+    EXPECT_EQ(1, tree.get<int>("summary.distinct genomes"));
+    EXPECT_EQ(1, tree.get_child("clusters").size());
+
+    std::ifstream stream(csvFilename);
+    std::string line;
+    int numLines = 0;
+    while (std::getline(stream, line)) {
+        ++numLines;
+    }
+    EXPECT_EQ(2, numLines);
+
+    std::filesystem::remove(jsonFilename);
+    std::filesystem::remove(csvFilename);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineInterface/GenomeNavigator.h"
+
+class GenomeNavigatorTests : public ::testing::Test
+{
+protected:
+    std::vector<uint8_t> createSubGenome() const
+    {
+        return GenomeDescriptionService::convertDescriptionToBytes(
+            GenomeDescription()
+                .setHeader(GenomeHeaderDescription().setNumRepetitions(3).setNumBranches(2).setSeparateConstruction(false))
+                .setCells({CellGenomeDescription(), CellGenomeDescription().setCellFunction(InjectorGenomeDescription().setMakeSelfCopy())}));
+    }
+
+    GenomeDescription createGenome() const
+    {
+        return GenomeDescription().setHeader(GenomeHeaderDescription().setNumRepetitions(2)).setCells({
+            CellGenomeDescription().setCellFunction(NeuronGenomeDescription()),
+            CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(createSubGenome())),
+            CellGenomeDescription().setCellFunction(TransmitterGenomeDescription()),
+            CellGenomeDescription(),
+        });
+    }
+
+    //node addresses as given by the encoding of the preceding nodes
+    std::vector<int> calcExpectedNodeAddresses(GenomeDescription const& genome) const
+    {
+        std::vector<int> result;
+        for (size_t i = 0; i < genome.cells.size(); ++i) {
+            auto prefix = genome;
+            prefix.cells.resize(i);
+            result.emplace_back(toInt(GenomeDescriptionService::convertDescriptionToBytes(prefix).size()));
+        }
+        return result;
+    }
+};
+
+TEST_F(GenomeNavigatorTests, nodeAddresses)
+{
+    auto genome = createGenome();
+    auto data = GenomeDescriptionService::convertDescriptionToBytes(genome);
+    GenomeNavigator navigator(data);
+
+    auto expectedNodeAddresses = calcExpectedNodeAddresses(genome);
+    ASSERT_EQ(4, navigator.getNumNodes());
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(expectedNodeAddresses.at(i), navigator.getNodeAddress(i));
+        EXPECT_EQ(i, navigator.getNodeIndex(expectedNodeAddresses.at(i)));
+
+        //addresses inside a node refer to the following node
+        EXPECT_EQ(i + 1, navigator.getNodeIndex(expectedNodeAddresses.at(i) + 1));
+    }
+    EXPECT_EQ(toInt(data.size()), navigator.getNodeAddress(4));
+    EXPECT_EQ(4, navigator.getNodeIndex(toInt(data.size())));
+}
+
+TEST_F(GenomeNavigatorTests, subGenomes)
+{
+    auto data = GenomeDescriptionService::convertDescriptionToBytes(createGenome());
+    GenomeNavigator navigator(data);
+
+    ASSERT_EQ(2, navigator.getNumGenomes());
+    EXPECT_FALSE(navigator.getSubGenomeIndex(0).has_value());
+    ASSERT_EQ(1, navigator.getSubGenomeIndex(1));
+    EXPECT_FALSE(navigator.getSubGenomeIndex(2).has_value());
+
+    //addresses of sub-genome nodes are relative to the sub-genome
+    auto subGenome = createSubGenome();
+    GenomeNavigator subGenomeNavigator(subGenome);
+    EXPECT_EQ(2, navigator.getNumNodes(1));
+    EXPECT_EQ(subGenomeNavigator.getNodeAddress(1), navigator.getNodeAddress(1, 1));
+    EXPECT_EQ(toInt(subGenome.size()), navigator.getNodeAddress(2, 1));
+    EXPECT_EQ(3, navigator.getNumRepetitions(1));
+    EXPECT_EQ(2, navigator.getNumBranches(1));
+}
+
+TEST_F(GenomeNavigatorTests, numNodesRecursively)
+{
+    auto data = GenomeDescriptionService::convertDescriptionToBytes(createGenome());
+    GenomeNavigator navigator(data);
+
+    EXPECT_EQ(4 + 2, navigator.getNumNodesRecursively(false));
+    EXPECT_EQ((4 + 2 * 3 * 2) * 2, navigator.getNumNodesRecursively(true));
+    EXPECT_EQ(2 * 3 * 2, navigator.getNumNodesRecursively(true, 1));
+}
+
+TEST_F(GenomeNavigatorTests, infiniteRepetitions)
+{
+    auto data = GenomeDescriptionService::convertDescriptionToBytes(
+        GenomeDescription()
+            .setHeader(GenomeHeaderDescription().setNumRepetitions(std::numeric_limits<int>::max()))
+            .setCells({CellGenomeDescription(), CellGenomeDescription()}));
+    GenomeNavigator navigator(data);
+
+    EXPECT_EQ(std::numeric_limits<int>::max(), navigator.getNumRepetitions());
+    EXPECT_EQ(2, navigator.getNumNodesRecursively(true));
+}
+
+TEST_F(GenomeNavigatorTests, truncatedGenome)
+{
+    auto data = GenomeDescriptionService::convertDescriptionToBytes(createGenome());
+    for (size_t size = 0; size <= data.size(); ++size) {
+        std::vector<uint8_t> truncatedData(data.begin(), data.begin() + size);
+        GenomeNavigator navigator(truncatedData);
+
+        auto decodedGenome = GenomeDescriptionService::convertBytesToDescription(truncatedData);
+        ASSERT_EQ(toInt(decodedGenome.cells.size()), navigator.getNumNodes());
+        EXPECT_EQ(toInt(size), navigator.getNodeAddress(navigator.getNumNodes()));
+    }
+}
+
+TEST_F(GenomeNavigatorTests, encodingSpecification)
+{
+    auto spec = GenomeEncodingSpecification().numRepetitions(false).concatenationAngle1(false).concatenationAngle2(false);
+    auto genome = createGenome();
+    auto data = GenomeDescriptionService::convertDescriptionToBytes(genome, spec);
+    GenomeNavigator navigator(data, spec);
+
+    ASSERT_EQ(4, navigator.getNumNodes());
+    EXPECT_EQ(1, navigator.getNumRepetitions());
+    auto expectedNodeAddress = toInt(GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setHeader(genome.header), spec).size());
+    EXPECT_EQ(expectedNodeAddress, navigator.getNodeAddress(0));
+}
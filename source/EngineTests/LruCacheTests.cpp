@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include "Base/LruCache.h"
+
+class LruCacheTests : public ::testing::Test
+{
+protected:
+    LruCache<int, std::string, 3> _cache;
+};
+
+TEST_F(LruCacheTests, insertAndFind)
+{
+    _cache.insertOrAssign(1, "a");
+    _cache.insertOrAssign(2, "b");
+    EXPECT_EQ("a", _cache.find(1));
+    EXPECT_EQ("b", _cache.find(2));
+    EXPECT_FALSE(_cache.find(3).has_value());
+
+    _cache.insertOrAssign(1, "c");
+    EXPECT_EQ("c", _cache.find(1));
+    EXPECT_EQ(2, _cache.getNumEntries());
+}
+
+TEST_F(LruCacheTests, evictLeastRecentlyInserted)
+{
+    for (int i = 0; i < 5; ++i) {
+        _cache.insertOrAssign(i, std::to_string(i));
+    }
+    EXPECT_EQ(3, _cache.getNumEntries());
+    EXPECT_FALSE(_cache.find(0).has_value());
+    EXPECT_FALSE(_cache.find(1).has_value());
+    EXPECT_EQ("2", _cache.find(2));
+    EXPECT_EQ("4", _cache.find(4));
+}
+
+TEST_F(LruCacheTests, findRefreshesEntry)
+{
+    _cache.insertOrAssign(1, "a");
+    _cache.insertOrAssign(2, "b");
+    _cache.insertOrAssign(3, "c");
+
+    //entry 1 is used again such that entry 2 is the least recently used one
+    EXPECT_TRUE(_cache.find(1).has_value());
+    _cache.insertOrAssign(4, "d");
+    EXPECT_TRUE(_cache.find(1).has_value());
+    EXPECT_FALSE(_cache.find(2).has_value());
+    EXPECT_TRUE(_cache.find(3).has_value());
+    EXPECT_TRUE(_cache.find(4).has_value());
+}
+
+TEST_F(LruCacheTests, assignRefreshesEntry)
+{
+    _cache.insertOrAssign(1, "a");
+    _cache.insertOrAssign(2, "b");
+    _cache.insertOrAssign(3, "c");
+
+    _cache.insertOrAssign(1, "d");
+    _cache.insertOrAssign(4, "e");
+    EXPECT_EQ("d", _cache.find(1));
+    EXPECT_FALSE(_cache.find(2).has_value());
+    EXPECT_EQ(3, _cache.getNumEntries());
+}
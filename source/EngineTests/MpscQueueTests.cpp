@@ -0,0 +1,59 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Base/MpscQueue.h"
+
+class MpscQueueTests : public ::testing::Test
+{
+protected:
+    MpscQueue<int> _queue;
+};
+
+TEST_F(MpscQueueTests, pushOrder)
+{
+    EXPECT_TRUE(_queue.isEmpty());
+    for (int i = 0; i < 10; ++i) {
+        _queue.push(i);
+    }
+    EXPECT_FALSE(_queue.isEmpty());
+
+    auto values = _queue.popAll();
+    ASSERT_EQ(10, values.size());
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(i, values.at(i));
+    }
+    EXPECT_TRUE(_queue.isEmpty());
+    EXPECT_TRUE(_queue.popAll().empty());
+}
+
+TEST_F(MpscQueueTests, multipleProducers)
+{
+    auto constexpr NumProducers = 4;
+    auto constexpr NumValuesPerProducer = 100000;
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < NumProducers; ++producer) {
+        producers.emplace_back([&, producer] {
+            for (int i = 0; i < NumValuesPerProducer; ++i) {
+                _queue.push(producer * NumValuesPerProducer + i);
+            }
+        });
+    }
+
+    //the values of each producer have to arrive in push order
+    std::vector<int> nextValues(NumProducers, 0);
+    int numValues = 0;
+    while (numValues < NumProducers * NumValuesPerProducer) {
+        for (auto value : _queue.popAll()) {
+            auto producer = value / NumValuesPerProducer;
+            EXPECT_EQ(nextValues[producer], value % NumValuesPerProducer);
+            ++nextValues[producer];
+            ++numValues;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(_queue.isEmpty());
+}
@@ -0,0 +1,99 @@
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/PatternAnalysisService.h"
+
+class PatternAnalysisServiceTests : public ::testing::Test
+{
+protected:
+    //cells are connected along the given pairs of cell ids
+    ClusterDescription createCluster(std::vector<CellDescription> cells, std::vector<std::pair<uint64_t, uint64_t>> const& connections) const
+    {
+        for (auto& cell : cells) {
+            for (auto const& [id1, id2] : connections) {
+                if (cell.id == id1) {
+                    cell.connections.emplace_back(ConnectionDescription().setCellId(id2));
+                }
+                if (cell.id == id2) {
+                    cell.connections.emplace_back(ConnectionDescription().setCellId(id1));
+                }
+            }
+        }
+        return ClusterDescription().addCells(cells);
+    }
+
+    std::vector<CellDescription> createCells(std::vector<uint64_t> const& ids) const
+    {
+        std::vector<CellDescription> result;
+        for (auto id : ids) {
+            result.emplace_back(CellDescription().setId(id));
+        }
+        return result;
+    }
+
+    //neuron - transmitter - neuron - constructor
+    ClusterDescription createChain(uint64_t firstId) const
+    {
+        return createCluster(
+            {
+                CellDescription().setId(firstId).setCellFunction(NeuronDescription()),
+                CellDescription().setId(firstId + 1).setCellFunction(TransmitterDescription()),
+                CellDescription().setId(firstId + 2).setCellFunction(NeuronDescription()),
+                CellDescription().setId(firstId + 3).setCellFunction(ConstructorDescription()),
+            },
+            {{firstId, firstId + 1}, {firstId + 1, firstId + 2}, {firstId + 2, firstId + 3}});
+    }
+};
+
+TEST_F(PatternAnalysisServiceTests, canonicalHashIsInvariantUnderReordering)
+{
+    auto cluster = createChain(1);
+    auto reorderedCluster = createChain(100);
+    std::ranges::reverse(reorderedCluster.cells);
+
+    EXPECT_EQ(PatternAnalysisService::calcCanonicalHash(cluster), PatternAnalysisService::calcCanonicalHash(reorderedCluster));
+    EXPECT_TRUE(PatternAnalysisService::isIsomorphic(cluster, reorderedCluster));
+}
+
+TEST_F(PatternAnalysisServiceTests, cellAttributesAreCompared)
+{
+    auto cluster = createChain(1);
+    auto otherCluster = createChain(1);
+    otherCluster.cells.at(1).setColor(3);
+
+    EXPECT_NE(PatternAnalysisService::calcCanonicalHash(cluster), PatternAnalysisService::calcCanonicalHash(otherCluster));
+    EXPECT_FALSE(PatternAnalysisService::isIsomorphic(cluster, otherCluster));
+}
+
+//a ring of 6 cells and two rings of 3 cells cannot be distinguished by the refinement
+TEST_F(PatternAnalysisServiceTests, verificationSeparatesRefinementEquivalentClusters)
+{
+    auto ring = createCluster(createCells({1, 2, 3, 4, 5, 6}), {{1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 6}, {6, 1}});
+    auto twoTriangles = createCluster(createCells({1, 2, 3, 4, 5, 6}), {{1, 2}, {2, 3}, {3, 1}, {4, 5}, {5, 6}, {6, 4}});
+
+    EXPECT_EQ(PatternAnalysisService::calcCanonicalHash(ring), PatternAnalysisService::calcCanonicalHash(twoTriangles));
+    EXPECT_FALSE(PatternAnalysisService::isIsomorphic(ring, twoTriangles));
+
+    auto shiftedRing = createCluster(createCells({11, 12, 13, 14, 15, 16}), {{13, 14}, {14, 15}, {15, 16}, {16, 11}, {11, 12}, {12, 13}});
+    EXPECT_TRUE(PatternAnalysisService::isIsomorphic(ring, shiftedRing));
+}
+
+TEST_F(PatternAnalysisServiceTests, patternClasses)
+{
+    auto ring = createCluster(createCells({1, 2, 3, 4, 5, 6}), {{1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 6}, {6, 1}});
+    auto twoTriangles = createCluster(createCells({11, 12, 13, 14, 15, 16}), {{11, 12}, {12, 13}, {13, 11}, {14, 15}, {15, 16}, {16, 14}});
+    auto anotherRing = createCluster(createCells({21, 22, 23, 24, 25, 26}), {{21, 23}, {23, 25}, {25, 22}, {22, 24}, {24, 26}, {26, 21}});
+
+    auto data = ClusteredDataDescription().addClusters({createChain(100), ring, createChain(200), twoTriangles, createChain(300), anotherRing});
+    auto patternClasses = PatternAnalysisService::calcPatternClasses(data);
+
+    ASSERT_EQ(3, patternClasses.size());
+    EXPECT_EQ(3, patternClasses.at(0).numberOfElements);
+    EXPECT_EQ(100, patternClasses.at(0).representant.cells.front().id);
+    EXPECT_EQ(2, patternClasses.at(1).numberOfElements);
+    EXPECT_EQ(1, patternClasses.at(1).representant.cells.front().id);
+    EXPECT_EQ(1, patternClasses.at(2).numberOfElements);
+    EXPECT_EQ(11, patternClasses.at(2).representant.cells.front().id);
+}
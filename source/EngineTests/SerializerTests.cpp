@@ -0,0 +1,419 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/optional.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/unordered_map.hpp>
+#include <cereal/types/variant.hpp>
+#include <cereal/types/vector.hpp>
+
+#include "Base/Resources.h"
+#include "EngineInterface/CheckpointService.h"
+#include "EngineInterface/ChunkedSerializerService.h"
+#include "EngineInterface/ColumnarSerializerService.h"
+#include "EngineInterface/DeltaSnapshotService.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineInterface/SerializerService.h"
+#include "EngineInterface/StatisticsSerializerService.h"
+
+class SerializerTests : public ::testing::Test
+{
+protected:
+    ClusteredDataDescription createData() const
+    {
+        auto genome = GenomeDescriptionService::convertDescriptionToBytes(
+            GenomeDescription().setCells({CellGenomeDescription(), CellGenomeDescription().setCellFunction(NeuronGenomeDescription())}));
+
+        ClusteredDataDescription result;
+        result.addCluster(ClusterDescription().addCells({
+            CellDescription()
+                .setId(1)
+                .setPos({10.0f, 20.0f})
+                .setVel({0.5f, -0.5f})
+                .setEnergy(150.0f)
+                .setInputExecutionOrderNumber(3)
+                .setMetadata(CellMetadataDescription().setName("name").setDescription("description"))
+                .setConnectingCells({ConnectionDescription().setCellId(2).setDistance(1.0f).setAngleFromPrevious(360.0f)})
+                .setCellFunction(ConstructorDescription().setGenome(genome)),
+            CellDescription()
+                .setId(2)
+                .setPos({11.0f, 20.0f})
+                .setConnectingCells({ConnectionDescription().setCellId(1).setDistance(1.0f).setAngleFromPrevious(360.0f)})
+                .setCellFunction(SensorDescription().setFixedAngle(45.0f).setMinRange(10)),
+        }));
+        result.addCluster(ClusterDescription().addCell(CellDescription().setId(3).setPos({50.0f, 50.0f}).setCellFunction(NeuronDescription())));
+        result.addCluster(ClusterDescription().addCell(CellDescription().setId(4).setPos({60.0f, 50.0f}).setCellFunction(InjectorDescription().setGenome(genome))));
+        result.addParticle(ParticleDescription().setId(6).setPos({70.0f, 70.0f}).setEnergy(10.0f).setColor(2));
+        return result;
+    }
+};
+
+TEST_F(SerializerTests, simulationRoundTrip)
+{
+    DeserializedSimulation input;
+    input.mainData = createData();
+
+    SerializedSimulation serialized;
+    ASSERT_TRUE(SerializerService::serializeSimulationToStrings(serialized, input));
+
+    DeserializedSimulation output;
+    ASSERT_TRUE(SerializerService::deserializeSimulationFromStrings(output, serialized));
+    EXPECT_TRUE(input.mainData == output.mainData);
+}
+
+TEST_F(SerializerTests, simulationRoundTrip_deflate)
+{
+    DeserializedSimulation input;
+    input.mainData = createData();
+
+    SerializedSimulation serialized;
+    ASSERT_TRUE(SerializerService::serializeSimulationToStrings(serialized, input, CompressionSettings{.codec = CompressionCodec_Deflate, .level = 6}));
+
+    DeserializedSimulation output;
+    ASSERT_TRUE(SerializerService::deserializeSimulationFromStrings(output, serialized));
+    EXPECT_TRUE(input.mainData == output.mainData);
+}
+
+//the objects are spread over several tiles of the chunked format
+TEST_F(SerializerTests, simulationRoundTrip_manyRegions)
+{
+    DeserializedSimulation input;
+    for (int i = 0; i < 500; ++i) {
+        auto pos = RealVector2D{toFloat((i * 37) % 1000), toFloat((i * 91) % 800)};
+        input.mainData.addCluster(ClusterDescription().addCell(CellDescription().setId(i + 1).setPos(pos).setEnergy(toFloat(i))));
+        input.mainData.addParticle(ParticleDescription().setId(i + 1001).setPos(pos + RealVector2D{0.5f, 0.5f}));
+    }
+
+    SerializedSimulation serialized;
+    ASSERT_TRUE(SerializerService::serializeSimulationToStrings(serialized, input));
+
+    DeserializedSimulation output;
+    ASSERT_TRUE(SerializerService::deserializeSimulationFromStrings(output, serialized));
+    EXPECT_TRUE(input.mainData == output.mainData);
+}
+
+TEST_F(SerializerTests, chunkedRegion)
+{
+    //one cluster and one particle every 32 units in a world of 4x4 tiles
+    ClusteredDataDescription data;
+    uint64_t id = 1;
+    for (int x = 0; x < 32; ++x) {
+        for (int y = 0; y < 32; ++y) {
+            auto pos = RealVector2D{toFloat(x * 32 + 1), toFloat(y * 32 + 1)};
+            data.addCluster(ClusterDescription().addCell(CellDescription().setId(id++).setPos(pos)));
+            data.addParticle(ParticleDescription().setId(id++).setPos(pos));
+        }
+    }
+    std::stringstream stream;
+    ChunkedSerializerService::serialize(data, stream);
+
+    ClusteredDataDescription region;
+    auto numDecodedBlocks = ChunkedSerializerService::deserializeRegion(region, stream, RealRect{{300.0f, 300.0f}, {400.0f, 400.0f}});
+    EXPECT_EQ(1, numDecodedBlocks);
+    EXPECT_EQ(9, region.clusters.size());
+    EXPECT_EQ(9, region.particles.size());
+    for (auto const& cluster : region.clusters) {
+        auto pos = cluster.cells.front().pos;
+        EXPECT_TRUE(pos.x >= 300.0f && pos.x < 400.0f && pos.y >= 300.0f && pos.y < 400.0f);
+    }
+}
+
+TEST_F(SerializerTests, chunkedSummary)
+{
+    auto data = createData();
+    std::stringstream stream;
+    ChunkedSerializerService::serialize(data, stream);
+    auto summary = ChunkedSerializerService::readSummary(stream);
+
+    uint64_t auxiliaryDataSize = 0;
+    for (auto const& cluster : data.clusters) {
+        for (auto const& cell : cluster.cells) {
+            auxiliaryDataSize += cell.getAuxiliaryDataSize();
+        }
+    }
+    EXPECT_EQ(3, summary.numClusters);
+    EXPECT_EQ(4, summary.numCells);
+    EXPECT_EQ(1, summary.numParticles);
+    EXPECT_LT(0, summary.auxiliaryDataSize);
+    EXPECT_EQ(auxiliaryDataSize, summary.auxiliaryDataSize);
+}
+
+TEST_F(SerializerTests, contentFileRoundTrip)
+{
+    auto filename = (std::filesystem::temp_directory_path() / "alien_serializer_test.sim").string();
+    auto data = createData();
+    ASSERT_TRUE(SerializerService::serializeContentToFile(filename, data));
+
+    ClusteredDataDescription loadedData;
+    ASSERT_TRUE(SerializerService::deserializeContentFromFile(loadedData, filename));
+    std::filesystem::remove(filename);
+    EXPECT_TRUE(data == loadedData);
+}
+
+//content files of previous versions are cereal archives, the file is written in the same way as by the former serializer
+TEST_F(SerializerTests, legacyContentFile)
+{
+    using VariantData = std::variant<int, float, uint64_t, bool, std::optional<float>, std::optional<int>, std::vector<int>, uint32_t, uint8_t>;
+    auto constexpr Id_Particle_Color = 0;
+
+    auto filename = (std::filesystem::temp_directory_path() / "alien_serializer_test_legacy.sim").string();
+    {
+        std::ofstream stream(filename, std::ios::binary);
+        cereal::PortableBinaryOutputArchive archive(stream);
+        archive(Const::ProgramVersion);
+        archive(cereal::make_size_tag(static_cast<cereal::size_type>(0)));  //clusters
+        archive(cereal::make_size_tag(static_cast<cereal::size_type>(2)));  //particles
+        for (int i = 0; i < 2; ++i) {
+            archive(std::unordered_map<int, VariantData>{{Id_Particle_Color, VariantData(i + 1)}});
+            archive(static_cast<uint64_t>(i + 1), toFloat(i), 5.0f, 0.5f, -0.5f, 10.0f);
+        }
+    }
+
+    ClusteredDataDescription loadedData;
+    ASSERT_TRUE(SerializerService::deserializeContentFromFile(loadedData, filename));
+    std::filesystem::remove(filename);
+
+    auto expectedData = ClusteredDataDescription().addParticles({
+        ParticleDescription().setId(1).setPos({0.0f, 5.0f}).setVel({0.5f, -0.5f}).setEnergy(10.0f).setColor(1),
+        ParticleDescription().setId(2).setPos({1.0f, 5.0f}).setVel({0.5f, -0.5f}).setEnergy(10.0f).setColor(2),
+    });
+    EXPECT_TRUE(expectedData == loadedData);
+}
+
+TEST_F(SerializerTests, regionFromFile)
+{
+    auto filename = (std::filesystem::temp_directory_path() / "alien_serializer_test_region.sim").string();
+    DeserializedSimulation input;
+    input.mainData = createData();
+    ASSERT_TRUE(SerializerService::serializeSimulationToFiles(filename, input));
+
+    ClusteredDataDescription region;
+    ASSERT_TRUE(SerializerService::deserializeRegionFromFile(region, filename, RealRect{{40.0f, 40.0f}, {65.0f, 60.0f}}));
+    std::filesystem::remove(filename);
+    std::filesystem::remove(std::filesystem::path(filename).replace_extension(".settings.json"));
+    std::filesystem::remove(std::filesystem::path(filename).replace_extension(".statistics.bin"));
+
+    ASSERT_EQ(2, region.clusters.size());
+    EXPECT_EQ(3, region.clusters.at(0).cells.front().id);
+    EXPECT_EQ(4, region.clusters.at(1).cells.front().id);
+    EXPECT_TRUE(region.particles.empty());
+}
+
+TEST_F(SerializerTests, genomeDeduplication)
+{
+    auto genome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells(std::vector<CellGenomeDescription>(100)));
+    auto otherGenome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells(std::vector<CellGenomeDescription>(50)));
+
+    auto createConstructors = [](std::vector<uint8_t> const& genome1, std::vector<uint8_t> const& genome2) {
+        ClusteredDataDescription result;
+        for (int i = 0; i < 100; ++i) {
+            auto const& genome = i % 2 == 0 ? genome1 : genome2;
+            result.addCluster(ClusterDescription().addCell(
+                CellDescription().setId(i + 1).setPos({toFloat(i), 0.0f}).setCellFunction(ConstructorDescription().setGenome(genome))));
+        }
+        return result;
+    };
+    auto sharedGenomes = createConstructors(genome, otherGenome);
+    auto distinctGenomes = sharedGenomes;
+    for (auto& cluster : distinctGenomes.clusters) {
+        auto& cellGenome = std::get<ConstructorDescription>(*cluster.cells.front().cellFunction).genome;
+        cellGenome.back() = static_cast<uint8_t>(cluster.cells.front().id);
+    }
+
+    std::stringstream sharedStream;
+    ColumnarSerializerService::serialize(sharedGenomes, sharedStream);
+    std::stringstream distinctStream;
+    ColumnarSerializerService::serialize(distinctGenomes, distinctStream);
+    EXPECT_LT(sharedStream.str().size() * 2, distinctStream.str().size());
+
+    ClusteredDataDescription loadedData;
+    ColumnarSerializerService::deserialize(loadedData, sharedStream);
+    EXPECT_TRUE(sharedGenomes == loadedData);
+}
+
+TEST_F(SerializerTests, corruptColumnarSizes)
+{
+    std::stringstream stream;
+    ColumnarSerializerService::serialize(createData(), stream);
+    auto serializedData = stream.str();
+
+    //header: magic, format version, program version, numbers of clusters, cells and particles
+    auto schemaPos = 8 + sizeof(uint32_t) + sizeof(uint32_t) + Const::ProgramVersion.size() + 3 * sizeof(uint64_t);
+    auto firstColumnSizePos = schemaPos + sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint8_t);
+    auto corrupt = [&](size_t pos, auto value) {
+        auto result = serializedData;
+        std::memcpy(result.data() + pos, &value, sizeof(value));
+        return result;
+    };
+
+    for (auto const& corruptData : {corrupt(schemaPos, std::numeric_limits<uint32_t>::max()), corrupt(firstColumnSizePos, uint64_t(1) << 60)}) {
+        std::stringstream corruptStream(corruptData);
+        ClusteredDataDescription data;
+        EXPECT_THROW(ColumnarSerializerService::deserialize(data, corruptStream), std::runtime_error);
+    }
+}
+
+TEST_F(SerializerTests, deltaSnapshot)
+{
+    DataDescription previous(createData());
+    DataDescription current = previous;
+    current.cells.at(0).energy = 50.0f;
+    current.cells.erase(current.cells.begin() + 2);
+    current.addCell(CellDescription().setId(7).setPos({80.0f, 80.0f}));
+    current.particles.clear();
+
+    auto delta = DeltaSnapshotService::calcDelta(previous, current);
+    EXPECT_EQ(2, delta.changedCells.size());
+    EXPECT_EQ(1, delta.removedCellIds.size());
+    EXPECT_EQ(1, delta.removedParticleIds.size());
+
+    auto filename = (std::filesystem::temp_directory_path() / "alien_serializer_test.delta").string();
+    ASSERT_TRUE(DeltaSnapshotService::serializeDeltaToFile(filename, delta));
+    DeltaSnapshot loadedDelta;
+    ASSERT_TRUE(DeltaSnapshotService::deserializeDeltaFromFile(loadedDelta, filename));
+    std::filesystem::remove(filename);
+
+    DeltaSnapshotService::applyDelta(previous, loadedDelta);
+    EXPECT_TRUE(current == previous);
+
+    auto clusteredData = DeltaSnapshotService::createClusteredData(current);
+    EXPECT_EQ(3, clusteredData.clusters.size());
+}
+
+TEST_F(SerializerTests, statisticsRoundTrip)
+{
+    StatisticsHistoryData statistics;
+    for (int i = 0; i < 100; ++i) {
+        DataPointCollection dataPoints;
+        dataPoints.time = toDouble(i) * 100.0;
+        dataPoints.numCells.values[0] = toDouble(1000 + i);
+        dataPoints.numCells.summedValues = toDouble(2000 + i);
+        dataPoints.totalEnergy.values[MAX_COLORS - 1] = 0.5 * toDouble(i);
+        dataPoints.numDetonations.values[3] = toDouble(i % 3);
+        statistics.emplace_back(dataPoints);
+    }
+
+    std::stringstream stream;
+    StatisticsSerializerService::serialize(statistics, stream, {.codec = CompressionCodec_Deflate});
+    EXPECT_TRUE(StatisticsSerializerService::isBinaryFormat(stream));
+
+    StatisticsHistoryData loadedStatistics;
+    StatisticsSerializerService::deserialize(loadedStatistics, stream);
+    ASSERT_EQ(statistics.size(), loadedStatistics.size());
+    for (size_t i = 0; i < statistics.size(); ++i) {
+        EXPECT_EQ(statistics.at(i).time, loadedStatistics.at(i).time);
+        EXPECT_EQ(statistics.at(i).numCells.values[0], loadedStatistics.at(i).numCells.values[0]);
+        EXPECT_EQ(statistics.at(i).numCells.summedValues, loadedStatistics.at(i).numCells.summedValues);
+        EXPECT_EQ(statistics.at(i).totalEnergy.values[MAX_COLORS - 1], loadedStatistics.at(i).totalEnergy.values[MAX_COLORS - 1]);
+        EXPECT_EQ(statistics.at(i).numDetonations.values[3], loadedStatistics.at(i).numDetonations.values[3]);
+    }
+}
+
+TEST_F(SerializerTests, corruptStatisticsSizes)
+{
+    StatisticsHistoryData statistics(10, DataPointCollection());
+    std::stringstream stream;
+    StatisticsSerializerService::serialize(statistics, stream, {.codec = CompressionCodec_Deflate});
+    auto data = stream.str();
+
+    auto numSamplesPos = 8 + sizeof(uint32_t);
+    auto numColumnsPos = numSamplesPos + sizeof(uint64_t);
+    uint32_t numColumns;
+    std::memcpy(&numColumns, data.data() + numColumnsPos, sizeof(uint32_t));
+    auto compressedSizePos = numColumnsPos + sizeof(uint32_t) + numColumns * sizeof(uint16_t) + 2 * sizeof(uint8_t) + sizeof(uint64_t);
+
+    auto expectCorruptionDetected = [&](size_t pos, auto value) {
+        auto corruptData = data;
+        std::memcpy(corruptData.data() + pos, &value, sizeof(value));
+        std::stringstream corruptStream(corruptData);
+        StatisticsHistoryData loadedStatistics;
+        EXPECT_THROW(StatisticsSerializerService::deserialize(loadedStatistics, corruptStream), std::runtime_error);
+    };
+    expectCorruptionDetected(numSamplesPos, std::numeric_limits<uint64_t>::max());
+    expectCorruptionDetected(numSamplesPos, std::numeric_limits<uint64_t>::max() / sizeof(uint64_t) / numColumns + 1);
+    expectCorruptionDetected(numColumnsPos, std::numeric_limits<uint32_t>::max());
+    expectCorruptionDetected(compressedSizePos, std::numeric_limits<uint64_t>::max());
+}
+
+TEST_F(SerializerTests, appendStatistics)
+{
+    auto filename = (std::filesystem::temp_directory_path() / "alien_serializer_test.stats.csv").string();
+    std::filesystem::remove(filename);
+
+    auto createStatistics = [](std::vector<double> const& times) {
+        StatisticsHistoryData result;
+        for (auto const& time : times) {
+            DataPointCollection dataPoints;
+            dataPoints.time = time;
+            result.emplace_back(dataPoints);
+        }
+        return result;
+    };
+    ASSERT_TRUE(SerializerService::appendStatisticsToFile(filename, createStatistics({100.0, 200.0})));
+    ASSERT_TRUE(SerializerService::appendStatisticsToFile(filename, createStatistics({300.0})));
+
+    std::vector<std::string> lines;
+    {
+        std::ifstream stream(filename);
+        for (std::string line; std::getline(stream, line);) {
+            lines.emplace_back(line);
+        }
+    }
+    std::filesystem::remove(filename);
+
+    ASSERT_EQ(4, lines.size());
+    EXPECT_TRUE(lines.at(0).starts_with("Time step"));
+    EXPECT_EQ(100.0, std::stod(lines.at(1)));
+    EXPECT_EQ(200.0, std::stod(lines.at(2)));
+    EXPECT_EQ(300.0, std::stod(lines.at(3)));
+}
+
+TEST_F(SerializerTests, checkpoints)
+{
+    auto directory = (std::filesystem::temp_directory_path() / "alien_serializer_test_checkpoints").string();
+    std::filesystem::remove_all(directory);
+
+    DeserializedSimulation simulation;
+    simulation.mainData = createData();
+    for (uint64_t timestep : {100, 200, 300}) {
+        simulation.auxiliaryData.timestep = timestep;
+        ASSERT_TRUE(CheckpointService::writeCheckpoint(directory, simulation, 50));
+    }
+
+    //incomplete checkpoints are ignored
+    std::filesystem::create_directories(std::filesystem::path(directory) / "timestep-400.partial");
+
+    auto checkpoints = CheckpointService::getCheckpoints(directory);
+    ASSERT_EQ(3, checkpoints.size());
+    EXPECT_EQ(300, checkpoints.at(0).timestep);
+    EXPECT_EQ(50, checkpoints.at(0).startTimestep);
+    EXPECT_EQ(100, checkpoints.at(2).timestep);
+
+    CheckpointService::removeOldCheckpoints(directory, 2);
+    checkpoints = CheckpointService::getCheckpoints(directory);
+    ASSERT_EQ(2, checkpoints.size());
+    EXPECT_EQ(200, checkpoints.at(1).timestep);
+
+    DeserializedSimulation loadedSimulation;
+    auto checkpoint = CheckpointService::loadLatestCheckpoint(loadedSimulation, directory);
+    ASSERT_TRUE(checkpoint.has_value());
+    EXPECT_EQ(300, checkpoint->timestep);
+    EXPECT_EQ(300, loadedSimulation.auxiliaryData.timestep);
+    EXPECT_TRUE(simulation.mainData == loadedSimulation.mainData);
+
+    //a damaged checkpoint is skipped
+    std::ofstream(checkpoints.at(0).filename, std::ios::binary | std::ios::trunc) << "damaged";
+    checkpoint = CheckpointService::loadLatestCheckpoint(loadedSimulation, directory);
+    ASSERT_TRUE(checkpoint.has_value());
+    EXPECT_EQ(200, checkpoint->timestep);
+
+    std::filesystem::remove_all(directory);
+}
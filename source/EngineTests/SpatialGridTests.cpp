@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Base/Math.h"
+#include "EngineInterface/SpaceCalculator.h"
+#include "EngineInterface/SpatialGrid.h"
+
+class SpatialGridTests : public ::testing::Test
+{
+protected:
+    std::vector<RealVector2D> createRandomPositions(int numPositions, RealVector2D const& lowerBound, RealVector2D const& upperBound)
+    {
+        std::uniform_real_distribution<float> distributionX(lowerBound.x, upperBound.x);
+        std::uniform_real_distribution<float> distributionY(lowerBound.y, upperBound.y);
+        std::vector<RealVector2D> result;
+        for (int i = 0; i < numPositions; ++i) {
+            result.emplace_back(distributionX(_randomEngine), distributionY(_randomEngine));
+        }
+        return result;
+    }
+
+    template <typename CalcDistance>
+    std::vector<int>
+    findWithinRadiusByBruteForce(std::vector<RealVector2D> const& positions, RealVector2D const& pos, float radius, CalcDistance const& calcDistance)
+    {
+        std::vector<int> result;
+        for (int i = 0; i < toInt(positions.size()); ++i) {
+            if (calcDistance(positions.at(i), pos) <= radius) {
+                result.emplace_back(i);
+            }
+        }
+        return result;
+    }
+
+    std::vector<int> getSortedIndicesWithinRadius(SpatialGrid const& grid, RealVector2D const& pos, float radius)
+    {
+        auto result = grid.getIndicesWithinRadius(pos, radius);
+        std::ranges::sort(result);
+        return result;
+    }
+
+    std::mt19937 _randomEngine{1};
+};
+
+TEST_F(SpatialGridTests, radiusQueriesOnPlane)
+{
+    auto positions = createRandomPositions(2000, {-50.0f, -20.0f}, {50.0f, 20.0f});
+    SpatialGrid grid(positions, 2.0f);
+
+    auto calcDistance = [](RealVector2D const& pos1, RealVector2D const& pos2) { return Math::length(pos1 - pos2); };
+    for (auto const& pos : createRandomPositions(200, {-60.0f, -30.0f}, {60.0f, 30.0f})) {
+        for (auto radius : {0.5f, 2.0f, 7.5f}) {
+            EXPECT_EQ(findWithinRadiusByBruteForce(positions, pos, radius, calcDistance), getSortedIndicesWithinRadius(grid, pos, radius));
+        }
+    }
+}
+
+TEST_F(SpatialGridTests, radiusQueriesOnTorus)
+{
+    IntVector2D worldSize{101, 53};
+    SpaceCalculator spaceCalculator(worldSize);
+    auto positions = createRandomPositions(2000, {0, 0}, {101.0f, 53.0f});
+    SpatialGrid grid(positions, 2.0f, worldSize);
+
+    auto calcDistance = [&](RealVector2D const& pos1, RealVector2D const& pos2) { return spaceCalculator.distance(pos1, pos2); };
+    for (auto const& pos : createRandomPositions(200, {-10.0f, -10.0f}, {111.0f, 63.0f})) {
+        for (auto radius : {0.5f, 2.0f, 7.5f, 60.0f}) {
+            EXPECT_EQ(findWithinRadiusByBruteForce(positions, pos, radius, calcDistance), getSortedIndicesWithinRadius(grid, pos, radius));
+        }
+    }
+}
+
+TEST_F(SpatialGridTests, queriesAcrossWorldBorder)
+{
+    SpatialGrid grid({{99.5f, 50.0f}}, 2.0f, IntVector2D{100, 100});
+
+    EXPECT_TRUE(grid.isOccupied({0.5f, 50.0f}, 1.5f));
+    EXPECT_FALSE(grid.isOccupied({0.5f, 50.0f}, 0.9f));
+    EXPECT_EQ(std::vector<int>{0}, grid.getIndicesWithinRadius({100.2f, 50.0f}, 1.0f));
+    EXPECT_EQ(RealVector2D(99.5f, 50.0f), grid.getPosition(0));
+}
+
+TEST_F(SpatialGridTests, incrementalInserts)
+{
+    auto positions = createRandomPositions(500, {0, 0}, {30.0f, 30.0f});
+    std::vector<RealVector2D> initialPositions(positions.begin(), positions.begin() + 100);
+    SpatialGrid grid(initialPositions, 1.0f);
+    for (int i = 100; i < toInt(positions.size()); ++i) {
+        EXPECT_EQ(i, grid.insert(positions.at(i)));
+    }
+    ASSERT_EQ(toInt(positions.size()), grid.getNumEntries());
+
+    //inserted positions may lie outside of the bounding box of the initial positions
+    auto outsideIndex = grid.insert({-20.0f, 40.0f});
+    EXPECT_EQ(std::vector<int>{outsideIndex}, grid.getIndicesWithinRadius({-20.0f, 41.0f}, 1.0f));
+
+    auto calcDistance = [](RealVector2D const& pos1, RealVector2D const& pos2) { return Math::length(pos1 - pos2); };
+    for (auto const& pos : createRandomPositions(100, {0, 0}, {30.0f, 30.0f})) {
+        EXPECT_EQ(findWithinRadiusByBruteForce(positions, pos, 3.0f, calcDistance), getSortedIndicesWithinRadius(grid, pos, 3.0f));
+    }
+}
+
+TEST_F(SpatialGridTests, isOccupiedUsesStrictDistance)
+{
+    SpatialGrid grid({{10.0f, 10.0f}}, 1.0f);
+
+    EXPECT_TRUE(grid.isOccupied({11.0f, 10.0f}, 1.5f));
+    EXPECT_FALSE(grid.isOccupied({11.0f, 10.0f}, 1.0f));
+    EXPECT_EQ(std::vector<int>{0}, grid.getIndicesWithinRadius({11.0f, 10.0f}, 1.0f));
+}
+
+TEST_F(SpatialGridTests, largeWorld)
+{
+    IntVector2D worldSize{100000, 100000};
+    SpatialGrid grid({{5.0f, 5.0f}, {99999.0f, 5.0f}}, 1.0f, worldSize);
+
+    EXPECT_TRUE(grid.isOccupied({0.5f, 5.0f}, 2.0f));
+    EXPECT_FALSE(grid.isOccupied({50000.0f, 50000.0f}, 2.0f));
+}
@@ -0,0 +1,101 @@
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <gtest/gtest.h>
+
+#include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/SweepService.h"
+
+class SweepServiceTests : public ::testing::Test
+{
+protected:
+    SweepDescription decode(std::string const& json) const
+    {
+        std::stringstream stream(json);
+        boost::property_tree::ptree tree;
+        boost::property_tree::json_parser::read_json(stream, tree);
+        return SweepService::decodeSweepDescription(tree);
+    }
+};
+
+TEST_F(SweepServiceTests, decodeDescription)
+{
+    auto description = decode(R"({
+        "input": "seed.sim",
+        "output directory": "results",
+        "time steps": 1000,
+        "checkpoint interval": 500,
+        "replicates": 2,
+        "grid": {"simulation parameters.friction": [0.001, 0.002, 0.003]},
+        "patches": [{"simulation parameters": {"rigidity": 0.1}}, {"simulation parameters.rigidity": 0.2}]
+    })");
+
+    EXPECT_EQ("seed.sim", description.inputFilename);
+    EXPECT_EQ("results", description.outputDirectory);
+    EXPECT_EQ(1000, description.timesteps);
+    EXPECT_EQ(500, description.checkpointInterval);
+    EXPECT_FALSE(description.statisticsInterval.has_value());
+    EXPECT_EQ((std::vector<uint32_t>{1, 2}), description.seeds);
+    ASSERT_EQ(1, description.grid.size());
+    EXPECT_EQ(3, description.grid.front().second.size());
+    ASSERT_EQ(2, description.patches.size());
+    EXPECT_EQ((ParameterAssignments{{"simulation parameters.rigidity", "0.1"}}), description.patches.at(0));
+    EXPECT_EQ((ParameterAssignments{{"simulation parameters.rigidity", "0.2"}}), description.patches.at(1));
+}
+
+TEST_F(SweepServiceTests, decodeInvalidDescription)
+{
+    EXPECT_THROW(decode(R"({"output directory": "results", "time steps": 1000})"), std::runtime_error);
+    EXPECT_THROW(decode(R"({"input": "seed.sim", "output directory": "results", "time steps": "many"})"), std::runtime_error);
+    EXPECT_THROW(decode(R"({"input": "seed.sim", "output directory": "results", "time steps": 1000, "seeds": []})"), std::runtime_error);
+    EXPECT_THROW(decode(R"({"input": "seed.sim", "output directory": "results", "time steps": 1000, "seeds": [0, 1]})"), std::runtime_error);
+}
+
+TEST_F(SweepServiceTests, createRuns)
+{
+    SweepDescription description;
+    description.seeds = {7, 8};
+    description.grid = {{"a", {"1", "2"}}, {"b", {"3", "4", "5"}}};
+    description.patches = {{{"c", "6"}}, {{"c", "7"}}};
+
+    auto runs = SweepService::createRuns(description);
+    ASSERT_EQ(2 * 2 * 3 * 2, runs.size());
+
+    EXPECT_EQ("run-0000", runs.front().name);
+    EXPECT_EQ((ParameterAssignments{{"c", "6"}, {"a", "1"}, {"b", "3"}}), runs.at(0).assignments);
+    EXPECT_EQ(7, runs.at(0).seed);
+    EXPECT_EQ(8, runs.at(1).seed);
+    EXPECT_EQ(runs.at(0).assignments, runs.at(1).assignments);
+    EXPECT_EQ(runs.at(0).variant, runs.at(1).variant);
+    EXPECT_EQ((ParameterAssignments{{"c", "7"}, {"a", "2"}, {"b", "5"}}), runs.back().assignments);
+    EXPECT_EQ(11, runs.back().variant);
+    EXPECT_EQ("run-0023", runs.back().name);
+}
+
+TEST_F(SweepServiceTests, createRunsWithoutVariants)
+{
+    SweepDescription description;
+    auto runs = SweepService::createRuns(description);
+    ASSERT_EQ(1, runs.size());
+    EXPECT_TRUE(runs.front().assignments.empty());
+}
+
+TEST_F(SweepServiceTests, applyAssignments)
+{
+    SimulationParameters parameters;
+    auto result = SweepService::applyAssignments(
+        parameters, {{"simulation parameters.friction", "0.125"}, {"simulation parameters.radiation.factor[2]", "0.0005"}});
+
+    EXPECT_EQ(0.125f, result.baseValues.friction);
+    EXPECT_EQ(0.0005f, result.baseValues.radiationCellAgeStrength[2]);
+    EXPECT_EQ(parameters.baseValues.radiationCellAgeStrength[1], result.baseValues.radiationCellAgeStrength[1]);
+    EXPECT_EQ(parameters.baseValues.rigidity, result.baseValues.rigidity);
+}
+
+TEST_F(SweepServiceTests, applyInvalidAssignments)
+{
+    SimulationParameters parameters;
+    EXPECT_THROW(SweepService::applyAssignments(parameters, {{"simulation parameters.fricton", "0.1"}}), std::runtime_error);
+    EXPECT_THROW(SweepService::applyAssignments(parameters, {{"simulation parameters.radiation", "0.1"}}), std::runtime_error);
+    EXPECT_THROW(SweepService::applyAssignments(parameters, {{"simulation parameters.friction", "abc"}}), std::runtime_error);
+}
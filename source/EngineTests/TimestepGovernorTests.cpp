@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include "EngineImpl/TimestepGovernor.h"
+
+class TimestepGovernorTests : public ::testing::Test
+{
+protected:
+    using Clock = TimestepGovernor::Clock;
+
+    //simulates a free running simulation with constant time step duration and returns the passed time
+    std::chrono::microseconds runFreely(int numTimesteps, std::chrono::microseconds const& timestepDuration)
+    {
+        auto startTimepoint = _timepoint;
+        for (int i = 0; i < numTimesteps; ++i) {
+            auto timestepStart = _timepoint;
+            _timepoint += timestepDuration;
+            _governor.registerTimestep(timestepStart, _timepoint);
+            _timepoint += _governor.calcPause(_timepoint);
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(_timepoint - startTimepoint);
+    }
+
+    //simulates frames with constant rendering duration and returns the time steps of the last frame
+    int runFrames(int numFrames, std::chrono::microseconds const& renderingDuration, std::chrono::microseconds const& timestepDuration)
+    {
+        int result = 0;
+        for (int i = 0; i < numFrames; ++i) {
+            result = _governor.calcTimestepsForFrame(_timepoint, 2);
+            for (int j = 0; j < result; ++j) {
+                auto timestepStart = _timepoint;
+                _timepoint += timestepDuration;
+                _governor.registerTimestep(timestepStart, _timepoint);
+            }
+            _timepoint += renderingDuration;
+        }
+        return result;
+    }
+
+    TimestepGovernor _governor;
+    Clock::time_point _timepoint;
+};
+
+TEST_F(TimestepGovernorTests, unrestricted)
+{
+    auto duration = runFreely(1000, std::chrono::microseconds(2000));
+    EXPECT_EQ(std::chrono::microseconds(2000000), duration);
+
+    auto metrics = _governor.getMetrics();
+    EXPECT_NEAR(500.0f, metrics.tps, 1.0f);
+    EXPECT_NEAR(2.0f, metrics.timestepDuration, 0.01f);
+    EXPECT_NEAR(1.0f, metrics.coreUsage, 0.01f);
+    EXPECT_EQ(GovernorLimit_None, metrics.limit);
+}
+
+TEST_F(TimestepGovernorTests, maxTps)
+{
+    _governor.setSettings({.maxTps = 100});
+    auto duration = runFreely(100, std::chrono::microseconds(2000));
+
+    //first time step starts at 0, the last one at 99 * 10ms
+    EXPECT_NEAR(1000000, duration.count(), 100);
+    auto metrics = _governor.getMetrics();
+    EXPECT_NEAR(100.0f, metrics.tps, 1.0f);
+    EXPECT_NEAR(8.0f, metrics.pauseDuration, 0.01f);
+    EXPECT_EQ(GovernorLimit_Tps, metrics.limit);
+}
+
+TEST_F(TimestepGovernorTests, maxTpsNotReachable)
+{
+    _governor.setSettings({.maxTps = 100});
+    runFreely(100, std::chrono::microseconds(20000));
+
+    auto metrics = _governor.getMetrics();
+    EXPECT_NEAR(50.0f, metrics.tps, 1.0f);
+    EXPECT_EQ(0.0f, metrics.pauseDuration);
+}
+
+TEST_F(TimestepGovernorTests, maxCoreUsage)
+{
+    _governor.setSettings({.maxCoreUsage = 0.25f});
+    runFreely(1000, std::chrono::microseconds(2000));
+
+    auto metrics = _governor.getMetrics();
+    EXPECT_NEAR(125.0f, metrics.tps, 1.0f);
+    EXPECT_NEAR(0.25f, metrics.coreUsage, 0.01f);
+    EXPECT_EQ(GovernorLimit_CoreUsage, metrics.limit);
+}
+
+TEST_F(TimestepGovernorTests, strictestConstraintWins)
+{
+    _governor.setSettings({.maxTps = 100, .maxCoreUsage = 0.5f});
+    runFreely(1000, std::chrono::microseconds(2000));
+    EXPECT_EQ(GovernorLimit_Tps, _governor.getMetrics().limit);
+    EXPECT_NEAR(100.0f, _governor.getMetrics().tps, 1.0f);
+
+    _governor.setSettings({.maxTps = 1000, .maxCoreUsage = 0.5f});
+    runFreely(1000, std::chrono::microseconds(2000));
+    EXPECT_EQ(GovernorLimit_CoreUsage, _governor.getMetrics().limit);
+    EXPECT_NEAR(250.0f, _governor.getMetrics().tps, 1.0f);
+}
+
+TEST_F(TimestepGovernorTests, resetOnPause)
+{
+    runFreely(100, std::chrono::microseconds(2000));
+    _governor.reset();
+
+    auto metrics = _governor.getMetrics();
+    EXPECT_EQ(0.0f, metrics.tps);
+    EXPECT_NEAR(2.0f, metrics.timestepDuration, 0.01f);
+}
+
+TEST_F(TimestepGovernorTests, fixedTimestepsPerFrame)
+{
+    EXPECT_EQ(2, runFrames(10, std::chrono::microseconds(5000), std::chrono::microseconds(1000)));
+    EXPECT_EQ(GovernorLimit_None, _governor.getMetrics().limit);
+}
+
+TEST_F(TimestepGovernorTests, targetFps)
+{
+    //frame budget of 16.7ms minus 6ms for rendering leaves 10.7ms for 5 time steps
+    _governor.setSettings({.targetFps = 60});
+    auto timesteps = runFrames(100, std::chrono::microseconds(6000), std::chrono::microseconds(2000));
+    EXPECT_EQ(5, timesteps);
+
+    auto metrics = _governor.getMetrics();
+    EXPECT_EQ(GovernorLimit_FrameBudget, metrics.limit);
+    EXPECT_NEAR(6.0f, metrics.frameDuration, 0.01f);
+    EXPECT_NEAR(312.5f, metrics.tps, 1.0f);
+}
+
+TEST_F(TimestepGovernorTests, targetFpsExceeded)
+{
+    //at least one time step per frame
+    _governor.setSettings({.targetFps = 60});
+    EXPECT_EQ(1, runFrames(100, std::chrono::microseconds(20000), std::chrono::microseconds(2000)));
+}
+
+TEST_F(TimestepGovernorTests, maxTpsBelowFrameRate)
+{
+    _governor.setSettings({.maxTps = 30, .targetFps = 60});
+    runFrames(1000, std::chrono::microseconds(6667), std::chrono::microseconds(1000));
+
+    auto metrics = _governor.getMetrics();
+    EXPECT_NEAR(30.0f, metrics.tps, 1.0f);
+}
@@ -4,6 +4,7 @@
 
 #include "Base/Resources.h"
 #include "Base/GlobalSettings.h"
+#include "EngineInterface/DeltaSnapshotService.h"
 #include "EngineInterface/SerializerService.h"
 #include "EngineInterface/SimulationController.h"
 
@@ -15,6 +16,7 @@
 namespace
 {
     auto constexpr MinutesForAutosave = 40;
+    auto constexpr MinutesForCheckpoint = 5;
 }
 
 _AutosaveController::_AutosaveController(SimulationController const& simController)
@@ -54,12 +56,16 @@ void _AutosaveController::process()
     }
 
     auto durationSinceStart = std::chrono::duration_cast<std::chrono::minutes>(std::chrono::steady_clock::now() - *_startTimePoint).count();
-    if (durationSinceStart > 0 && durationSinceStart % MinutesForAutosave == 0 && !_alreadySaved) {
+    if (durationSinceStart > 0 && durationSinceStart % MinutesForCheckpoint == 0 && !_alreadySaved) {
         printOverlayMessage("Auto saving ...");
-        delayedExecution([=, this] { onSave(); });
+        if (durationSinceStart % MinutesForAutosave == 0) {
+            delayedExecution([=, this] { onSave(); });
+        } else {
+            delayedExecution([=, this] { onCheckpoint(); });
+        }
         _alreadySaved = true;
     }
-    if (durationSinceStart > 0 && durationSinceStart % MinutesForAutosave == 1 && _alreadySaved) {
+    if (durationSinceStart > 0 && durationSinceStart % MinutesForCheckpoint == 1 && _alreadySaved) {
         _alreadySaved = false;
     }
 }
@@ -67,5 +73,28 @@ void _AutosaveController::process()
 void _AutosaveController::onSave()
 {
     DeserializedSimulation sim = SerializationHelperService::getDeserializedSerialization(_simController);
-    SerializerService::serializeSimulationToFiles(Const::AutosaveFile, sim);
+
+    //a full save replaces the checkpoints, they are only removed after the base file has been written such that they are kept if the save fails
+    if (SerializerService::serializeSimulationToFiles(Const::AutosaveFile, sim)) {
+        DeltaSnapshotService::removeDeltaFiles(Const::AutosaveFile);
+        _lastSavedData = DataDescription(sim.mainData);
+    } else {
+        _lastSavedData.reset();
+    }
+}
+
+void _AutosaveController::onCheckpoint()
+{
+    if (!_lastSavedData) {
+        onSave();
+        return;
+    }
+    DeserializedSimulation sim = SerializationHelperService::getDeserializedSerialization(_simController);
+    DataDescription data(sim.mainData);
+    auto delta = DeltaSnapshotService::calcDelta(*_lastSavedData, data);
+    if (DeltaSnapshotService::serializeCheckpointToFiles(Const::AutosaveFile, delta, sim)) {
+        _lastSavedData = std::move(data);
+    } else {
+        _lastSavedData.reset();
+    }
 }
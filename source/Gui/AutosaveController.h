@@ -3,6 +3,7 @@
 #include <chrono>
 
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/Descriptions.h"
 #include "Definitions.h"
 
 class _AutosaveController
@@ -20,10 +21,12 @@ public:
 
 private:
     void onSave();
+    void onCheckpoint();
 
     SimulationController _simController;
 
     bool _on = true;
     std::optional<std::chrono::steady_clock::time_point> _startTimePoint;
     bool _alreadySaved = false;
+    std::optional<DataDescription> _lastSavedData;  //reference for the next checkpoint
 };
\ No newline at end of file
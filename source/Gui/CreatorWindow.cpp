@@ -202,7 +202,8 @@ void _CreatorWindow::onDrawing()
     };
 
     if (_drawingDataDescription.isEmpty()) {
-        DescriptionEditService::addIfSpaceAvailable(_drawingDataDescription, _drawingOccupancy, createAlignedCircle(pos), 0.5f, _simController->getWorldSize());
+        _drawingCellGrid.emplace(std::vector<RealVector2D>(), 1.0f, _simController->getWorldSize());
+        DescriptionEditService::addIfSpaceAvailable(_drawingDataDescription, *_drawingCellGrid, createAlignedCircle(pos), 0.5f);
         _lastDrawPos = pos;
     } else {
         auto posDelta = Math::length(pos - _lastDrawPos);
@@ -211,7 +212,7 @@ void _CreatorWindow::onDrawing()
             for (float interDelta = 0; interDelta < posDelta; interDelta += 1.0f) {
                 auto drawPos = lastDrawPos + (pos - lastDrawPos) * interDelta / posDelta;
                 auto toAdd = createAlignedCircle(drawPos);
-                DescriptionEditService::addIfSpaceAvailable(_drawingDataDescription, _drawingOccupancy, toAdd, 0.5f, _simController->getWorldSize());
+                DescriptionEditService::addIfSpaceAvailable(_drawingDataDescription, *_drawingCellGrid, toAdd, 0.5f);
                 _lastDrawPos = drawPos;
             }
         }
@@ -233,7 +234,7 @@ void _CreatorWindow::onDrawing()
 void _CreatorWindow::finishDrawing()
 {
     _drawingDataDescription.clear();
-    _drawingOccupancy.clear();
+    _drawingCellGrid.reset();
 }
 
 void _CreatorWindow::createCell()
@@ -2,6 +2,7 @@
 
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/SpatialGrid.h"
 
 #include "Definitions.h"
 #include "AlienWindow.h"
@@ -61,7 +62,7 @@ private:
 
     //drawing
     DataDescription _drawingDataDescription;
-    DescriptionEditService::Occupancy _drawingOccupancy;
+    std::optional<SpatialGrid> _drawingCellGrid;
     RealVector2D _lastDrawPos;
 
     CreationMode _mode = CreationMode_Drawing;
@@ -13,7 +13,6 @@
 #include "EngineInterface/GenomeDescriptionService.h"
 #include "EngineInterface/Colors.h"
 #include "EngineInterface/SimulationParameters.h"
-#include "EngineInterface/PreviewDescriptionService.h"
 #include "EngineInterface/SerializerService.h"
 #include "EngineInterface/ShapeGenerator.h"
 
@@ -22,6 +21,7 @@
 #include "DelayedExecutionController.h"
 #include "EditorModel.h"
 #include "GenericFileDialogs.h"
+#include "GenomePreviewController.h"
 #include "MessageDialog.h"
 #include "OverlayMessageController.h"
 #include "StyleRepository.h"
@@ -961,8 +961,15 @@ void _GenomeEditorWindow::onCreateSpore()
 void _GenomeEditorWindow::showPreview(TabData& tab)
 {
     auto const& genome = _tabDatas.at(_selectedTabIndex).genome;
-    auto preview = PreviewDescriptionService::convert(genome, tab.selectedNode, _simController->getSimulationParameters());
-    if (AlienImGui::ShowPreviewDescription(preview, tab.previewZoom, tab.selectedNode)) {
+    auto preview = GenomePreviewController::getInstance().getPreview(
+        GenomeDescriptionService::convertDescriptionToBytes(genome), _simController->getSimulationParameters());
+    if (preview) {
+        tab.lastPreview = preview;
+    }
+    if (!tab.lastPreview) {
+        return;
+    }
+    if (AlienImGui::ShowPreviewDescription(*tab.lastPreview, tab.previewZoom, tab.selectedNode)) {
         _nodeIndexToJump = tab.selectedNode;
     }
 }
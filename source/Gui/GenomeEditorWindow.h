@@ -28,6 +28,7 @@ private:
         GenomeDescription genome;
         std::optional<int> selectedNode;
         float previewZoom = 30.0f;
+        std::shared_ptr<PreviewDescription const> lastPreview;  //shown while the preview of the edited genome is calculated
     };
     void processTab(TabData& tab);
     void processGenomeHeader(TabData& tab);
@@ -0,0 +1,86 @@
+#include "GenomePreviewController.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineInterface/PreviewDescriptionService.h"
+
+namespace
+{
+    size_t calcHash(std::vector<uint8_t> const& genome)
+    {
+        return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<char const*>(genome.data()), genome.size()));
+    }
+}
+
+GenomePreviewController& GenomePreviewController::getInstance()
+{
+    static GenomePreviewController instance;
+    return instance;
+}
+
+PreviewDescriptionPtr GenomePreviewController::getPreview(std::vector<uint8_t> const& genome, SimulationParameters const& parameters)
+{
+    auto hash = calcHash(genome);
+
+    std::lock_guard lock(_mutex);
+    if (auto entry = _cache.find(hash)) {
+        if ((*entry)->genome == genome) {
+            return (*entry)->preview;
+        }
+    }
+    auto isPending = std::ranges::any_of(_requests, [&](Request const& request) { return request.hash == hash && request.genome == genome; });
+    if (!isPending) {
+        //requests for genomes which have been edited in the meantime are outdated
+        if (_requests.size() >= MaxPendingRequests) {
+            _requests.pop_front();
+        }
+        _requests.emplace_back(Request{hash, genome, parameters});
+        _conditionVariable.notify_one();
+    }
+    return nullptr;
+}
+
+GenomePreviewController::GenomePreviewController()
+{
+    _thread = std::thread(&GenomePreviewController::workerLoop, this);
+}
+
+GenomePreviewController::~GenomePreviewController()
+{
+    {
+        std::lock_guard lock(_mutex);
+        _shutdown = true;
+    }
+    _conditionVariable.notify_one();
+    _thread.join();
+}
+
+void GenomePreviewController::workerLoop()
+{
+    while (true) {
+        Request request;
+        {
+            std::unique_lock lock(_mutex);
+            _conditionVariable.wait(lock, [this] { return _shutdown || !_requests.empty(); });
+            if (_shutdown) {
+                return;
+            }
+
+            //the newest request belongs most likely to the genome which is currently shown
+            request = std::move(_requests.back());
+            _requests.pop_back();
+        }
+
+        //an invalid genome results in an empty preview such that it is not calculated again
+        auto preview = std::make_shared<PreviewDescription>();
+        try {
+            *preview = PreviewDescriptionService::convert(GenomeDescriptionService::convertBytesToDescription(request.genome), std::nullopt, request.parameters);
+        } catch (...) {
+        }
+
+        std::lock_guard lock(_mutex);
+        _cache.insertOrAssign(request.hash, std::make_shared<CacheEntry const>(CacheEntry{std::move(request.genome), preview}));
+    }
+}
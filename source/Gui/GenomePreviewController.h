@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Base/LruCache.h"
+#include "EngineInterface/PreviewDescriptions.h"
+#include "EngineInterface/SimulationParameters.h"
+
+#include "Definitions.h"
+
+using PreviewDescriptionPtr = std::shared_ptr<PreviewDescription const>;
+
+/**
+ * Calculates genome previews on a worker thread and caches them by the hash of the genome bytes such that the windows do not convert genomes every frame.
+ * The selected node and the simulation parameters are not part of the key since the preview calculation does not depend on them.
+ */
+class GenomePreviewController
+{
+public:
+    static GenomePreviewController& getInstance();
+
+    //does not block: returns nullptr if the preview is not calculated yet and schedules its calculation
+    PreviewDescriptionPtr getPreview(std::vector<uint8_t> const& genome, SimulationParameters const& parameters);
+
+private:
+    GenomePreviewController();
+    ~GenomePreviewController();
+
+    void workerLoop();
+
+    static auto constexpr MaxCachedPreviews = 64;
+    static auto constexpr MaxPendingRequests = 8;
+
+    struct CacheEntry
+    {
+        std::vector<uint8_t> genome;  //for detecting hash collisions
+        PreviewDescriptionPtr preview;
+    };
+    struct Request
+    {
+        size_t hash = 0;
+        std::vector<uint8_t> genome;
+        SimulationParameters parameters;
+    };
+
+    std::mutex _mutex;
+    std::condition_variable _conditionVariable;
+    LruCache<size_t, std::shared_ptr<CacheEntry const>, MaxCachedPreviews> _cache;
+    std::deque<Request> _requests;  //oldest request first
+    bool _shutdown = false;
+
+    std::thread _thread;
+};
@@ -9,7 +9,6 @@
 #include "EngineInterface/DescriptionEditService.h"
 #include "EngineInterface/SimulationController.h"
 #include "EngineInterface/GenomeDescriptionService.h"
-#include "EngineInterface/PreviewDescriptionService.h"
 
 #include "StyleRepository.h"
 #include "Viewport.h"
@@ -17,6 +16,7 @@
 #include "AlienImGui.h"
 #include "CellFunctionStrings.h"
 #include "GenomeEditorWindow.h"
+#include "GenomePreviewController.h"
 #include "HelpStrings.h"
 #include "OverlayMessageController.h"
 
@@ -381,10 +381,12 @@ void _InspectorWindow::processCellGenomeTab(Description& desc)
             AlienImGui::HelpMarker(Const::GenomePreviewTooltip);
             if (previewNodeResult) {
                 if (ImGui::BeginChild("##child", ImVec2(0, scale(200)), true, ImGuiWindowFlags_HorizontalScrollbar)) {
-                    auto genomDesc = GenomeDescriptionService::convertBytesToDescription(desc.genome);
-                    auto previewDesc = PreviewDescriptionService::convert(genomDesc, std::nullopt, parameters);
-                    std::optional<int> selectedNodeDummy;
-                    AlienImGui::ShowPreviewDescription(previewDesc, _genomeZoom, selectedNodeDummy);
+                    if (auto previewDesc = GenomePreviewController::getInstance().getPreview(desc.genome, parameters)) {
+                        std::optional<int> selectedNodeDummy;
+                        AlienImGui::ShowPreviewDescription(*previewDesc, _genomeZoom, selectedNodeDummy);
+                    } else {
+                        AlienImGui::Text("Calculating preview ...");
+                    }
                 }
                 ImGui::EndChild();
                 if (AlienImGui::Button("Edit")) {
@@ -32,6 +32,10 @@ _PatternAnalysisDialog::~_PatternAnalysisDialog()
 
 void _PatternAnalysisDialog::process()
 {
+    if (_analysisResult.valid() && _analysisResult.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        saveRepetitiveActiveClustersToFiles(_analysisFilename, _analysisResult.get());
+    }
+
     if (!ifd::FileDialog::Instance().IsDone("PatternAnalysisDialog")) {
         return;
     }
@@ -40,7 +44,7 @@ void _PatternAnalysisDialog::process()
         auto firstFilenameCopy = firstFilename;
         _startingPath = firstFilenameCopy.remove_filename().string();
 
-        saveRepetitiveActiveClustersToFiles(firstFilename.string());
+        startAnalysis(firstFilename.string());
     }
     ifd::FileDialog::Instance().Close();
 }
@@ -50,10 +54,22 @@ void _PatternAnalysisDialog::show()
     ifd::FileDialog::Instance().Save("PatternAnalysisDialog", "Save pattern analysis result", "Analysis result (*.txt){.txt},.*", _startingPath);
 }
 
-void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string const& filename)
+void _PatternAnalysisDialog::startAnalysis(std::string const& filename)
 {
-    auto const partitionClassDataByDescription = calcPartitionData();
+    if (_analysisResult.valid()) {
+        MessageDialog::getInstance().information("Pattern analysis", "The previous analysis is still running.");
+        return;
+    }
+    _analysisFilename = filename;
+
+    //the simulation controller may only be accessed from the UI thread, hence only the analysis itself runs in the background
+    _analysisResult = std::async(std::launch::async, [data = _simController->getClusteredSimulationData()] {
+        return PatternAnalysisService::calcPatternClasses(data);
+    });
+}
 
+void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string const& filename, std::vector<PatternClass> const& patternClasses)
+{
     std::ofstream file;
     file.open(filename, std::ios_base::out);
     if (!file) {
@@ -61,17 +77,15 @@ void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string con
         return;
     }
 
-    int sum = 0;
-    std::vector<PartitionClassData> partitionData;
-    for (auto const& [analysisDesc, partitionClassData] : partitionClassDataByDescription) {
-        if (partitionClassData.numberOfElements > 1) {
-            partitionData.emplace_back(partitionClassData);
+    std::vector<PatternClass> partitionData;
+    for (auto const& patternClass : patternClasses) {
+        if (patternClass.numberOfElements > 1) {
+            partitionData.emplace_back(patternClass);
         }
     }
-    std::sort(partitionData.begin(), partitionData.end());
 
     file << "number of repetitive active cell networks: " << partitionData.size() << std::endl << std::endl;
-    for (auto const& [index, partitionClassData] : partitionData | boost::adaptors::reversed | boost::adaptors::indexed(1)) {
+    for (auto const& [index, partitionClassData] : partitionData | boost::adaptors::indexed(1)) {
 
         file << "cell network " << index << ": " << partitionClassData.numberOfElements << " exemplars" << std::endl;
 
@@ -97,55 +111,3 @@ void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string con
     }
     MessageDialog::getInstance().information("Analysis result", messageStream.str());
 }
-
-auto _PatternAnalysisDialog::calcPartitionData() const -> std::map<ClusterAnalysisDescription, PartitionClassData>
-{
-    auto data = _simController->getClusteredSimulationData();
-
-    std::map<ClusterAnalysisDescription, PartitionClassData> result;
-
-    for (auto const& cluster : data.clusters) {
-        auto const clusterAnalysisData = getAnalysisDescription(cluster);
-        auto& partitionData = result[clusterAnalysisData];
-        if (1 == ++partitionData.numberOfElements) {
-            partitionData.representant = cluster;
-        }
-    }
-    return result;
-}
-
-auto _PatternAnalysisDialog::getAnalysisDescription(ClusterDescription const& cluster) const -> ClusterAnalysisDescription
-{
-    ClusterAnalysisDescription result;
-    std::map<uint64_t, CellAnalysisDescription> cellAnalysisDescById;
-    auto insertCellAnalysisDescription = [&cellAnalysisDescById](CellDescription const& cell) {
-        if (cellAnalysisDescById.find(cell.id) == cellAnalysisDescById.end()) {
-            CellAnalysisDescription result;
-            result.maxConnections = cell.maxConnections;
-            result.numConnections = cell.connections.size();
-            result.constructionState = cell.livingState;
-            result.inputExecutionOrderNumber = cell.inputExecutionOrderNumber;
-            result.outputBlocked = cell.outputBlocked;
-            result.executionOrderNumber = cell.executionOrderNumber;
-            result.color = cell.color;
-            result.cellFunction = cell.getCellFunctionType();
-
-            cellAnalysisDescById.insert_or_assign(cell.id, result);
-        }
-    };
-
-    std::map<uint64_t, int> cellDescIndexById;
-    for (auto const& [index, cell] : cluster.cells | boost::adaptors::indexed(0)) {
-        cellDescIndexById.insert_or_assign(cell.id, toInt(index));
-    }
-
-    for (auto const& cell : cluster.cells) {
-        insertCellAnalysisDescription(cell);
-        for (auto const& connection : cell.connections) {
-            auto connectingCellId = connection.cellId;
-            insertCellAnalysisDescription(cluster.cells.at(cellDescIndexById.at(connectingCellId)));
-            result.connectedCells.insert(std::set<CellAnalysisDescription>{cellAnalysisDescById.at(cell.id), cellAnalysisDescById.at(connectingCellId)});
-        }
-    }
-    return result;
-}
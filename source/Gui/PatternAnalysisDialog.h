@@ -1,6 +1,8 @@
 #pragma once
 
-#include "EngineInterface/Descriptions.h"
+#include <future>
+
+#include "EngineInterface/PatternAnalysisService.h"
 #include "Definitions.h"
 
 class _PatternAnalysisDialog
@@ -13,84 +15,15 @@ public:
     void show();
 
 private:
-    void saveRepetitiveActiveClustersToFiles(std::string const& filename);
-
-    struct CellAnalysisDescription
-    {
-        int maxConnections;
-        int numConnections;
-        bool constructionState;
-        std::optional<int> inputExecutionOrderNumber;
-        bool outputBlocked;
-        int executionOrderNumber;
-        int color;
-        int cellFunction;
-
-        bool operator==(CellAnalysisDescription const& other) const
-        {
-            return maxConnections == other.maxConnections && numConnections == other.numConnections && constructionState == other.constructionState
-                && inputExecutionOrderNumber == other.inputExecutionOrderNumber && outputBlocked == other.outputBlocked && executionOrderNumber == other.executionOrderNumber
-                && cellFunction == other.cellFunction
-                && color == other.color;
-        }
-
-        bool operator!=(CellAnalysisDescription const& other) const { return !operator==(other); }
-
-        bool operator<(CellAnalysisDescription const& other) const
-        {
-            if (maxConnections != other.maxConnections) {
-                return maxConnections < other.maxConnections;
-            }
-            if (numConnections != other.numConnections) {
-                return numConnections < other.numConnections;
-            }
-            if (constructionState != other.constructionState) {
-                return constructionState < other.constructionState;
-            }
-            if (inputExecutionOrderNumber != other.inputExecutionOrderNumber) {
-                return inputExecutionOrderNumber < other.inputExecutionOrderNumber;
-            }
-            if (outputBlocked != other.outputBlocked) {
-                return outputBlocked < other.outputBlocked;
-            }
-            if (executionOrderNumber != other.executionOrderNumber) {
-                return executionOrderNumber < other.executionOrderNumber;
-            }
-            if (cellFunction != other.cellFunction) {
-                return cellFunction < other.cellFunction;
-            }
-            if (color != other.color) {
-                return color < other.color;
-            }
-            return false;
-        }
-    };
-    struct ClusterAnalysisDescription
-    {
-        std::set<std::set<CellAnalysisDescription>> connectedCells;
-
-        bool operator<(ClusterAnalysisDescription const& other) const
-        {
-            if (connectedCells != other.connectedCells) {
-                return connectedCells < other.connectedCells;
-            }
-            return false;
-        }
-    };
-    struct PartitionClassData
-    {
-        int numberOfElements = 0;
-        ClusterDescription representant;
-
-        bool operator<(PartitionClassData const& other) const { return numberOfElements < other.numberOfElements; };
-    };
-
-    std::map<ClusterAnalysisDescription, PartitionClassData> calcPartitionData() const;
-
-    ClusterAnalysisDescription getAnalysisDescription(ClusterDescription const& cluster) const;
+    void startAnalysis(std::string const& filename);
+    void saveRepetitiveActiveClustersToFiles(std::string const& filename, std::vector<PatternClass> const& patternClasses);
 
 private:
     SimulationController _simController;
 
     std::string _startingPath;
+
+    //the analysis runs in the background, its result is saved in process()
+    std::future<std::vector<PatternClass>> _analysisResult;
+    std::string _analysisFilename;
 };
@@ -6,6 +6,7 @@
 #include "Base/GlobalSettings.h"
 #include "Base/Resources.h"
 #include "Base/LoggingService.h"
+#include "EngineInterface/DeltaSnapshotService.h"
 #include "EngineInterface/SerializerService.h"
 #include "EngineInterface/SimulationController.h"
 
@@ -50,7 +51,7 @@ void _StartupController::process()
 
     if (_state == State::LoadSimulation) {
         DeserializedSimulation deserializedSim;
-        if (!SerializerService::deserializeSimulationFromFiles(deserializedSim, Const::AutosaveFile)) {
+        if (!DeltaSnapshotService::restoreCheckpoint(deserializedSim, Const::AutosaveFile)) {
             MessageDialog::getInstance().information("Error", "The default simulation file could not be read.\nAn empty simulation will be created.");
             deserializedSim.auxiliaryData.generalSettings.worldSizeX = 1000;
             deserializedSim.auxiliaryData.generalSettings.worldSizeY = 500;
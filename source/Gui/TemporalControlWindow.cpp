@@ -73,6 +73,19 @@ void _TemporalControlWindow::processTpsInfo()
     ImGui::TextUnformatted(StringHelper::format(_simController->getTps(), 1).c_str());
     ImGui::PopStyleColor();
     ImGui::PopFont();
+
+    auto metrics = _simController->getTimestepGovernorMetrics();
+    std::string limitText;
+    if (metrics.limit == GovernorLimit_Tps) {
+        limitText = ", limited by TPS";
+    } else if (metrics.limit == GovernorLimit_CoreUsage) {
+        limitText = ", limited by CPU usage";
+    } else if (metrics.limit == GovernorLimit_FrameBudget) {
+        limitText = ", limited by frame rate";
+    }
+    ImGui::PushStyleColor(ImGuiCol_Text, Const::TextDecentColor);
+    ImGui::TextUnformatted(("Time step: " + StringHelper::format(metrics.timestepDuration, 2) + " ms" + limitText).c_str());
+    ImGui::PopStyleColor();
 }
 
 void _TemporalControlWindow::processTotalTimestepsInfo()
@@ -99,16 +112,23 @@ void _TemporalControlWindow::processRealTimeInfo()
 
 void _TemporalControlWindow::processTpsRestriction()
 {
+    auto settings = _simController->getTimestepGovernorSettings();
+
     AlienImGui::ToggleButton(AlienImGui::ToggleButtonParameters().name("Slow down"), _slowDown);
     ImGui::SameLine(scale(LeftColumnWidth) - (ImGui::GetWindowWidth() - ImGui::GetContentRegionAvail().x));
     ImGui::BeginDisabled(!_slowDown);
     ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
     ImGui::SliderInt("", &_tpsRestriction, 1, 1000, "%d TPS", ImGuiSliderFlags_Logarithmic);
-    if (_slowDown) {
-        _simController->setTpsRestriction(_tpsRestriction);
-    } else {
-        _simController->setTpsRestriction(std::nullopt);
-    }
+    settings.maxTps = _slowDown ? std::make_optional(_tpsRestriction) : std::nullopt;
+    ImGui::PopItemWidth();
+    ImGui::EndDisabled();
+
+    AlienImGui::ToggleButton(AlienImGui::ToggleButtonParameters().name("Limit CPU usage"), _limitCoreUsage);
+    ImGui::SameLine(scale(LeftColumnWidth) - (ImGui::GetWindowWidth() - ImGui::GetContentRegionAvail().x));
+    ImGui::BeginDisabled(!_limitCoreUsage);
+    ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
+    ImGui::SliderInt("##coreUsage", &_maxCoreUsage, 5, 100, "%d%% of a core");
+    settings.maxCoreUsage = _limitCoreUsage ? std::make_optional(toFloat(_maxCoreUsage) / 100) : std::nullopt;
     ImGui::PopItemWidth();
     ImGui::EndDisabled();
 
@@ -117,13 +137,28 @@ void _TemporalControlWindow::processTpsRestriction()
         _simController->setSyncSimulationWithRendering(syncSimulationWithRendering);
     }
 
-    ImGui::BeginDisabled(!syncSimulationWithRendering);
+    ImGui::BeginDisabled(!syncSimulationWithRendering || _adaptToFrameRate);
     ImGui::SameLine(scale(LeftColumnWidth) - (ImGui::GetWindowWidth() - ImGui::GetContentRegionAvail().x));
     auto syncSimulationWithRenderingRatio = _simController->getSyncSimulationWithRenderingRatio();
     if (AlienImGui::SliderInt(AlienImGui::SliderIntParameters().textWidth(0).min(1).max(40).logarithmic(true).format("%d TPS : FPS"), &syncSimulationWithRenderingRatio)) {
         _simController->setSyncSimulationWithRenderingRatio(syncSimulationWithRenderingRatio);
     }
     ImGui::EndDisabled();
+
+    ImGui::BeginDisabled(!syncSimulationWithRendering);
+    AlienImGui::ToggleButton(AlienImGui::ToggleButtonParameters().name("Adapt to frame rate"), _adaptToFrameRate);
+    ImGui::SameLine(scale(LeftColumnWidth) - (ImGui::GetWindowWidth() - ImGui::GetContentRegionAvail().x));
+    ImGui::BeginDisabled(!_adaptToFrameRate);
+    ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
+    ImGui::SliderInt("##targetFps", &_targetFps, 10, 240, "%d FPS");
+    settings.targetFps = _adaptToFrameRate ? std::make_optional(_targetFps) : std::nullopt;
+    ImGui::PopItemWidth();
+    ImGui::EndDisabled();
+    ImGui::EndDisabled();
+
+    if (settings != _simController->getTimestepGovernorSettings()) {
+        _simController->setTimestepGovernorSettings(settings);
+    }
 }
 
 void _TemporalControlWindow::processRunButton()
@@ -54,5 +54,9 @@ private:
 
     bool _slowDown = false;
     int _tpsRestriction = 30;
+    bool _limitCoreUsage = false;
+    int _maxCoreUsage = 50;  //in percent
+    bool _adaptToFrameRate = false;
+    int _targetFps = 60;
 };
 
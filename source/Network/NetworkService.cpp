@@ -470,7 +470,7 @@ bool NetworkService::uploadResource(
         {"symbolMap", "", "", ""},
         {"type", std::to_string(resourceType), "", ""},
         {"workspace", std::to_string(workspaceType), "", ""},
-        {"statistics", statistics, "", ""},
+        {"statistics", statistics, "", "application/octet-stream"},
     };
 
     try {
@@ -528,7 +528,7 @@ bool NetworkService::replaceResource(
         {"content", chunks.front(), "", "application/octet-stream"},
         {"settings", settings, "", ""},
         {"symbolMap", "", "", ""},
-        {"statistics", statistics, "", ""},
+        {"statistics", statistics, "", "application/octet-stream"},
     };
 
     try {